@@ -20,6 +20,8 @@
 
 #include <gnu_gama/adj/adj.h>
 #include <gnu_gama/adj/adj_input_data.h>
+#include <gnu_gama/adj/adj_cgls.h>
+#include <gnu_gama/adj/adj_helmert.h>
 #include <gnu_gama/xml/dataparser.h>
 #include <vector>
 #include <cstddef>
@@ -62,7 +64,11 @@ void Adj::init_least_squares()
   switch (algorithm_)
     {
     case envelope:
-      least_squares = new AdjEnvelope<double, int, Exception::matvec>;
+      {
+        auto env = new AdjEnvelope<double, int, Exception::matvec>;
+        env->mixed_precision(mixed_precision_);
+        least_squares = env;
+      }
       break;
     case svd:
       least_squares = new AdjSVD<double, int, Exception::matvec>;
@@ -73,6 +79,12 @@ void Adj::init_least_squares()
     case cholesky:
       least_squares = new AdjCholDec<double, int, Exception::matvec>;
       break;
+    case cgls:
+      least_squares = new AdjCGLS<double, int, Exception::matvec>;
+      break;
+    case helmert:
+      least_squares = new AdjHelmert<double, int, Exception::matvec>;
+      break;
     default:
       throw Exception::adjustment("### unknown algorithm");
     }
@@ -173,6 +185,47 @@ void Adj::init_least_squares()
 
 
 
+int Adj::refinement_steps() const
+{
+  using Env = AdjEnvelope<double, int, Exception::matvec>;
+  if (const Env* env = dynamic_cast<const Env*>(least_squares))
+    return env->refinement_steps();
+
+  return 0;
+}
+
+
+double Adj::refinement_residual() const
+{
+  using Env = AdjEnvelope<double, int, Exception::matvec>;
+  if (const Env* env = dynamic_cast<const Env*>(least_squares))
+    return env->refinement_residual();
+
+  return 0;
+}
+
+
+bool Adj::refinement_fallback() const
+{
+  using Env = AdjEnvelope<double, int, Exception::matvec>;
+  if (const Env* env = dynamic_cast<const Env*>(least_squares))
+    return env->refinement_fallback();
+
+  return false;
+}
+
+
+bool Adj::normal_equations_released() const
+{
+  using Env = AdjEnvelope<double, int, Exception::matvec>;
+  if (const Env* env = dynamic_cast<const Env*>(least_squares))
+    return env->normal_equations_released();
+
+  return false;
+}
+
+
+
 void Adj::set_algorithm(Adj::algorithm alg)
 {
   switch (alg)
@@ -181,6 +234,8 @@ void Adj::set_algorithm(Adj::algorithm alg)
     case svd:
     case gso:
     case cholesky:
+    case cgls:
+    case helmert:
       solved = false;
       algorithm_ = alg;
       break;
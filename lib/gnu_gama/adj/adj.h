@@ -48,7 +48,12 @@ namespace GNU_gama {
         envelope,
         gso,       /*!< Gram-Schmidt ortogonalization of design matrix */
         svd,       /*!< Singular Value decomposition of project matrix */
-        cholesky   /*!< Cholesky decomposition of normal equations     */
+        cholesky,  /*!< Cholesky decomposition of normal equations     */
+        cgls,      /*!< Conjugate gradients without normal equations   */
+        /** Helmert blocking, regions of the network are factorized in
+            parallel and reduced to normal equations of separators.
+         */
+        helmert
       };
 
     Adj ()
@@ -73,6 +78,21 @@ namespace GNU_gama {
     /** returns current numerical algorithm */
     Adj::algorithm get_algorithm() const { return algorithm_; }
 
+    /** single precision factorization with iterative refinement
+        (envelope algorithm only) */
+    void set_mixed_precision(bool mp) { mixed_precision_ = mp; solved = false; }
+    bool get_mixed_precision() const  { return mixed_precision_; }
+
+    /** refinement steps of the mixed precision solution (0 if not used) */
+    int    refinement_steps() const;
+    /** relative norm of the final residual of normal equations */
+    double refinement_residual() const;
+    /** refinement stalled and the solution fell back to double */
+    bool   refinement_fallback() const;
+    /** double precision normal equations are not held by the mixed
+        precision solution (no weight coefficients requested) */
+    bool   normal_equations_released() const;
+
     int    defect() const { return least_squares->defect(); }
     double rtr   () const { return rtr_; }     /*!< weighted sum of squares */
     const Vec<>& x();                          /*!< adjusted parameters     */
@@ -103,6 +123,7 @@ namespace GNU_gama {
 
     bool      solved {false};
     algorithm algorithm_ {envelope};
+    bool      mixed_precision_ {false};
     int       n_obs_{0}, n_par_{0};
     double    rtr_ {0};
     int       minx_dim {0};
@@ -58,10 +58,36 @@ namespace GNU_gama {
 
     virtual Float cond() { return Float(); }  // 0 if not available
 
+    // columns of G are a basis of the null space of the design matrix
+    // (S-transformation of singular systems), false if not available
+
+    virtual bool null_space_basis(Mat<Float,Index,Exception::matvec>&)
+    {
+      return false;
+    }
+
     // weight coefficients for the particular solution (if defined)
 
     virtual Float q0_xx(Index i, Index j)  { return q_xx(i,j); }
 
+    // products Q_xx*B computed for all columns of B in one batch
+    // (B is overwritten), implicitly from elements q_xx(i,j)
+
+    virtual void q_xx_batch(Mat<Float,Index,Exception::matvec>& B)
+    {
+      const Index N = B.rows();
+      Vec<Float,Index,Exception::matvec> t(N);
+      for (Index c=1; c<=B.cols(); c++)
+        {
+          t.set_zero();
+          for (Index j=1; j<=N; j++)
+            if (const Float b = B(j,c))
+              for (Index i=1; i<=N; i++) t(i) += q_xx(i,j)*b;
+
+          for (Index i=1; i<=N; i++) B(i,c) = t(i);
+        }
+    }
+
   };
 
 }
@@ -0,0 +1,821 @@
+/*
+  GNU Gama -- adjustment of geodetic networks
+  Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_Gama_gnu_gama_adj_cgls_gnugamaadjcgls_adj_cgls_h
+#define GNU_Gama_gnu_gama_adj_cgls_gnugamaadjcgls_adj_cgls_h
+
+
+#include <gnu_gama/adj/adj_basesparse.h>
+#include <gnu_gama/adj/homogenization.h>
+#include <gnu_gama/parallel.h>
+#include <matvec/svd.h>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace GNU_gama {
+
+
+  /** \brief Matrix-free iterative adjustment.
+   *
+   * Least squares solution by conjugate gradients (CGLS) applied to
+   * the homogenized sparse design matrix, normal equations are never
+   * formed. Columns of the design matrix are scaled to unit length
+   * (Jacobi preconditioning).
+   *
+   * Singular systems are regularized by the parameters given in
+   * min_x(n, list). Their null space is found from a small dense
+   * matrix of order n, each of its columns needs one iterative
+   * solution with the remaining parameters. Without the list
+   * (min_x() or an empty list) all parameters are regularized and the
+   * null space is found iteratively by projections of random vectors,
+   * a regular system costs one additional iterative solution.
+   *
+   * Weight coefficients are computed on demand, each column of Q_xx
+   * by preconditioned conjugate gradients; computed columns are kept
+   * up to a fixed memory limit. Weight coefficients of adjusted
+   * observations are computed from the columns of Q_xx.
+   */
+
+  template <typename Float=double,  typename Index=int,
+            typename Exc=Exception::matvec>
+  class AdjCGLS
+    : public AdjBaseSparse<Float, Index, Exc, AdjInputData>
+  {
+  public:
+
+    AdjCGLS() = default;
+    ~AdjCGLS() override = default;
+
+    AdjCGLS(const AdjCGLS&) = delete;
+    AdjCGLS& operator= (const AdjCGLS&) = delete;
+    AdjCGLS(const AdjCGLS&&) = delete;
+    AdjCGLS& operator= (const AdjCGLS&&) = delete;
+
+    const GNU_gama::Vec<Float, Index, Exc>& unknowns() override;
+    const GNU_gama::Vec<Float, Index, Exc>& residuals() override;
+    Float sum_of_squares() override;
+    Index defect() override;
+
+    Float q_xx(Index i, Index j) override;
+    Float q_bb(Index i, Index j) override;
+    Float q_bx(Index i, Index j) override;
+
+    bool lindep(Index i) override;
+    void min_x() override;
+    void min_x(Index n, Index m[]) override;
+
+    void reset(const AdjInputData *data) override;
+
+    /** relative norm of the residual of normal equations at which
+        iterations stop */
+    void  tolerance(Float t) { tol_ = t; solved = false; }
+    Float tolerance() const  { return tol_; }
+
+    /** number of iterations of the last least squares solution */
+    Index iterations() const { return iterations_; }
+
+  private:
+
+    using Vector = GNU_gama::Vec<Float, Index, Exc>;
+
+    Homogenization<Float, Index>           hom;
+    const SparseMatrix<Float, Index>*      design_matrix {nullptr};
+    std::unique_ptr<SparseMatrix<Float, Index>> transposed;
+
+    Index  observations {0};
+    Index  parameters   {0};
+    Index  nullity      {0};
+    Vector x;                          // unique or regularized solution
+    Vector resid;                      // residuals
+    Vector colnorm;                    // norms of design matrix columns
+    Float  squares      {0};           // sum of squares
+    Float  tol_         {1e-12};
+    static constexpr Float q_tol {1e-10};   // columns of Q_xx
+    Index  iterations_  {0};
+    bool   solved       {false};
+    bool   init_residuals {true};
+
+    std::vector<Index> min_x_given;    // min_x(n, list), all if empty
+    std::vector<Index> min_x_list;     // regularized parameters
+    std::vector<char>  in_min_x;       // 1 based indexing
+    Mat<Float, Index, Exc> G;          // null space, orthonormal on min_x
+
+    /* columns of Q_xx, their number is limited by qxx_floats and the
+       oldest column is replaced when the buffer is full */
+
+    static constexpr std::size_t qxx_floats = std::size_t(1) << 24;
+    std::vector<Vector> qxxbuf;
+    std::vector<Index>  qxx_slot;      // column -> buffer index + 1
+    std::vector<Index>  qxx_key;       // buffer index -> column
+    std::size_t         qxx_next {0};
+    std::mutex          qxx_mutex;     // q_xx() may be called concurrently
+
+    void solve();
+    void null_space();
+    void null_space_all();
+
+    void mul      (const Vector& v, Vector& t) const;   // t = A v
+    void trans_mul(const Vector& t, Vector& v) const;   // v = A't
+    void column   (Index j, Vector& t) const;           // t = A e_j
+    static Float dot(const Vector& a, const Vector& b);
+
+    template <typename Prod, typename TransProd>
+    Index cgls(Prod prod, TransProd trans_prod, Vector r, Index n,
+               Vector& y) const;
+
+    void q_column(Vector r, Vector& y) const;   // (N + CC') y = r
+
+    /* relative singular value of the design matrix below which its
+       columns are considered linearly dependent; iterations stop at
+       the relative residual tol_ of normal equations, which resolves
+       singular values down to sqrt(tol_) */
+    Float null_tol() const
+    {
+      return std::sqrt(std::max(tol_, std::numeric_limits<Float>::epsilon()));
+    }
+  };
+
+  // ---  Implementation  ------------------------------------------------
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::reset(const AdjInputData *data)
+  {
+    this->input  = data;
+    this->stage  = 0;
+    solved = false;
+    hom.reset(data);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::mul(const Vector& v, Vector& t) const
+  {
+    const SparseMatrix<Float, Index>* mat = design_matrix;
+    parallel_for(Index(1), observations+1, Index(256),
+                 [&](Index first, Index last)
+      {
+        for (Index i=first; i<last; i++)
+          {
+            const Float* b = mat->begin (i);
+            const Float* e = mat->end   (i);
+            const Index* n = mat->ibegin(i);
+            Float s = Float();
+            while (b != e) s += *b++ * v(*n++);
+            t(i) = s;
+          }
+      });
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::trans_mul(const Vector& t, Vector& v) const
+  {
+    const SparseMatrix<Float, Index>* mtr = transposed.get();
+    parallel_for(Index(1), parameters+1, Index(256),
+                 [&](Index first, Index last)
+      {
+        for (Index j=first; j<last; j++)
+          {
+            const Float* b = mtr->begin (j);
+            const Float* e = mtr->end   (j);
+            const Index* n = mtr->ibegin(j);
+            Float s = Float();
+            while (b != e) s += *b++ * t(*n++);
+            v(j) = s;
+          }
+      });
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::column(Index j, Vector& t) const
+  {
+    t.reset(observations);
+    t.set_zero();
+
+    const Float* b = transposed->begin (j);
+    const Float* e = transposed->end   (j);
+    const Index* n = transposed->ibegin(j);
+    while (b != e) t(*n++) = *b++;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjCGLS<Float, Index, Exc>::dot(const Vector& a, const Vector& b)
+  {
+    return parallel_reduce(Index(1), a.dim()+1, Index(4096), Float(),
+                           [&](Index first, Index last)
+                           {
+                             Float s = Float();
+                             for (Index i=first; i<last; i++) s += a(i)*b(i);
+                             return s;
+                           },
+                           [](Float p, Float q) { return p + q; });
+  }
+
+
+  /* Conjugate gradients for least squares min ||B y - r||, where
+   * prod(p, q) computes q = B p and trans_prod(r, s) computes s = B'r.
+   * The iteration starts from y = 0 and converges to the minimum norm
+   * solution.
+   */
+
+  template <typename Float, typename Index, typename Exc>
+  template <typename Prod, typename TransProd>
+  Index AdjCGLS<Float, Index, Exc>::cgls(Prod prod, TransProd trans_prod,
+                                         Vector r, Index n, Vector& y) const
+  {
+    y.reset(n);
+    y.set_zero();
+    if (n == 0) return 0;
+
+    Vector s(n), p(n), q(r.dim());
+    trans_prod(r, s);
+    p = s;
+
+    Float gamma = dot(s, s);
+    const Float stop = tol_*tol_*gamma;
+    const Index max_iter = 4*n + 100;
+
+    Index k = 0;
+    while (gamma > stop && k < max_iter)
+      {
+        k++;
+        prod(p, q);
+        const Float qq = dot(q, q);
+        if (qq <= Float()) break;
+
+        const Float alpha = gamma/qq;
+        for (Index i=1; i<=n; i++)       y(i) += alpha*p(i);
+        for (Index i=1; i<=r.dim(); i++) r(i) -= alpha*q(i);
+
+        trans_prod(r, s);
+        const Float g = dot(s, s);
+        const Float beta = g/gamma;
+        gamma = g;
+        for (Index i=1; i<=n; i++) p(i) = s(i) + beta*p(i);
+      }
+
+    return k;
+  }
+
+
+  /* Null space of the design matrix is parametrized by the min_x
+   * parameters S. For the remaining parameters R, the projection of
+   * columns A_S onto the orthogonal complement of range(A_R) is
+   * K = (I - P_R)A_S and null(A) = { (u, -pinv(A_R) A_S u) : Ku = 0 }.
+   * The null vectors u are right singular vectors of K'K.
+   */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::null_space()
+  {
+    nullity = 0;
+    G.reset(parameters, 0);
+    in_min_x.assign(parameters+1, 0);
+
+    min_x_list = min_x_given;
+    if (min_x_list.empty())
+      {
+        null_space_all();
+        return;
+      }
+
+    for (Index j : min_x_list) in_min_x[j] = 1;
+    const Index S = static_cast<Index>(min_x_list.size());
+
+    // A_R with unit columns
+
+    Vector tmp(parameters);
+    auto prod = [&](const Vector& p, Vector& q)
+      {
+        for (Index j=1; j<=parameters; j++)
+          tmp(j) = in_min_x[j] || colnorm(j) == Float() ? Float()
+                                                        : p(j)/colnorm(j);
+        mul(tmp, q);
+      };
+    auto trans_prod = [&](const Vector& r, Vector& s)
+      {
+        trans_mul(r, s);
+        for (Index j=1; j<=parameters; j++)
+          s(j) = in_min_x[j] || colnorm(j) == Float() ? Float()
+                                                      : s(j)/colnorm(j);
+      };
+    auto solution = [&](const Vector& y, Vector& w)
+      {
+        w.reset(parameters);
+        for (Index j=1; j<=parameters; j++)
+          w(j) = in_min_x[j] || colnorm(j) == Float() ? Float()
+                                                      : y(j)/colnorm(j);
+      };
+
+    Mat<Float, Index, Exc> K(S, S);
+    Vector a, y, w, t(observations);
+    for (Index c=1; c<=S; c++)
+      {
+        column(min_x_list[c-1], a);
+        cgls(prod, trans_prod, a, parameters, y);
+        solution(y, w);
+        mul(w, t);
+        for (Index i=1; i<=observations; i++) a(i) -= t(i);   // (I - P_R)a
+
+        for (Index r=1; r<=S; r++)
+          {
+            const Index  j = min_x_list[r-1];
+            const Float* b = transposed->begin (j);
+            const Float* e = transposed->end   (j);
+            const Index* n = transposed->ibegin(j);
+            Float s = Float();
+            while (b != e) s += *b++ * a(*n++);
+            K(r,c) = s;
+          }
+      }
+
+    for (Index r=1; r<=S; r++)
+      for (Index c=r+1; c<=S; c++)
+        K(r,c) = K(c,r) = (K(r,c) + K(c,r))/2;
+
+    SVD<Float, Index, Exc> svd(K);
+    const Vec<Float, Index, Exc>& W = svd.SVD_W();
+    const Mat<Float, Index, Exc>& V = svd.SVD_V();
+
+    // K is a product of design matrix columns, its singular values are
+    // squares of singular values of the projected columns
+
+    Float wmax = Float();
+    for (Index k=1; k<=S; k++) wmax = std::max(wmax, W(k));
+    const Float wtol = null_tol()*null_tol()*wmax;
+
+    std::vector<Index> null;
+    for (Index k=1; k<=S; k++)
+      if (W(k) <= wtol) null.push_back(k);
+
+    nullity = static_cast<Index>(null.size());
+    G.reset(parameters, nullity);
+    G.set_zero();
+
+    for (Index c=1; c<=nullity; c++)
+      {
+        const Index k = null[c-1];
+
+        a.reset(observations);
+        a.set_zero();
+        for (Index r=1; r<=S; r++)
+          {
+            const Index  j = min_x_list[r-1];
+            const Float  u = V(r,k);
+            const Float* b = transposed->begin (j);
+            const Float* e = transposed->end   (j);
+            const Index* n = transposed->ibegin(j);
+            while (b != e) a(*n++) += *b++ * u;
+
+            G(j,c) = u;
+          }
+
+        cgls(prod, trans_prod, a, parameters, y);
+        solution(y, w);
+        for (Index j=1; j<=parameters; j++)
+          if (!in_min_x[j]) G(j,c) = -w(j);
+      }
+  }
+
+
+  /* Null space of the design matrix without min_x list. With columns
+   * scaled to unit length, B = AD, the minimum norm solution y of
+   * By = Bz is the projection of z onto range(B') and u = z - y lies
+   * in null(B). Random vectors z are projected until the part of u
+   * orthogonal to the null vectors already found is negligible or
+   * is not a null vector (||Bu|| > null_tol()||u||). A regular system
+   * needs a single projection, the normal matrix is never formed.
+   */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::null_space_all()
+  {
+    for (Index j=1; j<=parameters; j++)
+      {
+        min_x_list.push_back(j);
+        in_min_x[j] = 1;
+      }
+
+    Vector scale(parameters);
+    for (Index j=1; j<=parameters; j++)
+      scale(j) = colnorm(j) > Float() ? 1/colnorm(j) : Float(1);
+
+    Vector tmp(parameters);
+    auto prod = [&](const Vector& p, Vector& q)
+      {
+        for (Index j=1; j<=parameters; j++) tmp(j) = p(j)*scale(j);
+        mul(tmp, q);
+      };
+    auto trans_prod = [&](const Vector& r, Vector& s)
+      {
+        trans_mul(r, s);
+        for (Index j=1; j<=parameters; j++) s(j) *= scale(j);
+      };
+    auto orthogonalize = [&](const std::vector<Vector>& basis, Vector& u)
+      {
+        for (int pass=0; pass<2; pass++)
+          for (const Vector& b : basis)
+            {
+              const Float d = dot(b, u);
+              for (Index j=1; j<=parameters; j++) u(j) -= d*b(j);
+            }
+      };
+
+    std::mt19937 generator(1);         // reproducible results
+    std::uniform_real_distribution<double> random(-1.0, 1.0);
+
+    std::vector<Vector> null;
+    Vector z(parameters), t(observations), y, u;
+    while (static_cast<Index>(null.size()) < parameters)
+      {
+        for (Index j=1; j<=parameters; j++) z(j) = Float(random(generator));
+        orthogonalize(null, z);
+        const Float zn = std::sqrt(dot(z, z));
+
+        prod(z, t);
+        cgls(prod, trans_prod, t, parameters, y);
+        u = z;
+        for (Index j=1; j<=parameters; j++) u(j) -= y(j);
+        orthogonalize(null, u);
+
+        const Float un = std::sqrt(dot(u, u));
+        if (!(un > null_tol()*zn)) break;
+
+        prod(u, t);
+        if (std::sqrt(dot(t, t)) > null_tol()*un) break;
+
+        for (Index j=1; j<=parameters; j++) u(j) /= un;
+        null.push_back(u);
+      }
+
+    // null vectors D*u of the design matrix, orthonormalized
+
+    nullity = static_cast<Index>(null.size());
+    G.reset(parameters, nullity);
+    for (Index c=1; c<=nullity; c++)
+      {
+        Vector& g = null[c-1];
+        for (Index j=1; j<=parameters; j++) g(j) *= scale(j);
+
+        for (int pass=0; pass<2; pass++)
+          for (Index k=1; k<c; k++)
+            {
+              Float d = Float();
+              for (Index j=1; j<=parameters; j++) d += G(j,k)*g(j);
+              for (Index j=1; j<=parameters; j++) g(j) -= d*G(j,k);
+            }
+
+        const Float gn = std::sqrt(dot(g, g));
+        for (Index j=1; j<=parameters; j++) G(j,c) = g(j)/gn;
+      }
+  }
+
+
+  /* The regularized solution minimizes ||Ax - b||^2 + ||C'x||^2, where
+   * C contains min_x rows of the null space G (C'G = I). Its solution
+   * satisfies C'x = 0, i.e. the norm of min_x parameters is minimal.
+   */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::solve()
+  {
+    if (solved) return;
+
+    design_matrix = hom.mat();
+    observations  = design_matrix->rows();
+    parameters    = design_matrix->columns();
+    transposed.reset(design_matrix->transpose());
+
+    colnorm.reset(parameters);
+    for (Index j=1; j<=parameters; j++)
+      {
+        const Float* b = transposed->begin(j);
+        const Float* e = transposed->end  (j);
+        Float s = Float();
+        for (; b != e; b++) s += *b * *b;
+        colnorm(j) = std::sqrt(s);
+      }
+
+    null_space();
+
+    // Jacobi scaling of the augmented matrix [A; C']
+
+    Vector scale(parameters);
+    for (Index j=1; j<=parameters; j++)
+      {
+        Float s = colnorm(j)*colnorm(j);
+        if (in_min_x[j])
+          for (Index c=1; c<=nullity; c++) s += G(j,c)*G(j,c);
+        scale(j) = s > Float() ? 1/std::sqrt(s) : Float(1);
+      }
+
+    const Index M = observations;
+    Vector tmp(parameters), top(M);
+    auto prod = [&](const Vector& p, Vector& q)
+      {
+        for (Index j=1; j<=parameters; j++) tmp(j) = p(j)*scale(j);
+        mul(tmp, top);
+        for (Index i=1; i<=M; i++) q(i) = top(i);
+        for (Index c=1; c<=nullity; c++)
+          {
+            Float s = Float();
+            for (Index j : min_x_list) s += G(j,c)*tmp(j);
+            q(M+c) = s;
+          }
+      };
+    auto trans_prod = [&](const Vector& r, Vector& s)
+      {
+        for (Index i=1; i<=M; i++) top(i) = r(i);
+        trans_mul(top, s);
+        for (Index c=1; c<=nullity; c++)
+          for (Index j : min_x_list) s(j) += G(j,c)*r(M+c);
+        for (Index j=1; j<=parameters; j++) s(j) *= scale(j);
+      };
+
+    const Vec<Float>& rhs = hom.rhs();
+    Vector r(M + nullity), y;
+    for (Index i=1; i<=M; i++) r(i) = rhs(i);
+    for (Index c=1; c<=nullity; c++) r(M+c) = Float();
+
+    iterations_ = cgls(prod, trans_prod, r, parameters, y);
+
+    x.reset(parameters);
+    for (Index j=1; j<=parameters; j++) x(j) = y(j)*scale(j);
+
+    // sum of squares of weighted residuals
+
+    mul(x, top);
+    squares = Float();
+    for (Index i=1; i<=M; i++)
+      {
+        const Float t = top(i) - rhs(i);
+        squares += t*t;
+      }
+
+    const std::size_t columns = std::max<std::size_t>(1, parameters);
+    const std::size_t buffers = std::min<std::size_t>(columns,
+                                  std::max<std::size_t>(6, qxx_floats/columns));
+    qxxbuf.assign(buffers, Vector());
+    qxx_key.assign(buffers, 0);
+    qxx_slot.assign(parameters+1, 0);
+    qxx_next = 0;
+
+    solved = true;
+    init_residuals = true;
+  }
+
+
+  /* Weight coefficients of the regularized solution
+   *
+   *     Q = inv(N + CC') - GG',    N = A'A
+   *
+   * column j is solved by conjugate gradients with diagonal
+   * preconditioning.
+   */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::q_column(Vector r, Vector& y) const
+  {
+    const Index n = parameters;
+    y.reset(n);
+    y.set_zero();
+    if (n == 0) return;
+
+    Vector diag(n), z(n), p(n), q(n), t(observations);
+    for (Index j=1; j<=n; j++)
+      {
+        Float s = colnorm(j)*colnorm(j);
+        if (in_min_x[j])
+          for (Index c=1; c<=nullity; c++) s += G(j,c)*G(j,c);
+        diag(j) = s > Float() ? 1/s : Float(1);
+      }
+
+    auto op = [&](const Vector& v, Vector& w)
+      {
+        mul(v, t);
+        trans_mul(t, w);
+        for (Index c=1; c<=nullity; c++)
+          {
+            Float s = Float();
+            for (Index j : min_x_list) s += G(j,c)*v(j);
+            for (Index j : min_x_list) w(j) += G(j,c)*s;
+          }
+      };
+
+    const Float stop = q_tol*q_tol*dot(r, r);
+    const Index max_iter = 4*n + 100;
+
+    for (Index j=1; j<=n; j++) z(j) = diag(j)*r(j);
+    p = z;
+    Float rho = dot(r, z);
+
+    for (Index k=0; k<max_iter && dot(r, r) > stop; k++)
+      {
+        op(p, q);
+        const Float pq = dot(p, q);
+        if (pq <= Float()) break;
+
+        const Float alpha = rho/pq;
+        for (Index j=1; j<=n; j++) y(j) += alpha*p(j);
+        for (Index j=1; j<=n; j++) r(j) -= alpha*q(j);
+        for (Index j=1; j<=n; j++) z(j) = diag(j)*r(j);
+
+        const Float rn = dot(r, z);
+        const Float beta = rn/rho;
+        rho = rn;
+        for (Index j=1; j<=n; j++) p(j) = z(j) + beta*p(j);
+      }
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  const GNU_gama::Vec<Float, Index, Exc>&
+  AdjCGLS<Float, Index, Exc>::unknowns()
+  {
+    solve();
+
+    return x;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  const GNU_gama::Vec<Float, Index, Exc>&
+  AdjCGLS<Float, Index, Exc>::residuals()
+  {
+    solve();
+
+    if (init_residuals)
+      {
+        const SparseMatrix<Float, Index>* mat = this->input->mat();
+        const Vec<>&                      rhs = this->input->rhs();
+        const Index N = rhs.dim();
+        resid.reset(N);
+
+        for (Index i=1; i<=N; i++)        // residuals = Ax - rhs
+          {
+            Float *b = mat->begin(i);
+            Float *e = mat->end(i);
+            Index *n = mat->ibegin(i);
+            Float  s = Float();
+            while(b != e)
+              {
+                s += *b++ * x(*n++);
+              }
+
+            resid(i) = s - rhs(i);
+          }
+
+        init_residuals = false;
+      }
+
+    return resid;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjCGLS<Float, Index, Exc>::sum_of_squares()
+  {
+    solve();
+
+    return squares;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Index AdjCGLS<Float, Index, Exc>::defect()
+  {
+    solve();
+
+    return nullity;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjCGLS<Float, Index, Exc>::q_xx(Index i, Index j)
+  {
+    solve();
+
+    {
+      std::lock_guard<std::mutex> lock(qxx_mutex);
+
+      if (const Index slot = qxx_slot[j]) return qxxbuf[slot-1](i);
+      if (const Index slot = qxx_slot[i]) return qxxbuf[slot-1](j);
+    }
+
+    // the column is solved without the lock, concurrent calls for
+    // different columns run in parallel
+
+    Vector q, e(parameters);
+    e.set_zero();
+    e(j) = Float(1);
+    q_column(e, q);
+
+    for (Index c=1; c<=nullity; c++)
+      {
+        const Float g = G(j,c);
+        for (Index k=1; k<=parameters; k++) q(k) -= G(k,c)*g;
+      }
+
+    std::lock_guard<std::mutex> lock(qxx_mutex);
+
+    if (qxx_slot[j] == 0)
+      {
+        const std::size_t slot = qxx_next++ % qxxbuf.size();
+        if (qxx_key[slot]) qxx_slot[qxx_key[slot]] = 0;
+        qxx_key [slot] = j;
+        qxx_slot[j] = static_cast<Index>(slot) + 1;
+        qxxbuf  [slot] = q;
+      }
+
+    return q(i);
+  }
+
+
+  /* Q_bb = A Q_xx A', rows of the design matrix are sparse and their
+   * elements are combined with the cached columns of Q_xx
+   */
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjCGLS<Float, Index, Exc>::q_bb(Index i, Index j)
+  {
+    solve();
+
+    const Float* bj = design_matrix->begin (j);
+    const Float* ej = design_matrix->end   (j);
+    const Index* nj = design_matrix->ibegin(j);
+
+    Float s = Float();
+    for (; bj != ej; bj++, nj++)
+      {
+        const Float* bi = design_matrix->begin (i);
+        const Float* ei = design_matrix->end   (i);
+        const Index* ni = design_matrix->ibegin(i);
+        Float t = Float();
+        while (bi != ei) t += *bi++ * q_xx(*ni++, *nj);
+
+        s += t * *bj;
+      }
+
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjCGLS<Float, Index, Exc>::q_bx(Index, Index)
+  {
+    throw Exc(Exception::BadRegularization,
+              "q_bx not implemented");
+    return 0;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjCGLS<Float, Index, Exc>::lindep(Index i)
+  {
+    solve();
+
+    return colnorm(i) == Float();
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::min_x()
+  {
+    min_x_given.clear();
+    solved = false;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjCGLS<Float, Index, Exc>::min_x(Index n, Index m[])
+  {
+    min_x_given.assign(m, m+n);
+    solved = false;
+  }
+
+}  // namespace GNU_gama
+
+#endif
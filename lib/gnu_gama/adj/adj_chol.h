@@ -55,6 +55,8 @@ namespace GNU_gama {
     void  min_x   (Index, Index[]) override;
     void  solve   () override;
 
+    bool  null_space_basis(Mat<Float, Index, Exc>&) override;
+
   private:
 
     Index                     M, N; // number of observations, parameters
@@ -121,6 +123,24 @@ namespace GNU_gama {
 
 
 
+  // columns of G orthonormalized on the regularization subset
+
+  template <typename Float, typename Index, typename Exc>
+  bool
+  AdjCholDec<Float, Index, Exc>::null_space_basis(Mat<Float,Index,Exc>& B)
+  {
+    if (!this->is_solved) solve();
+
+    B.reset(N, nullity);
+    for (Index i=1; i<=N; i++)
+      for (Index j=1; j<=nullity; j++)
+        B(i,j) = G(i,j);
+
+    return true;
+  }
+
+
+
   template <typename Float, typename Index, typename Exc>
   Float
   AdjCholDec<Float, Index, Exc>::q_bb(Index i, Index j)
@@ -302,26 +322,29 @@ namespace GNU_gama {
 
     // normal equations mat*x = rhs
 
+    // sums of products of rows of A are accumulated in the same order
+    // as dot products of columns, rows are contiguous and zero elements
+    // of sparse project equations are skipped
+
     mat.reset(N);
     rhs.reset(N);
-    for (Index i=1; i<=N; i++)
+    mat.set_zero();
+    rhs.set_zero();
+    const auto a = A.view();
+    Float* const upper = mat.begin();     // packed by columns of upper part
+    for (Index k=1; k<=M; k++)
       {
-        Float s = 0;
-        for (Index k=1; k<=M; k++)
+        const auto row = a.row(k);
+        const Float bk = b(k);
+        for (Index j=1; j<=N; j++)
           {
-            s += A(k,i)*b(k);
-          }
-        rhs(i) = s;
+            const Float akj = row(j);
+            if (akj == 0) continue;
 
-        for (Index j=i; j<=N; j++)
-          {
-            Float s = 0;
-            for (Index k=1; k<=M; k++)
-              {
-                s += A(k,i)*A(k,j);
-              }
-            mat(i,j) = s;
+            rhs(j) += akj*bk;
 
+            Float* column = upper + j*(j-1)/2 - 1;
+            for (Index i=1; i<=j; i++) column[i] += row(i)*akj;
           }
       }
 
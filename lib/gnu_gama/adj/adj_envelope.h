@@ -27,6 +27,12 @@
 #include <gnu_gama/sparse/smatrix_ordering.h>
 #include <gnu_gama/adj/homogenization.h>
 #include <gnu_gama/movetofront.h>
+#include <gnu_gama/parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace GNU_gama {
@@ -62,10 +68,43 @@ namespace GNU_gama {
     void min_x() override;
     void min_x(Index n, Index m[]) override;
 
+    bool null_space_basis(GNU_gama::Mat<Float, Index, Exc>&) override;
+
+    void q_xx_batch(GNU_gama::Mat<Float, Index, Exc>& B) override;
+
     void solve();
 
     void reset(const AdjInputData *data) override;
 
+    /** \brief Mixed precision solution.
+     *
+     * Normal equations are converted to single precision (float) and
+     * factorized, normal equations in Float are released. The solution
+     * is iteratively refined with residuals A'(b - Ax) computed in Float
+     * from the design matrix. If the single precision system is
+     * singular or the refinement stalls, normal equations in Float are
+     * formed again and the solution is computed from their Cholesky
+     * decomposition. Weight coefficients are computed from the Float
+     * decomposition, which is formed on their first request.
+     *
+     * Memory and time are thus saved only if no weight coefficients are
+     * requested. With covariances of adjusted parameters or observations
+     * the full Float envelope is formed and factorized as without mixed
+     * precision, and the single precision factorization is an extra cost.
+     */
+    void  mixed_precision(bool mp) { mixed_ = mp; set_stage(stage_init); }
+    bool  mixed_precision() const  { return mixed_; }
+
+    /** number of refinement steps of the mixed precision solution */
+    Index refinement_steps() const    { return refinement_steps_; }
+    /** relative 2-norm of the final residual of normal equations */
+    Float refinement_residual() const { return refinement_residual_; }
+    /** refinement stalled and the solution was computed in Float */
+    bool  refinement_fallback() const { return refinement_fallback_; }
+    /** Float normal equations are not held, i.e. the mixed precision
+     *  solution has not requested weight coefficients so far */
+    bool  normal_equations_released() const { return released_; }
+
   private:
 
     ReverseCuthillMcKee<Index>   ordering;
@@ -82,10 +121,18 @@ namespace GNU_gama {
     Envelope<Float, Index>             q0;        // weight coefficients for x0
 
     GNU_gama::Vec<Float, Index, Exc> tmpvec;
-    GNU_gama::Vec<Float, Index, Exc> tmpres;         // used in q_bb
 
+    bool  mixed_ {false};
+    bool  factorized_ {false};          // envelope is Cholesky decomposed
+    Index refinement_steps_ {0};
+    Float refinement_residual_ {0};
+    bool  refinement_fallback_ {false};
+    bool  released_ {false};            // envelope released by mixed_
+
+    // columns of Q_xx shared by concurrent readers of q_xx()
     std::vector<GNU_gama::Vec<Float, Index, Exc>> qxxbuf;
     GNU_gama::MoveToFront<3,Index,Index>          indbuf;
+    std::mutex                                    qxx_mutex;
 
     enum Stage {
       stage_init,       // implicitly set by Adj_BaseSparse constuctor
@@ -94,13 +141,15 @@ namespace GNU_gama {
       stage_q0
     };
 
-    bool init_q_bb{};         // weight coefficieants of adjusted observations
     bool init_residuals{};    // residuals r = Ax - b
     bool init_q0{};           // weight coefficients of particular solution x0
     bool init_x{};            // unique or regularized solution
 
     void set_stage(Stage s);
     void solve_ordering();
+    bool solve_x0_mixed();
+    void normal_equations();
+    void factorize();
     void solve_x0();
     void solve_x();
     void solve_q0();
@@ -145,7 +194,6 @@ namespace GNU_gama {
         init_q0        = true;
         init_x         = true;
       case stage_q0:
-        init_q_bb      = true;
         ;
       }
 
@@ -167,51 +215,202 @@ namespace GNU_gama {
     // for (int i=1; i<=design_matrix->columns(); i++)
     //   ordering.perm(i) = ordering.invp(i) = i;
 
+    // the transposed design matrix lists nonzero elements by columns,
+    // both normal equations and absolute terms are computed by rows
+
+    std::unique_ptr<SparseMatrix<Float, Index>>
+      transposed(design_matrix->transpose());
+
     const Vec<Float>& rhs = hom.rhs();
     const Index N = design_matrix->columns();
     tmpvec.reset(N);
-    tmpvec.set_zero();
 
-    for (Index r=1; r<=design_matrix->rows(); r++)
+    parallel_for(Index(1), N+1, Index(256), [&](Index first, Index last)
       {
-        const Float* b=design_matrix->begin (r);
-        const Float* e=design_matrix->end   (r);
-        const Index* n=design_matrix->ibegin(r);
-
-        while (b != e)
+        for (Index c=first; c<last; c++)
           {
-            const Index c = ordering.invp(*n++);
-            const Float a = *b++;
+            const Index  col = ordering.perm(c);
+            const Float* b = transposed->begin (col);
+            const Float* e = transposed->end   (col);
+            const Index* r = transposed->ibegin(col);
 
             // absolute terms in normal equations
-            tmpvec(c) +=  a * rhs(r);
+            Float s = Float();
+            while (b != e) s += *b++ * rhs(*r++);
+            tmpvec(c) = s;
           }
-      }
+      });
 
-    envelope.set(design_matrix, &graph, &ordering);
+    envelope.set(design_matrix, transposed.get(), &graph, &ordering);
+    factorized_ = false;
+    released_   = false;
 
     set_stage(stage_ordering);
   }
 
 
+  template <typename Float, typename Index, typename Exc>
+  void AdjEnvelope<Float, Index, Exc>::normal_equations()
+  {
+    SparseMatrixGraph <Float, Index> graph(design_matrix);
+    std::unique_ptr<SparseMatrix<Float, Index>>
+      transposed(design_matrix->transpose());
+
+    envelope.set(design_matrix, transposed.get(), &graph, &ordering);
+    factorized_ = false;
+    released_   = false;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjEnvelope<Float, Index, Exc>::factorize()
+  {
+    if (released_) normal_equations();
+    if (factorized_) return;
+
+    envelope.cholDec();
+    factorized_ = true;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjEnvelope<Float, Index, Exc>::solve_x0_mixed()
+  {
+    // normal equations N = A'A (unfactorized envelope) are factorized
+    // in single precision with the tolerance of Float decomposition,
+    // the Float envelope is released until it is needed again
+
+    Envelope<float, Index> single;
+    single.set(envelope);
+    envelope = Envelope<Float, Index>();
+    released_ = true;
+
+    single.cholDec(std::sqrt(std::numeric_limits<Float>::epsilon()));
+    if (single.defect()) return false;
+
+    const SparseMatrix<Float, Index>* mat = hom.mat();
+    const Vec<Float>& rhs = hom.rhs();
+    const Index N = parameters;
+    const Index M = mat->rows();
+
+    Vec<Float, Index, Exc> x(N), r(N), t(M), xo(N);
+    std::vector<float> d(N);
+    x.set_zero();
+    r = tmpvec;                                   // A'b, permuted
+
+    auto norm2 = [](const Vec<Float, Index, Exc>& v)
+      {
+        Float s = Float();
+        for (Index i=1; i<=v.dim(); i++) s += v(i)*v(i);
+        return std::sqrt(s);
+      };
+
+    const Float eps = std::numeric_limits<Float>::epsilon();
+    const Float tol = std::pow(eps, Float(0.75));  // accepted if stalled
+    const Index max_steps = 30;
+    const Float bnorm = norm2(r);
+    Float rnorm = bnorm;
+
+    for (Index step=1; step<=max_steps; step++)
+      {
+        // correction from single precision factorization
+
+        for (Index i=1; i<=N; i++) d[i-1] = float(r(i));
+        single.solve(d.data(), N);
+
+        Float xn = Float(), dn = Float();
+        for (Index i=1; i<=N; i++)
+          {
+            x(i) += Float(d[i-1]);
+            xn = std::max(xn, std::abs(x(i)));
+            dn = std::max(dn, std::abs(Float(d[i-1])));
+          }
+
+        // residuals of normal equations r = A'(b - Ax)
+
+        for (Index i=1; i<=N; i++) xo(ordering.perm(i)) = x(i);
+        parallel_for(Index(1), M+1, Index(256), [&](Index first, Index last)
+          {
+            for (Index i=first; i<last; i++)
+              {
+                const Float* b = mat->begin (i);
+                const Float* e = mat->end   (i);
+                const Index* n = mat->ibegin(i);
+                Float s = rhs(i);
+                while (b != e) s -= *b++ * xo(*n++);
+                t(i) = s;
+              }
+          });
+
+        // A't is accumulated by rows, the transposed design matrix is
+        // not kept next to the single precision factorization
+
+        r.set_zero();
+        for (Index i=1; i<=M; i++)
+          {
+            const Float* b = mat->begin (i);
+            const Float* e = mat->end   (i);
+            const Index* n = mat->ibegin(i);
+            const Float  s = t(i);
+            while (b != e) r(ordering.invp(*n++)) += *b++ * s;
+          }
+
+        const Float rprev = rnorm;
+        rnorm = norm2(r);
+        refinement_steps_    = step;
+        refinement_residual_ = bnorm > Float() ? rnorm/bnorm : rnorm;
+
+        // converged, or residuals stopped decreasing at the level of
+        // rounding errors
+
+        const bool stalled = !(rnorm < rprev/2);
+        if (dn <= 8*eps*xn || (stalled && dn <= tol*xn))
+          {
+            x0.reset(N);
+            for (Index i=1; i<=N; i++) x0(ordering.perm(i)) = x(i);
+            return true;
+          }
+
+        if (stalled) break;
+      }
+
+    return false;
+  }
+
+
   template <typename Float, typename Index, typename Exc>
   void AdjEnvelope<Float, Index, Exc>::solve_x0()
   {
     if (this->stage >= stage_x0) return;
     solve_ordering();
 
-    // Cholesky decomposition L*D*L'
+    refinement_steps_    = 0;
+    refinement_residual_ = Float();
+    refinement_fallback_ = false;
 
-    envelope.cholDec();
+    if (mixed_ && solve_x0_mixed())
+      {
+        nullity = 0;
+      }
+    else
+      {
+        refinement_fallback_ = mixed_;
 
-    // particular solution x0
+        // Cholesky decomposition L*D*L'
 
-    envelope.solve(tmpvec.begin(), tmpvec.dim());
+        factorize();
 
-    x0.reset(tmpvec.dim());
-    for (Index i=1; i<=tmpvec.dim(); i++)
-      {
-        x0(ordering.perm(i)) = tmpvec(i);
+        // particular solution x0
+
+        envelope.solve(tmpvec.begin(), tmpvec.dim());
+
+        x0.reset(tmpvec.dim());
+        for (Index i=1; i<=tmpvec.dim(); i++)
+          {
+            x0(ordering.perm(i)) = tmpvec(i);
+          }
+
+        nullity = envelope.defect();
       }
     tmpvec.reset();
 
@@ -235,8 +434,6 @@ namespace GNU_gama {
         squares += t*t;
       }
 
-    nullity = envelope.defect();
-
     if (nullity)
       {
         qxxbuf.resize(indbuf.size());
@@ -347,6 +544,8 @@ namespace GNU_gama {
 
     if (init_x) solve_x();
 
+    std::lock_guard<std::mutex> lock(qxx_mutex);
+
     std::pair<Index,bool> pa = indbuf.get(i);
     std::pair<Index,bool> pb = indbuf.get(j);
 
@@ -382,6 +581,8 @@ namespace GNU_gama {
 
     // elements outside the envelope (full solution)
 
+    std::lock_guard<std::mutex> lock(qxx_mutex);
+
     if (qxxbuf[0].dim() != parameters)
       {
         qxxbuf.resize(indbuf.size());
@@ -442,12 +643,10 @@ namespace GNU_gama {
 
   FULL_VECTOR:
 
-    if (init_q_bb)
-    {
-      tmpres.reset(parameters);
-      init_q_bb = false;
-    }
+    // local working vector, q_bb() can be called from parallel loops
+    // once the stage_q0 is reached
 
+    Vec<Float, Index, Exc> tmpres(parameters);
     tmpres.set_zero();
     b = design_matrix->begin (j);
     e = design_matrix->end   (j);
@@ -485,6 +684,7 @@ namespace GNU_gama {
   bool AdjEnvelope<Float, Index, Exc>::lindep(Index i)
   {
     if (this->stage < stage_x0) solve_x0();
+    if (nullity == 0) return false;
 
     return (envelope.diagonal(i) == Float());
   }
@@ -513,6 +713,78 @@ namespace GNU_gama {
   }
 
 
+  template <typename Float, typename Index, typename Exc>
+  bool AdjEnvelope<Float, Index, Exc>
+    ::null_space_basis(GNU_gama::Mat<Float, Index, Exc>& B)
+  {
+    if (init_x) solve_x();
+
+    // rows of G are in the envelope ordering
+
+    B.reset(parameters, nullity);
+    for (Index i=1; i<=parameters; i++)
+      for (Index j=1; j<=nullity; j++)
+        B(ordering.perm(i), j) = G(i, j);
+
+    return true;
+  }
+
+
+  // Q_xx = T*inv(L')*inv(D)*inv(L)*T' (T is identity for regular
+  // systems), columns of B are solved independently in parallel
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjEnvelope<Float, Index, Exc>
+    ::q_xx_batch(GNU_gama::Mat<Float, Index, Exc>& B)
+  {
+    if (this->stage < stage_q0) solve_q0();
+    if (nullity && init_x) solve_x();
+
+    // regularized unknowns in the envelope ordering (columns of T)
+
+    std::vector<char> reg(parameters+1, 0);
+    if (nullity)
+      for (Index k=0; k<min_x_size; k++) reg[ordering.invp(min_x_list[k])] = 1;
+
+    parallel_for(Index(1), B.cols()+1, Index(8), [&](Index first, Index last)
+      {
+        Vec<Float, Index, Exc> z(parameters), h(nullity);
+        for (Index c=first; c<last; c++)
+          {
+            for (Index i=1; i<=parameters; i++) z(ordering.invp(i)) = B(i,c);
+
+            // z = T'*b
+
+            for (Index k=1; k<=nullity; k++)
+              {
+                Float s = Float();
+                for (Index i=1; i<=parameters; i++) s += G(i,k)*z(i);
+                h(k) = s;
+              }
+            for (Index k=1; k<=nullity; k++)
+              for (Index i=1; i<=parameters; i++)
+                if (reg[i]) z(i) -= G(i,k)*h(k);
+
+            envelope.solve(z.begin(), parameters);
+
+            // z = T*z
+
+            for (Index k=1; k<=nullity; k++)
+              {
+                Float s = Float();
+                for (Index i=1; i<=parameters; i++)
+                  if (reg[i]) s += G(i,k)*z(i);
+                h(k) = s;
+              }
+            for (Index k=1; k<=nullity; k++)
+              for (Index i=1; i<=parameters; i++) z(i) -= G(i,k)*h(k);
+
+            for (Index i=1; i<=parameters; i++) B(i,c) = z(ordering.invp(i));
+          }
+      });
+  }
+
+
   template <typename Float, typename Index, typename Exc>
   void AdjEnvelope<Float, Index, Exc>::solve()
   {
@@ -527,6 +799,7 @@ namespace GNU_gama {
       {
         if (this->stage < stage_x0) solve_x0();
 
+        factorize();
         q0.inverse(envelope);
 
         init_q0 = false;
@@ -598,11 +871,8 @@ namespace GNU_gama {
 
         // Gramm-Schmidt orthogonalization
 
-        static Float s_tol = Float();
-        if (s_tol <= Float())
-          {
-            s_tol = std::sqrt( std::numeric_limits<Float>::epsilon() );
-          }
+        static const Float s_tol =
+          std::sqrt( std::numeric_limits<Float>::epsilon() );
 
         for (Index column=1; column<=nullity; column++)
           {
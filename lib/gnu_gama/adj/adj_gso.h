@@ -118,10 +118,12 @@ namespace GNU_gama {
  #ifdef GNU_GAMA_GSO_LEGACY_CODE
     A_.reset(M+N, N+1);
 
+    const auto a = A1.view();
     for (Index i=1; i<=M; i++)
       {
         A_(i, N+1) = -b1(i);
-        for (Index j=1; j<=N; j++) A_(i, j) = A1(i, j);
+        const auto row = a.row(i);
+        for (Index j=1; j<=N; j++) A_(i, j) = row(j);
       }
 
     for (Index i=1; i<=N; i++)
@@ -146,28 +148,17 @@ namespace GNU_gama {
     icgs_data = new double[(M+N)*(N+1)];
     double* p = icgs_data;
 
-    for (Index c=1; c<=N+1; c++)
-      for (Index r=1; r<=M+N; r++)
-        {
-          if (c <= N)
-            {
-              if (r<=M) {
-                  *p++ = A1(r,c);
-                }
-              else {
-                  *p++ = r-M==c ? 1 : 0;
-                }
-            }
-          else
-            {
-              if (r<=M) {
-                  *p++ = -b1(r);
-                }
-              else {
-                  *p++ = 0;
-                }
-            }
-        }
+    // column major copy of [A -b; I 0]
+
+    const auto a = A1.view();
+    for (Index c=1; c<=N; c++)
+      {
+        const auto column = a.col(c);
+        for (Index r=1; r<=M; r++) *p++ = column(r);
+        for (Index r=1; r<=N; r++) *p++ = r==c ? 1 : 0;
+      }
+    for (Index r=1; r<=M; r++) *p++ = -b1(r);
+    for (Index r=1; r<=N; r++) *p++ = 0;
     icgs.reset(icgs_data, M, N, N, 1);
     icgs.icgs1();
     icgs.icgs2();
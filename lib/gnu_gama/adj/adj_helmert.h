@@ -0,0 +1,870 @@
+/*
+  GNU Gama -- adjustment of geodetic networks
+  Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_Gama_gnu_gama_adj_helmert_gnugamaadjhelmert_adj_helmert_h
+#define GNU_Gama_gnu_gama_adj_helmert_gnugamaadjhelmert_adj_helmert_h
+
+
+#include <gnu_gama/adj/adj_basesparse.h>
+#include <gnu_gama/adj/adj_envelope.h>
+#include <gnu_gama/adj/envelope.h>
+#include <gnu_gama/sparse/smatrix_graph.h>
+#include <gnu_gama/sparse/smatrix_ordering.h>
+#include <gnu_gama/adj/homogenization.h>
+#include <gnu_gama/movetofront.h>
+#include <gnu_gama/parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GNU_gama {
+
+
+  /** \brief Helmert blocking of sparse normal equations.
+   *
+   * Unknowns are split into regions of consecutive levels of the
+   * reverse Cuthill-McKee ordering of the design matrix graph. An
+   * unknown connected to a region with a higher number is a separator,
+   * interior unknowns of different regions never occur in the same
+   * observation. Normal equations of region interiors are factorized
+   * independently in parallel, their Schur complements are assembled
+   * into reduced normal equations of separators, which are solved
+   * before back substitution for interiors.
+   *
+   * Envelope factors of all regions and the dense L*D*L' decomposition
+   * of separators are kept for repeated solutions (unknowns, weight
+   * coefficients). Dense coupling blocks W = Ai'As exist only during
+   * the factorization of their region, Schur complements of regions
+   * are released when they are added to the separator matrix. The
+   * memory is dominated by the ns x ns separator matrix for networks
+   * with many separators.
+   *
+   * The partition does not depend on the number of threads and the
+   * results are identical for any thread count. Singular systems
+   * (free networks) are solved by the monolithic envelope algorithm.
+   */
+
+  template <typename Float=double,  typename Index=int,
+            typename Exc=Exception::matvec>
+  class AdjHelmert
+    : public AdjBaseSparse<Float, Index, Exc, AdjInputData>
+  {
+  public:
+
+    AdjHelmert() = default;
+    ~AdjHelmert() override = default;
+
+    AdjHelmert(const AdjHelmert&) = delete;
+    AdjHelmert& operator= (const AdjHelmert&) = delete;
+    AdjHelmert(const AdjHelmert&&) = delete;
+    AdjHelmert& operator= (const AdjHelmert&&) = delete;
+
+    const GNU_gama::Vec<Float, Index, Exc>& unknowns() override;
+    const GNU_gama::Vec<Float, Index, Exc>& residuals() override;
+    Float sum_of_squares() override;
+    Index defect() override;
+
+    Float q_xx(Index i, Index j) override;
+    Float q_bb(Index i, Index j) override;
+    Float q_bx(Index i, Index j) override;
+
+    Float q0_xx(Index i, Index j) override;
+
+    bool lindep(Index i) override;
+    void min_x() override;
+    void min_x(Index n, Index m[]) override;
+
+    bool null_space_basis(Mat<Float, Index, Exc>& G) override;
+
+    void q_xx_batch(Mat<Float, Index, Exc>& B) override;
+
+    void solve();
+
+    void reset(const AdjInputData *data) override;
+
+    /** requested number of regions, 0 for the implicit value */
+    void  set_regions(Index n) { regions_ = n; set_stage(stage_init); }
+
+    /** number of regions of the partitioned solution */
+    Index regions()    { solve_blocks(); return Index(reg.size()); }
+    /** number of separator unknowns */
+    Index separators() { solve_blocks(); return Index(sep_list.size()); }
+    /** the system is singular and solved by the envelope algorithm */
+    bool  monolithic() { solve_blocks(); return envelope_ != nullptr; }
+
+  private:
+
+    using V = GNU_gama::Vec<Float, Index, Exc>;
+
+    struct Region
+    {
+      std::vector<Index> interior;    // unknowns of the region interior
+      std::vector<Index> sep;         // sorted separators in region rows
+      std::vector<Index> rows;        // rows of homogenized design matrix
+      SparseMatrix<Float, Index> Ai;  // interior columns of region rows
+      SparseMatrix<Float, Index> As;  // separator columns of region rows
+      ReverseCuthillMcKee<Index> ordering;
+      Envelope<Float, Index>     chol;
+      Mat<Float, Index, Exc>     schur;
+      bool                       regular {false};
+
+      void solve(V& v, V& t) const;   // v = inv(Ai'Ai)*v
+    };
+
+    Homogenization<Float, Index>            hom;
+    const SparseMatrix<Float, Index>*       design_matrix {nullptr};
+    Index                                   observations {0};
+    Index                                   parameters {0};
+    Index                                   regions_ {0};
+
+    std::vector<std::unique_ptr<Region>>    reg;
+    std::vector<Index>                      sep_list;   // separator unknowns
+    std::vector<Index>                      sep_rows;   // only separators
+    Mat<Float, Index, Exc>                  S;          // L*D*L' of separators
+
+    GNU_gama::Vec<Float, Index, Exc>        x;
+    GNU_gama::Vec<Float, Index, Exc>        resid;
+    Float                                   squares {0};
+
+    std::unique_ptr<AdjEnvelope<Float, Index, Exc>> envelope_;
+    std::vector<Index>                      min_x_list;
+    bool                                    min_x_set {false};
+
+    // columns of Q_xx shared by concurrent readers of q_xx()
+    std::vector<GNU_gama::Vec<Float, Index, Exc>> qxxbuf;
+    GNU_gama::MoveToFront<3,Index,Index>          indbuf;
+    std::mutex                                    qxx_mutex;
+
+    enum Stage {
+      stage_init,       // implicitly set by Adj_BaseSparse constuctor
+      stage_blocks,     // factorized regions and separators
+      stage_x           // unknowns, residuals and sum of squares
+    };
+
+    void set_stage(Stage s);
+    void solve_blocks();
+    void solve_x();
+    void partition(Index k);
+    void factorize_region(Region& r);
+    bool factorize_separators();
+    void block_solve(V& g, bool parallel) const;
+    void singular();
+  };
+
+  // ---  Implementation  ------------------------------------------------
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::reset(const AdjInputData *data)
+  {
+    observations = data->mat()->rows();
+    parameters   = data->mat()->columns();
+    this->input  = data;
+
+    set_stage(stage_init);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::set_stage(Stage s)
+  {
+    if (s == stage_init)
+      {
+        reg.clear();
+        sep_list.clear();
+        sep_rows.clear();
+        S.reset();
+        envelope_.reset();
+
+        indbuf.erase();
+        qxxbuf.resize(indbuf.size());
+        for (Index i=0; i<static_cast<Index>(qxxbuf.size()); i++)
+          qxxbuf[i].reset();
+      }
+
+    this->stage = s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::Region::solve(V& v, V& t) const
+  {
+    const Index ni = Index(interior.size());
+
+    for (Index c=1; c<=ni; c++) t(c) = v(ordering.perm(c));
+    chol.solve(t.begin(), ni);
+    for (Index c=1; c<=ni; c++) v(ordering.perm(c)) = t(c);
+  }
+
+
+  /* Regions are formed by consecutive levels of the reverse
+   * Cuthill-McKee ordering, which keeps the number of separators
+   * proportional to the width of the ordering levels. */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::partition(Index k)
+  {
+    const Index N = parameters;
+
+    SparseMatrixGraph<Float, Index> graph(design_matrix);
+    ReverseCuthillMcKee<Index> rcm(&graph);
+
+    std::vector<Index> region(N+1);
+    for (Index c=1; c<=N; c++)
+      region[c] = Index((long long)(rcm.invp(c) - 1)*k/N);
+
+    std::vector<Index> local(N+1, 0);    // 0 for separators
+    reg.clear();
+    for (Index r=0; r<k; r++) reg.push_back(std::make_unique<Region>());
+
+    for (Index c=1; c<=N; c++)
+      {
+        bool separator = false;
+        for (auto b=graph.begin(c), e=graph.end(c); b!=e; b++)
+          if (region[*b] > region[c])
+            {
+              separator = true;
+              break;
+            }
+
+        if (separator)
+          {
+            sep_list.push_back(c);
+          }
+        else
+          {
+            std::vector<Index>& interior = reg[region[c]]->interior;
+            interior.push_back(c);
+            local[c] = Index(interior.size());
+          }
+      }
+
+    std::vector<Index> sep_pos(N+1, -1);
+    for (Index s=0; s<Index(sep_list.size()); s++) sep_pos[sep_list[s]] = s;
+
+    for (Index i=1; i<=observations; i++)
+      {
+        Index r = -1;
+        for (const Index* n=design_matrix->ibegin(i),
+               *e=design_matrix->iend(i); n!=e; n++)
+          if (local[*n])
+            {
+              r = region[*n];
+              break;
+            }
+
+        if (r < 0) sep_rows.push_back(i);
+        else       reg[r]->rows.push_back(i);
+      }
+
+    // regions without interior unknowns are not needed
+
+    reg.erase(std::remove_if(reg.begin(), reg.end(),
+                             [](const std::unique_ptr<Region>& p)
+                             { return p->interior.empty(); }), reg.end());
+
+    // region rows split into interior and separator columns
+
+    parallel_for(Index(0), Index(reg.size()), Index(1),
+                 [&](Index first, Index last)
+      {
+        for (Index t=first; t<last; t++)
+          {
+            Region& R = *reg[t];
+
+            std::size_t ni = 0, ns = 0;
+            for (Index i : R.rows)
+              for (const Index* n=design_matrix->ibegin(i),
+                     *e=design_matrix->iend(i); n!=e; n++)
+                if (local[*n])
+                  ni++;
+                else
+                  {
+                    ns++;
+                    R.sep.push_back(sep_pos[*n]);
+                  }
+
+            std::sort(R.sep.begin(), R.sep.end());
+            R.sep.erase(std::unique(R.sep.begin(), R.sep.end()), R.sep.end());
+
+            const Index nr = Index(R.rows.size());
+            R.Ai.reset(ni, nr, Index(R.interior.size()));
+            R.As.reset(ns, nr, Index(R.sep.size()));
+            for (Index i : R.rows)
+              {
+                R.Ai.new_row();
+                R.As.new_row();
+                const Float* b = design_matrix->begin (i);
+                const Float* e = design_matrix->end   (i);
+                const Index* n = design_matrix->ibegin(i);
+                for (; b!=e; b++, n++)
+                  if (local[*n])
+                    R.Ai.add_element(*b, local[*n]);
+                  else
+                    {
+                      auto s = std::lower_bound(R.sep.begin(), R.sep.end(),
+                                                sep_pos[*n]);
+                      R.As.add_element(*b, Index(s - R.sep.begin()) + 1);
+                    }
+              }
+          }
+      });
+  }
+
+
+  /* Interior normal equations N_ii = Ai'Ai are factorized in the
+   * envelope of their own reverse Cuthill-McKee ordering and the Schur
+   * complement As'As - W'inv(N_ii)W, W = Ai'As, is computed for the
+   * separators of the region. */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::factorize_region(Region& R)
+  {
+    const Index ni = Index(R.interior.size());
+    const Index ns = Index(R.sep.size());
+    const Index nr = Index(R.rows.size());
+
+    if (nr == 0) return;       // unknowns without observations
+    {
+      SparseMatrixGraph<Float, Index> graph(&R.Ai);
+      R.ordering.reset(&graph);
+      R.chol.set(&R.Ai, &graph, &R.ordering);
+    }
+    R.chol.cholDec();
+    if (R.chol.defect()) return;
+    R.regular = true;
+
+    R.schur.reset(ns, ns);
+    R.schur.set_zero();
+    if (ns == 0) return;
+
+    Mat<Float, Index, Exc> W(ns, ni);
+    W.set_zero();
+    for (Index i=1; i<=nr; i++)
+      for (const Float* s=R.As.begin(i), *e=R.As.end(i); s!=e; s++)
+        {
+          const Index a = R.As.ibegin(i)[s - R.As.begin(i)];
+          const Index* n = R.Ai.ibegin(i);
+          for (const Float* b=R.Ai.begin(i), *f=R.Ai.end(i); b!=f; b++, n++)
+            W(a, *n) += *s * *b;
+
+          const Index* m = R.As.ibegin(i);
+          for (const Float* b=R.As.begin(i); b!=e; b++, m++)
+            R.schur(a, *m) += *s * *b;
+        }
+
+    V w(ni), t(ni);
+    for (Index b=1; b<=ns; b++)
+      {
+        for (Index c=1; c<=ni; c++) w(c) = W(b,c);
+        R.solve(w, t);
+        for (Index a=1; a<=ns; a++)
+          {
+            Float s = Float();
+            for (Index c=1; c<=ni; c++) s += W(a,c)*w(c);
+            R.schur(a,b) -= s;
+          }
+      }
+  }
+
+
+  /* Dense L*D*L' decomposition of reduced normal equations of
+   * separators, a pivot is rejected when it is smaller than sqrt(eps)
+   * relative to its diagonal element of reduced normal equations */
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjHelmert<Float, Index, Exc>::factorize_separators()
+  {
+    const Index ns = Index(sep_list.size());
+    const Float tol = std::sqrt( std::numeric_limits<Float>::epsilon() );
+
+    for (Index j=1; j<=ns; j++)
+      {
+        const Float diag = std::abs(S(j,j));
+        Float d = S(j,j);
+        for (Index k=1; k<j; k++) d -= S(j,k)*S(j,k)*S(k,k);
+        if (!(std::abs(d) > tol*diag)) return false;
+        S(j,j) = d;
+
+        parallel_for(j+1, ns+1, Index(64), [&](Index first, Index last)
+          {
+            for (Index i=first; i<last; i++)
+              {
+                Float s = S(i,j);
+                for (Index k=1; k<j; k++) s -= S(i,k)*S(j,k)*S(k,k);
+                S(i,j) = s/d;
+              }
+          });
+      }
+
+    return true;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::solve_blocks()
+  {
+    if (this->stage >= stage_blocks) return;
+
+    hom.reset(this->input);
+    design_matrix = hom.mat();
+
+    const Index N = parameters;
+    Index k = regions_;
+    if (k <= 0)
+      {
+        k = Index(std::sqrt(double(N))/8);
+        k = std::max(Index(2), std::min(Index(64), k));
+      }
+    k = std::max(Index(1), std::min(k, N/4));
+
+    partition(k);
+
+    std::vector<std::function<void()>> tasks;
+    for (auto& R : reg)
+      {
+        Region* r = R.get();
+        tasks.emplace_back([this, r]() { factorize_region(*r); });
+      }
+    parallel_run(tasks);
+
+    bool regular = std::all_of(reg.begin(), reg.end(),
+                               [](const std::unique_ptr<Region>& r)
+                               { return r->regular; });
+
+    // reduced normal equations of separators
+
+    const Index ns = Index(sep_list.size());
+    if (regular)
+      {
+        std::vector<Index> sep_pos(N+1, 0);
+        for (Index s=0; s<ns; s++) sep_pos[sep_list[s]] = s+1;
+
+        S.reset(ns, ns);
+        S.set_zero();
+        for (Index i : sep_rows)
+          {
+            const Float* b = design_matrix->begin (i);
+            const Float* e = design_matrix->end   (i);
+            const Index* n = design_matrix->ibegin(i);
+            for (; b!=e; b++, n++)
+              {
+                const Index* m = design_matrix->ibegin(i);
+                for (const Float* c=design_matrix->begin(i); c!=e; c++, m++)
+                  S(sep_pos[*n], sep_pos[*m]) += *b * *c;
+              }
+          }
+
+        for (auto& R : reg)
+          {
+            const Index nrs = Index(R->sep.size());
+            for (Index a=1; a<=nrs; a++)
+              for (Index b=1; b<=nrs; b++)
+                S(R->sep[a-1]+1, R->sep[b-1]+1) += R->schur(a,b);
+            R->schur.reset();
+          }
+
+        regular = factorize_separators();
+      }
+
+    if (!regular) singular();
+
+    set_stage(stage_blocks);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::singular()
+  {
+    reg.clear();
+    S.reset();
+
+    envelope_ = std::make_unique<AdjEnvelope<Float, Index, Exc>>();
+    envelope_->reset(this->input);
+    if (min_x_set)
+      envelope_->min_x(Index(min_x_list.size()), min_x_list.data());
+  }
+
+
+  /* Solution of normal equations N*x = g by forward reduction of
+   * region interiors, solution of separators and back substitution */
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::block_solve(V& g, bool parallel) const
+  {
+    const Index ns = Index(sep_list.size());
+    const Index nreg = Index(reg.size());
+
+    V gs(ns);
+    for (Index s=1; s<=ns; s++) gs(s) = g(sep_list[s-1]);
+
+    auto run = [&](std::function<void(Index)> body)
+      {
+        if (parallel && nreg > 1)
+          {
+            std::vector<std::function<void()>> tasks;
+            for (Index r=0; r<nreg; r++)
+              tasks.emplace_back([&body, r]() { body(r); });
+            parallel_run(tasks);
+          }
+        else
+          for (Index r=0; r<nreg; r++) body(r);
+      };
+
+    // gs -= As'Ai inv(N_ii) gi
+
+    std::vector<V> contrib(nreg);
+    run([&](Index r)
+      {
+        const Region& R = *reg[r];
+        const Index ni = Index(R.interior.size());
+        const Index nr = Index(R.rows.size());
+
+        V y(ni), t(ni);
+        for (Index c=1; c<=ni; c++) y(c) = g(R.interior[c-1]);
+        R.solve(y, t);
+
+        V& u = contrib[r];
+        u.reset(Index(R.sep.size()));
+        u.set_zero();
+        for (Index i=1; i<=nr; i++)
+          {
+            Float s = Float();
+            const Index* n = R.Ai.ibegin(i);
+            for (const Float* b=R.Ai.begin(i), *e=R.Ai.end(i); b!=e; b++)
+              s += *b * y(*n++);
+
+            const Index* m = R.As.ibegin(i);
+            for (const Float* b=R.As.begin(i), *e=R.As.end(i); b!=e; b++)
+              u(*m++) += *b * s;
+          }
+      });
+
+    for (Index r=0; r<nreg; r++)
+      for (Index a=1; a<=Index(reg[r]->sep.size()); a++)
+        gs(reg[r]->sep[a-1]+1) -= contrib[r](a);
+
+    // separators
+
+    for (Index i=1; i<=ns; i++)
+      {
+        Float s = gs(i);
+        for (Index k=1; k<i; k++) s -= S(i,k)*gs(k);
+        gs(i) = s;
+      }
+    for (Index i=1; i<=ns; i++) gs(i) /= S(i,i);
+    for (Index i=ns; i>=1; i--)
+      {
+        Float s = gs(i);
+        for (Index k=i+1; k<=ns; k++) s -= S(k,i)*gs(k);
+        gs(i) = s;
+      }
+
+    // back substitution xi = inv(N_ii)(gi - Ai'As xs)
+
+    run([&](Index r)
+      {
+        const Region& R = *reg[r];
+        const Index ni = Index(R.interior.size());
+        const Index nr = Index(R.rows.size());
+
+        V y(ni), t(ni);
+        for (Index c=1; c<=ni; c++) y(c) = g(R.interior[c-1]);
+        for (Index i=1; i<=nr; i++)
+          {
+            Float s = Float();
+            const Index* m = R.As.ibegin(i);
+            for (const Float* b=R.As.begin(i), *e=R.As.end(i); b!=e; b++)
+              s += *b * gs(R.sep[*m++ - 1] + 1);
+
+            const Index* n = R.Ai.ibegin(i);
+            for (const Float* b=R.Ai.begin(i), *e=R.Ai.end(i); b!=e; b++)
+              y(*n++) -= *b * s;
+          }
+        R.solve(y, t);
+
+        for (Index c=1; c<=ni; c++) g(R.interior[c-1]) = y(c);
+      });
+
+    for (Index s=1; s<=ns; s++) g(sep_list[s-1]) = gs(s);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::solve_x()
+  {
+    if (this->stage >= stage_x) return;
+    solve_blocks();
+
+    if (envelope_)
+      {
+        x = envelope_->unknowns();
+        resid = envelope_->residuals();
+        squares = envelope_->sum_of_squares();
+
+        set_stage(stage_x);
+        return;
+      }
+
+    // absolute terms of normal equations
+
+    const Vec<Float>& rhs = hom.rhs();
+    x.reset(parameters);
+    x.set_zero();
+    for (Index i=1; i<=design_matrix->rows(); i++)
+      {
+        const Index* n = design_matrix->ibegin(i);
+        for (const Float* b=design_matrix->begin(i),
+               *e=design_matrix->end(i); b!=e; b++)
+          x(*n++) += *b * rhs(i);
+      }
+
+    block_solve(x, true);
+
+    // sum of squares of weighted residuals
+
+    squares = 0;
+    for (Index i=1; i<=design_matrix->rows(); i++)
+      {
+        Float s = Float();
+        const Index* n = design_matrix->ibegin(i);
+        for (const Float* b=design_matrix->begin(i),
+               *e=design_matrix->end(i); b!=e; b++)
+          s += *b * x(*n++);
+
+        const Float t = s - rhs(i);
+        squares += t*t;
+      }
+
+    // residuals = Ax - rhs
+
+    const SparseMatrix<Float, Index>* mat = this->input->mat();
+    const Vec<>& inp = this->input->rhs();
+    resid.reset(inp.dim());
+    for (Index i=1; i<=inp.dim(); i++)
+      {
+        Float s = Float();
+        const Index* n = mat->ibegin(i);
+        for (const Float* b=mat->begin(i), *e=mat->end(i); b!=e; b++)
+          s += *b * x(*n++);
+
+        resid(i) = s - inp(i);
+      }
+
+    set_stage(stage_x);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  const GNU_gama::Vec<Float, Index, Exc>&
+  AdjHelmert<Float, Index, Exc>::unknowns()
+  {
+    solve_x();
+
+    return x;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  const GNU_gama::Vec<Float, Index, Exc>&
+  AdjHelmert<Float, Index, Exc>::residuals()
+  {
+    solve_x();
+
+    return resid;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjHelmert<Float, Index, Exc>::sum_of_squares()
+  {
+    solve_x();
+
+    return squares;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Index AdjHelmert<Float, Index, Exc>::defect()
+  {
+    solve_blocks();
+    if (envelope_) return envelope_->defect();
+
+    return 0;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjHelmert<Float, Index, Exc>::q_xx(Index i, Index j)
+  {
+    solve_x();
+    if (envelope_) return envelope_->q_xx(i, j);
+
+    return q0_xx(i, j);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjHelmert<Float, Index, Exc>::q0_xx(Index i, Index j)
+  {
+    solve_x();
+    if (envelope_) return envelope_->q0_xx(i, j);
+
+    // columns of the inverse are solved serially, q0_xx() can be
+    // called from parallel loops
+
+    std::lock_guard<std::mutex> lock(qxx_mutex);
+
+    if (i < j) std::swap(i, j);
+    std::pair<Index,bool> pa = indbuf.get(i);
+
+    Vec<Float, Index, Exc>& a = qxxbuf[pa.first];
+    if (!pa.second)
+      {
+        a.reset(parameters);
+        a.set_zero();
+        a(i) = 1;
+        block_solve(a, false);
+      }
+
+    return a(j);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjHelmert<Float, Index, Exc>::q_bb(Index i, Index j)
+  {
+    solve_x();
+    if (envelope_) return envelope_->q_bb(i, j);
+
+    Vec<Float, Index, Exc> tmp(parameters);
+    tmp.set_zero();
+    const Float* b = design_matrix->begin (j);
+    const Float* e = design_matrix->end   (j);
+    const Index* n = design_matrix->ibegin(j);
+    while (b != e)
+      {
+        tmp(*n++) = *b++;
+      }
+
+    block_solve(tmp, false);
+
+    b = design_matrix->begin (i);
+    e = design_matrix->end   (i);
+    n = design_matrix->ibegin(i);
+    Float s = Float();
+    while (b != e)
+      {
+        s += *b++ * tmp(*n++);
+      }
+
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjHelmert<Float, Index, Exc>::q_bx(Index, Index)
+  {
+    throw Exc(Exception::BadRegularization,
+              "q_bx not implemented");
+    return 0;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjHelmert<Float, Index, Exc>::lindep(Index i)
+  {
+    solve_blocks();
+    if (envelope_) return envelope_->lindep(i);
+
+    return false;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::min_x()
+  {
+    min_x_list.clear();
+    min_x_set = false;
+
+    if (envelope_)
+      {
+        envelope_->min_x();
+        if (this->stage >= stage_x) this->stage = stage_blocks;
+      }
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::min_x(Index n, Index m[])
+  {
+    min_x_list.assign(m, m+n);
+    min_x_set = true;
+
+    if (envelope_)
+      {
+        envelope_->min_x(n, m);
+        if (this->stage >= stage_x) this->stage = stage_blocks;
+      }
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjHelmert<Float, Index, Exc>::null_space_basis(Mat<Float,Index,Exc>& G)
+  {
+    solve_x();
+    if (envelope_) return envelope_->null_space_basis(G);
+
+    G.reset(this->input->mat()->columns(), 0);     // regular system
+    return true;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::q_xx_batch(Mat<Float,Index,Exc>& B)
+  {
+    solve_x();
+    if (envelope_) return envelope_->q_xx_batch(B);
+
+    parallel_for(Index(1), B.cols()+1, Index(8), [&](Index first, Index last)
+      {
+        Vec<Float, Index, Exc> tmp(parameters);
+        for (Index c=first; c<last; c++)
+          {
+            for (Index i=1; i<=parameters; i++) tmp(i) = B(i,c);
+            block_solve(tmp, false);
+            for (Index i=1; i<=parameters; i++) B(i,c) = tmp(i);
+          }
+      });
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjHelmert<Float, Index, Exc>::solve()
+  {
+    solve_x();
+  }
+
+}  // namespace GNU_gama
+
+#endif
@@ -0,0 +1,378 @@
+/*
+  GNU Gama -- adjustment of geodetic networks
+  Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_Gama_gnu_gama_adj_sequential_gnugamaadjsequential_adj_sequential_h
+#define GNU_Gama_gnu_gama_adj_sequential_gnugamaadjsequential_adj_sequential_h
+
+#include <gnu_gama/exception.h>
+#include <gnu_gama/adj/adj_basefull.h>
+#include <matvec/symmat.h>
+#include <vector>
+
+namespace GNU_gama {
+
+
+  /** \brief Sequential (Kalman) update of prior information.
+   *
+   * Project equations A*x = b + v are homogenized (unit weights).
+   * Some unknowns x_p have prior information, i.e. their expected
+   * values and cofactor matrix Q from the previous epoch, all other
+   * unknowns x_n (new points, orientations) are determined only by
+   * the observations. The solution is equivalent to the adjustment of
+   * observations together with the prior values as correlated
+   * pseudo-observations, but the normal equations are never formed.
+   *
+   * With G = A_p*Q and S = I + G*A_p' (dimension is the number of
+   * observations of the epoch) the gain is K = G'*inv(S) and
+   *
+   *    M   = A_n'*inv(S)*A_n,     x_n = inv(M)*A_n'*inv(S)*b
+   *    x_p = K*(b - A_n*x_n)
+   *    Qpp = Q - K*G + K*A_n*inv(M)*A_n'*K'
+   *    Qpn = -K*A_n*inv(M),       Qnn = inv(M)
+   *
+   * The cost is proportional to the number of observations times the
+   * square of the number of unknowns, the prior cofactor matrix can be
+   * singular (free network). Prior cofactors and their update are
+   * dense, the design matrix is taken from the dense matrix of
+   * AdjBaseFull and only its nonzero elements are used.
+   * Regularization parameters min_x() are not used, the datum is
+   * given by the prior information.
+   */
+
+  template <typename Float=double,  typename Index=int,
+            typename Exc=Exception::matvec>
+  class AdjSequential : public AdjBaseFull<Float, Index, Exc>
+  {
+  public:
+
+    AdjSequential() = default;
+    ~AdjSequential() override = default;
+
+    AdjSequential(const AdjSequential&) = delete;
+    AdjSequential& operator=(const AdjSequential&) = delete;
+    AdjSequential(const AdjSequential&&) = delete;
+    AdjSequential& operator=(const AdjSequential&&) = delete;
+
+    /** prior expected values and cofactors of unknowns ind[k] */
+    void set_prior(const std::vector<Index>& ind,
+                   const Vec<Float, Index, Exc>& mean,
+                   const SymMat<Float, Index, Exc>& cofactors)
+    {
+      pind = ind;
+      pmean = mean;
+      pcof = cofactors;
+      this->is_solved = false;
+    }
+
+    /** number of unknowns with prior information */
+    Index prior_dim() const { return Index(pind.size()); }
+
+    Float sum_of_squares() override;
+    Index defect  () override { return 0; }
+    Float q_xx    (Index, Index) override;
+    Float q_bb    (Index, Index) override;
+    Float q_bx    (Index, Index) override;
+    bool  lindep  (Index) override;
+    void  min_x   () override {}
+    void  min_x   (Index, Index[]) override {}
+    void  solve   () override;
+
+  private:
+
+    std::vector<Index>        pind;     // unknowns with prior information
+    Vec   <Float, Index, Exc> pmean;
+    SymMat<Float, Index, Exc> pcof;
+
+    SymMat<Float, Index, Exc> Qxx;
+    Float                     sum {0};
+    std::vector<bool>         dep;
+
+    // nonzero elements of A by rows
+    std::vector<Index> rptr, rcol;
+    std::vector<Float> rval;
+
+    Float row_dot(Index i, const Vec<Float, Index, Exc>& x) const
+    {
+      Float s = 0;
+      for (Index k=rptr[i-1]; k<rptr[i]; k++) s += rval[k]*x(rcol[k]);
+      return s;
+    }
+  };
+
+
+  // ---  Implementation  ------------------------------------------------
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSequential<Float, Index, Exc>::sum_of_squares()
+  {
+    if (!this->is_solved) solve();
+    return sum;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSequential<Float, Index, Exc>::q_xx(Index i, Index j)
+  {
+    if (!this->is_solved) solve();
+    return Qxx(i,j);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSequential<Float, Index, Exc>::q_bx(Index i, Index j)
+  {
+    if (!this->is_solved) solve();
+
+    Float s = 0;
+    for (Index k=rptr[i-1]; k<rptr[i]; k++) s += rval[k]*Qxx(rcol[k], j);
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float AdjSequential<Float, Index, Exc>::q_bb(Index i, Index j)
+  {
+    if (!this->is_solved) solve();
+
+    Float s = 0;
+    for (Index k=rptr[j-1]; k<rptr[j]; k++) s += q_bx(i, rcol[k])*rval[k];
+    return s;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjSequential<Float, Index, Exc>::lindep(Index i)
+  {
+    return i >= 1 && i < Index(dep.size()) && dep[i];
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void AdjSequential<Float, Index, Exc>::solve()
+  {
+    if (this->is_solved) return;
+
+    const Mat<Float, Index, Exc>& A = *this->pA;
+    const Vec<Float, Index, Exc>& b = *this->pb;
+    const Index M  = A.rows();
+    const Index N  = A.cols();
+    const Index np = prior_dim();
+
+    // prior position of unknowns (1..np) or position among new unknowns
+
+    std::vector<Index> ppos(N+1, 0), npos(N+1, 0), nind;
+    for (Index k=0; k<np; k++) ppos[pind[k]] = k+1;
+    for (Index j=1; j<=N; j++)
+      if (ppos[j] == 0)
+        {
+          nind.push_back(j);
+          npos[j] = Index(nind.size());
+        }
+    const Index nn = Index(nind.size());
+
+    rptr.assign(1, 0);
+    rcol.clear();
+    rval.clear();
+    for (Index i=1; i<=M; i++)
+      {
+        for (Index j=1; j<=N; j++)
+          if (const Float a = A(i,j))
+            {
+              rcol.push_back(j);
+              rval.push_back(a);
+            }
+        rptr.push_back(Index(rcol.size()));
+      }
+
+    // right-hand side reduced by prior expected values
+
+    Vec<Float, Index, Exc> bp(M);
+    for (Index i=1; i<=M; i++)
+      {
+        Float s = b(i);
+        for (Index k=rptr[i-1]; k<rptr[i]; k++)
+          if (const Index p = ppos[rcol[k]]) s -= rval[k]*pmean(p);
+        bp(i) = s;
+      }
+
+    // G = A_p*Q,  S = I + G*A_p'
+
+    Mat<Float, Index, Exc> G(M, np);
+    G.set_zero();
+    for (Index i=1; i<=M; i++)
+      for (Index k=rptr[i-1]; k<rptr[i]; k++)
+        if (const Index p = ppos[rcol[k]])
+          {
+            const Float a = rval[k];
+            for (Index l=1; l<=np; l++) G(i,l) += a*pcof(p,l);
+          }
+
+    SymMat<Float, Index, Exc> S(M);
+    for (Index i=1; i<=M; i++)
+      for (Index j=1; j<=i; j++)
+        {
+          Float s = (i == j) ? Float(1) : Float(0);
+          for (Index k=rptr[j-1]; k<rptr[j]; k++)
+            if (const Index p = ppos[rcol[k]]) s += G(i,p)*rval[k];
+          S(i,j) = s;
+        }
+    S.cholDec();
+
+    Vec<Float, Index, Exc> t(M);
+    auto solveS = [&](Mat<Float, Index, Exc>& X, Index c)
+      {
+        for (Index i=1; i<=M; i++) t(i) = X(i,c);
+        S.solve(t);
+        for (Index i=1; i<=M; i++) X(i,c) = t(i);
+      };
+
+    // W = inv(S)*A_n,  normal equations of new unknowns  M = A_n'*W
+
+    Mat<Float, Index, Exc> W(M, nn);
+    W.set_zero();
+    for (Index i=1; i<=M; i++)
+      for (Index k=rptr[i-1]; k<rptr[i]; k++)
+        if (const Index q = npos[rcol[k]]) W(i,q) = rval[k];
+    for (Index q=1; q<=nn; q++) solveS(W, q);
+
+    SymMat<Float, Index, Exc> Mn(nn);
+    Mn.set_zero();
+    for (Index i=1; i<=M; i++)
+      for (Index k=rptr[i-1]; k<rptr[i]; k++)
+        if (const Index q = npos[rcol[k]])
+          {
+            const Float a = rval[k];
+            for (Index l=1; l<=q; l++) Mn(q,l) += a*W(i,l);
+          }
+
+    dep.assign(N+1, false);
+    Vec<Float, Index, Exc> xn(nn);
+    if (nn)
+      {
+        Mn.cholDec();
+        if (Mn.nullity())
+          {
+            for (Index q=1; q<=nn; q++)
+              if (Mn(q,q) == 0) dep[nind[q-1]] = true;
+
+            throw Exc(Exception::BadRegularization,
+                      "AdjSequential::solve() - unknowns determined "
+                      "neither by observations nor by prior information");
+          }
+
+        for (Index q=1; q<=nn; q++)
+          {
+            Float s = 0;
+            for (Index i=1; i<=M; i++) s += W(i,q)*bp(i);
+            xn(q) = s;
+          }
+        Mn.solve(xn);
+      }
+
+    // x_p = K*d,  d = b - A_n*x_n,  sum of squares = d'*inv(S)*d
+
+    Vec<Float, Index, Exc> d(M);
+    for (Index i=1; i<=M; i++)
+      {
+        Float s = bp(i);
+        for (Index k=rptr[i-1]; k<rptr[i]; k++)
+          if (const Index q = npos[rcol[k]]) s -= rval[k]*xn(q);
+        d(i) = s;
+      }
+    t = d;
+    S.solve(t);
+    sum = 0;
+    for (Index i=1; i<=M; i++) sum += d(i)*t(i);
+
+    this->x.reset(N);
+    for (Index l=1; l<=np; l++)
+      {
+        Float s = 0;
+        for (Index i=1; i<=M; i++) s += G(i,l)*t(i);
+        this->x(pind[l-1]) = s + pmean(l);
+      }
+    for (Index q=1; q<=nn; q++) this->x(nind[q-1]) = xn(q);
+
+    this->r.reset(M);
+    for (Index i=1; i<=M; i++) this->r(i) = row_dot(i, this->x) - b(i);
+
+    // cofactors
+
+    Mat<Float, Index, Exc> H = G;        // inv(S)*G
+    for (Index l=1; l<=np; l++) solveS(H, l);
+
+    Qxx.reset(N);
+    for (Index k=1; k<=np; k++)
+      for (Index l=1; l<=k; l++)
+        {
+          Float s = pcof(k,l);
+          for (Index i=1; i<=M; i++) s -= G(i,k)*H(i,l);
+          Qxx(pind[k-1], pind[l-1]) = s;
+        }
+
+    if (nn)
+      {
+        SymMat<Float, Index, Exc> Minv(nn);
+        Vec<Float, Index, Exc> e(nn);
+        for (Index q=1; q<=nn; q++)
+          {
+            e.set_zero();
+            e(q) = 1;
+            Mn.solve(e);
+            for (Index l=q; l<=nn; l++) Minv(l,q) = e(l);
+          }
+
+        Mat<Float, Index, Exc> T(np, nn), U(np, nn);  // T = G'*W, U = T*inv(M)
+        for (Index k=1; k<=np; k++)
+          for (Index q=1; q<=nn; q++)
+            {
+              Float s = 0;
+              for (Index i=1; i<=M; i++) s += G(i,k)*W(i,q);
+              T(k,q) = s;
+            }
+        for (Index k=1; k<=np; k++)
+          for (Index q=1; q<=nn; q++)
+            {
+              Float s = 0;
+              for (Index l=1; l<=nn; l++) s += T(k,l)*Minv(l,q);
+              U(k,q) = s;
+            }
+
+        for (Index k=1; k<=np; k++)
+          {
+            for (Index l=1; l<=k; l++)
+              {
+                Float s = 0;
+                for (Index q=1; q<=nn; q++) s += U(k,q)*T(l,q);
+                Qxx(pind[k-1], pind[l-1]) += s;
+              }
+            for (Index q=1; q<=nn; q++) Qxx(pind[k-1], nind[q-1]) = -U(k,q);
+          }
+
+        for (Index q=1; q<=nn; q++)
+          for (Index l=1; l<=q; l++) Qxx(nind[q-1], nind[l-1]) = Minv(q,l);
+      }
+
+    this->is_solved = true;
+  }
+
+}  // namespace GNU_gama
+
+#endif
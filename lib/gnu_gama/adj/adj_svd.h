@@ -22,6 +22,7 @@
 #define GNU_Gama_gnu_gama_gnu_gama_GaMa_OLS_svd_h
 
 #include <gnu_gama/adj/adj_basefull.h>
+#include <gnu_gama/parallel.h>
 #include <matvec/svd.h>
 #include <cmath>
 
@@ -33,10 +34,10 @@ namespace GNU_gama {
     SVD<Float, Index, Exc> svd;
 
   public:
-    AdjSVD() = default;
+    AdjSVD() { set_parallel(); }
     AdjSVD(const Mat<Float, Index, Exc>& A,
 	   const Vec<Float, Index, Exc>& b)
-      : AdjBaseFull<Float, Index, Exc>(A, b) {}
+      : AdjBaseFull<Float, Index, Exc>(A, b) { set_parallel(); }
 
     void reset(const Mat<Float, Index, Exc>& A,
                const Vec<Float, Index, Exc>& b) override
@@ -67,9 +68,22 @@ namespace GNU_gama {
     void min_x() override {  svd.min_x(); }
     void min_x(Index n, Index x[]) override { svd.min_x(n, x); }
 
+    bool null_space_basis(Mat<Float, Index, Exc>& G) override;
+
     Float cond() override;
     void solve() override;
 
+  private:
+
+    void set_parallel()
+    {
+      svd.set_parallel([](Index begin, Index end, Index grain,
+                          const std::function<void(Index, Index)>& f)
+                       {
+                         GNU_gama::parallel_for(begin, end, grain, f);
+                       });
+    }
+
   };
 
   // ...................................................................
@@ -91,6 +105,29 @@ namespace GNU_gama {
     this->is_solved = true;
   }
 
+  // columns of V corresponding to zero singular values
+
+  template <typename Float, typename Index, typename Exc>
+  bool AdjSVD<Float, Index, Exc>::null_space_basis(Mat<Float,Index,Exc>& G)
+  {
+    if (!this->is_solved) solve();
+
+    const Mat<Float, Index, Exc>& V = svd.SVD_V();
+    Index nullity = 0;
+    for (Index j=1; j<=V.cols(); j++)
+      if (svd.lindep(j)) nullity++;
+
+    G.reset(V.rows(), nullity);
+    for (Index k=0, j=1; j<=V.cols(); j++)
+      if (svd.lindep(j))
+        {
+          ++k;
+          for (Index i=1; i<=V.rows(); i++) G(i,k) = V(i,j);
+        }
+
+    return true;
+  }
+
   template <typename Float, typename Index, typename Exc>
   Float AdjSVD<Float, Index, Exc>::cond()
   {
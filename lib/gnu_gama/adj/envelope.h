@@ -24,6 +24,8 @@
 
 
 #include <limits>
+#include <memory>
+#include <gnu_gama/parallel.h>
 #include <gnu_gama/sparse/smatrix_graph.h>
 #include <gnu_gama/sparse/smatrix_ordering.h>
 #include <gnu_gama/sparse/sbdiagonal.h>
@@ -85,7 +87,13 @@ namespace GNU_gama {
     void set(const SparseMatrix         <Float, Index>* sm,
              const SparseMatrixGraph    <Float, Index>* graph,
              const SparseMatrixOrdering <Index>*        ordering);
+    void set(const SparseMatrix         <Float, Index>* sm,
+             const SparseMatrix         <Float, Index>* transposed_sm,
+             const SparseMatrixGraph    <Float, Index>* graph,
+             const SparseMatrixOrdering <Index>*        ordering);
     void set(const BlockDiagonal<Float, Index>& cov);
+    template <typename F>
+    void set(const Envelope<F, Index>& envelope);   // type conversion
     void set(const Float* b_diag, const Float* e_diag,
              const Float* b_env,  const Float* e_env,
              const Index* b_bend, const Index* e_bend);
@@ -168,6 +176,13 @@ namespace GNU_gama {
     }
 
     void copy(const Envelope&);
+
+    /* diagonal, row pointers and env_size off-diagonal elements are
+     * allocated for dimension dim_, sizes are checked for overflow */
+    void check_dim() const;
+    void allocate(std::size_t env_size);
+    static void add_size(std::size_t& env_size, std::size_t n);
+    static std::size_t mul_size(std::size_t a, std::size_t b);
   };
 
 
@@ -299,18 +314,18 @@ namespace GNU_gama {
     dim_ = cov.dim();
     if (dim_ == 0) return;
 
-
-    diag_ = new Float[dim_];
-    xenv_ = new Float*[dim_+2];    // 1 based indexes
-    Index env_size = 0;
+    std::size_t env_size = 0;
     for (Index block=1; block<=cov.blocks(); block++)
       {
-        const Index dim  = cov.dim  (block);
-        const Index band = cov.width(block);
+        const std::size_t dim  = cov.dim  (block);
+        const std::size_t band = cov.width(block);
 
-        env_size += (dim + -1 + dim - band)*band/2;
+        // (dim + dim - 1 - band)*band is even
+        const std::size_t a = dim + dim - 1 - band;
+        add_size(env_size, band % 2 ? mul_size(a/2, band)
+                                    : mul_size(a, band/2));
       }
-    if (env_size) env_ = new Float[env_size];
+    allocate(env_size);
 
 
     Float* d = diag_;
@@ -337,6 +352,48 @@ namespace GNU_gama {
   }
 
 
+  template <typename Float, typename Index>
+  void Envelope<Float, Index>::check_dim() const
+  {
+    bool negative = false;
+    if constexpr (std::numeric_limits<Index>::is_signed) negative = dim_ < 0;
+    if (negative || dim_ > std::numeric_limits<Index>::max() - 2)
+      throw GNU_gama::Exception::string("Envelope : dimension "
+                                        "exceeds the index range");
+  }
+
+
+  template <typename Float, typename Index>
+  void Envelope<Float, Index>::allocate(std::size_t env_size)
+  {
+    check_dim();
+
+    diag_ = new Float[dim_];
+    xenv_ = new Float*[dim_+2];    // 1 based indexes
+    if (env_size) env_ = new Float[env_size];
+  }
+
+
+  template <typename Float, typename Index>
+  void Envelope<Float, Index>::add_size(std::size_t& env_size, std::size_t n)
+  {
+    if (n > std::numeric_limits<std::size_t>::max() - env_size)
+      throw GNU_gama::Exception::string("Envelope : size of the envelope "
+                                        "exceeds the range of std::size_t");
+    env_size += n;
+  }
+
+
+  template <typename Float, typename Index>
+  std::size_t Envelope<Float, Index>::mul_size(std::size_t a, std::size_t b)
+  {
+    if (a && b > std::numeric_limits<std::size_t>::max()/a)
+      throw GNU_gama::Exception::string("Envelope : size of the envelope "
+                                        "exceeds the range of std::size_t");
+    return a*b;
+  }
+
+
   template <typename Float, typename Index>
   void Envelope<Float, Index>::write_xml(std::ostream& cout) const
   {
@@ -391,10 +448,8 @@ namespace GNU_gama {
     dim_ = envelope.dim();
     if (dim_ == 0) return;
 
-    diag_ = new Float[dim_];
-    xenv_ = new Float*[dim_+2];    // 1 based indexes
-    const Index env_size = envelope.xenv_[dim_+1] - envelope.xenv_[1];
-    if (env_size) env_ = new Float[env_size];
+    const std::size_t env_size = envelope.xenv_[dim_+1] - envelope.xenv_[1];
+    allocate(env_size);
 
     Float* t = env_;
     Float* d = diag_;
@@ -412,47 +467,69 @@ namespace GNU_gama {
 
     Float* e = env_;
     const Float* ce = envelope.env_;
-    for (Index i=1; i<=env_size; i++) *e++ = *ce++;
+    for (std::size_t i=0; i<env_size; i++) *e++ = *ce++;
+  }
+
+
+  template <typename Float, typename Index>
+  void Envelope<Float, Index>::set(const SparseMatrix<Float, Index>* sm,
+                                   const SparseMatrixGraph<Float, Index>* graph,
+                                   const SparseMatrixOrdering<Index>* ordering)
+  {
+    std::unique_ptr<SparseMatrix<Float, Index>> transposed(sm->transpose());
+    set(sm, transposed.get(), graph, ordering);
   }
 
 
   template <typename Float, typename Index>
   void Envelope<Float, Index>::set(const SparseMatrix<Float, Index>* sm,
+                                   const SparseMatrix<Float, Index>* smt,
                                    const SparseMatrixGraph<Float, Index>* graph,
                                    const SparseMatrixOrdering<Index>* ordering)
   {
     clear();
     dim_ = sm->columns();
     if (dim_ == 0) return;
-
-    diag_ = new Float[dim_];
-    xenv_ = new Float*[dim_+2];    // 1 based indexes
+    check_dim();
 
     Index* min_neighbour = new Index[dim_+1];
-    for (Index i=1; i<=dim_; i++) min_neighbour[i] = i;
-    for (Index node=1; node<=graph->nodes(); node++)
+    parallel_for(Index(1), dim_+1, Index(256), [&](Index first, Index last)
       {
-        // original number of the node
-        const Index i = ordering->perm(node);
-
-        // scan all neighbours
-        using const_iterator = typename SparseMatrixGraph<Float, Index>::const_iterator;
-        const_iterator b = graph->begin(i);
-        const_iterator e = graph->end(i);
-        while (b != e)
+        for (Index node=first; node<last; node++)
           {
-            const Index c = ordering->invp(*b++);
-            if (min_neighbour[node] > c)
-              min_neighbour[node] =  c;
+            min_neighbour[node] = node;
+
+            // original number of the node
+            const Index i = ordering->perm(node);
+
+            // scan all neighbours
+            using const_iterator =
+              typename SparseMatrixGraph<Float, Index>::const_iterator;
+            const_iterator b = graph->begin(i);
+            const_iterator e = graph->end(i);
+            while (b != e)
+              {
+                const Index c = ordering->invp(*b++);
+                if (min_neighbour[node] > c)
+                  min_neighbour[node] =  c;
+              }
           }
-      }
+      });
 
-    Index  env_size = 0;
+    std::size_t env_size = 0;     // may exceed the range of Index
     for (Index i=1; i<=dim_; i++)
       {
-        env_size +=  i - min_neighbour[i];
+        add_size(env_size, i - min_neighbour[i]);
+      }
+    try
+      {
+        allocate(env_size);
+      }
+    catch (...)
+      {
+        delete[] min_neighbour;
+        throw;
       }
-    if (env_size) env_ = new Float[env_size];
     Float* e = env_;
     for (Index i=1; i<=dim_; i++)
       {
@@ -463,49 +540,75 @@ namespace GNU_gama {
     delete[] min_neighbour;
 
 
-    for (Index i=0; i<dim_; i++) diag_[i] = 0;
-    for (Index i=0; i<env_size; i++) env_[i] = 0;
-
-    Float* a = new Float[dim_];  // nonzeroe row elements
-    Index* c = new Index[dim_];  //              indexes
+    /* Normal equations are assembled by envelope rows. The row of the
+     * unknown perm(row) collects products of its column in the design
+     * matrix with all rows where the column is nonzero, which are
+     * listed in the transposed design matrix smt. Rows are computed in
+     * parallel without write conflicts and each element is summed in
+     * the order of design matrix rows, as in the row-wise scattering
+     * of products. */
 
-    for (Index r=1; r<=sm->rows(); r++)
+    parallel_for(Index(1), dim_+1, Index(64), [&](Index first, Index last)
       {
-        Index count = 0;
-        Float* b = sm->begin(r);
-        Float* e = sm->end(r);
-        Index* n = sm->ibegin(r);
-        while (b != e)
+        for (Index row=first; row<last; row++)
           {
-            a[count] = *b++;
-            c[count] = ordering->invp(*n++);
-            count++;
+            Float* env = begin(row);
+            const Index start = row - Index(end(row) - env);
+            for (Float* p=env; p!=end(row); p++) *p = Float();
+
+            Float d = Float();
+            const Index col = ordering->perm(row);
+            const Float* tb = smt->begin (col);
+            const Float* te = smt->end   (col);
+            const Index* tr = smt->ibegin(col);
+            while (tb != te)
+              {
+                const Float  a = *tb++;
+                const Index  r = *tr++;
+                const Float* b = sm->begin (r);
+                const Float* e = sm->end   (r);
+                const Index* n = sm->ibegin(r);
+                while (b != e)
+                  {
+                    const Index c = ordering->invp(*n++);
+                    const Float f = *b++;
+                    if (c < row)
+                      env[c - start] += a*f;
+                    else if (c == row)
+                      d += a*a;
+                  }
+              }
+
+            diag_[row-1] = d;
           }
+      });
+  }
 
-        for (Index i=0; i<count; i++)
-          {
-            const Index ia = c[i];
-            const Float fa = a[i];
-            diag_[ia-1] += fa*fa;
+  template <typename Float, typename Index>
+  template <typename F>
+  void Envelope<Float, Index>::set(const Envelope<F, Index>& envelope)
+  {
+    clear();
+    dim_ = envelope.dim();
+    if (dim_ == 0) return;
 
-            for (Index j=i+1; j<count; j++)
-              {
-                const Index ib = c[j];
-                const Float fb = a[j];
+    const std::size_t env_size = envelope.end(dim_) - envelope.begin(1);
+    allocate(env_size);
 
-                const Index row = std::max(ia, ib);
-                const Index col = std::min(ia, ib);
+    Float* t = env_;
+    for (Index i=1; i<=dim_; i++)
+      {
+        diag_[i-1] = Float(envelope.diagonal(i));
 
-                Float* element = end(row) - (row - col);
-                *element += fa*fb;
-              }
-          }
+        xenv_[i] = t;
+        const F* b = envelope.begin(i);
+        const F* e = envelope.end(i);
+        while (b != e) *t++ = Float(*b++);
       }
-
-    delete[] a;
-    delete[] c;
+    xenv_[dim_+1] = t;
   }
 
+
   template <typename Float, typename Index>
   void Envelope<Float, Index>::set(const Float* b_diag, const Float* e_diag,
                                    const Float* b_env,  const Float* e_env,
@@ -515,11 +618,8 @@ namespace GNU_gama {
     dim_ = e_diag - b_diag;
     if (dim_ == 0) return;
 
-    diag_ = new Float[dim_];
-    xenv_ = new Float*[dim_+2];    // 1 based indexes
-
-    const Index env_size = e_env - b_env;
-    if (env_size) env_ = new Float[env_size];
+    const std::size_t env_size = e_env - b_env;
+    allocate(env_size);
 
     Float* t = env_;
     Float* d = diag_;
@@ -552,10 +652,8 @@ namespace GNU_gama {
     dim_ = chol.dim();
     if (dim_ == 0) return;
 
-    diag_ = new Float[dim_];
-    xenv_ = new Float*[dim_+2];
-    const Index env_size = chol.xenv_[dim_+1] - chol.xenv_[1];
-    if (env_size) env_ = new Float[env_size];
+    const std::size_t env_size = chol.xenv_[dim_+1] - chol.xenv_[1];
+    allocate(env_size);
 
     Float* t = env_;
     for (Index i=1; i<=dim_; i++)
@@ -25,8 +25,11 @@
 
 #include <gnu_gama/adj/adj.h>
 #include <gnu_gama/adj/envelope.h>
+#include <gnu_gama/parallel.h>
 #include <matvec/covmat.h>
-#include <set>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 
 namespace GNU_gama {
@@ -71,12 +74,25 @@ namespace GNU_gama {
     const AdjInputData* data {nullptr};
 
     using Sparse  = SparseMatrix<Float, Index>;
-    using Indices = std::set<Index>;
 
     Sparse*        sm;
     Vec<Float>     pr;   // right hand side
     bool        ready {false};
 
+    /* correlated block transformed to a dense matrix */
+
+    struct DenseBlock
+    {
+      std::vector<Index> invp;   // block columns in order of appearance
+      Mat<Float>         T;      // transformed block columns
+    };
+
+
+    /* Diagonal blocks are independent and are transformed in parallel
+     * in two passes. In the first pass the right-hand side is forward
+     * substituted, correlated blocks are transformed and nonzeros in all
+     * rows are counted. The second pass moves the results to their
+     * row offsets in the output sparse matrix. */
 
     void run()
     {
@@ -90,122 +106,127 @@ namespace GNU_gama {
       const BlockDiagonal<Float, Index>* bd = blockdiagonal;
 
       UpperBlockDiagonal<Float, Index> upper(bd);
-      const Sparse* mata           = data->mat();
-      Index total_scaled_nonzeroes = 0;
-
+      const Sparse* mata   = data->mat();
+      const Index   blocks = bd->blocks();
 
-      /* homogenized right-hand side */
-
-      pr = data->rhs();
-      for (Index n, row=1; row<=pr.dim(); row++)   // forward substitution
+      std::vector<Index> block_row(blocks+2);          // first block row
+      block_row[1] = 1;
+      for (Index block_index=1; block_index<=blocks; block_index++)
         {
-          const Float* b = upper.begin(row);
-          const Float* e = upper.end  (row);
-          const Float  x = pr(row) / *b++;
-          pr(row) = x;
-          n = row + 1;
-          while(b != e)
-            {
-              pr(n++) -= *b++ * x;
-            }
+          block_row[block_index+1] = block_row[block_index]
+                                   + bd->dim(block_index);
         }
 
+      pr = data->rhs();
+      std::vector<Index>      row_size(mata->rows()+1);  // 1 based indexing
+      std::vector<DenseBlock> dense(blocks+1);
 
-      /* counting total number of nonzeros in scaled sparse matrix */
 
-      std::vector<Index> block_cols(bd->blocks()+1);   // 1 based indexing
+      /* homogenized right-hand side, transformed correlated blocks and
+         number of nonzeros in scaled sparse matrix rows */
 
-      for (Index row=1, block_index=1; block_index<=bd->blocks(); block_index++)
+      auto transform = [&](Index first, Index last)
         {
-          const Index  block_dim   = bd->dim  (block_index);
-          const Index  block_width = bd->width(block_index);
-
-          if (block_width == 0)    // uncorrelated observations
+          for (Index block_index=first; block_index<last; block_index++)
             {
-              Index nonz = 0;
-              for (Index i=1; i<=block_dim; i++, row++)
+              const Index  block_dim   = bd->dim  (block_index);
+              const Index  block_width = bd->width(block_index);
+              const Index  row0        = block_row[block_index];
+              const Index  rowN        = row0 + block_dim;
+
+              for (Index n, row=row0; row<rowN; row++) // forward substitution
                 {
-                  nonz += /*static_cast<Index>*/(mata->end(row) - mata->begin(row));
+                  const Float* b = upper.begin(row);
+                  const Float* e = upper.end  (row);
+                  const Float  x = pr(row) / *b++;
+                  pr(row) = x;
+                  n = row + 1;
+                  while(b != e)
+                    {
+                      pr(n++) -= *b++ * x;
+                    }
                 }
-              total_scaled_nonzeroes += nonz;
-            }
-          else                     // correlated observations
-            {
-              Indices indices;
-              for (Index i=1; i<=block_dim; i++, row++)
+
+              if (block_width == 0)    // uncorrelated observations
                 {
-                  const Index* n = mata->ibegin(row);
-                  const Index* e = mata->iend  (row);
-                  while (n != e)
+                  for (Index row=row0; row<rowN; row++)
                     {
-                      indices.insert(*n++);
+                      row_size[row] = mata->size(row);
                     }
+                  continue;
                 }
-              block_cols[block_index] = static_cast<Index>(indices.size());
-              total_scaled_nonzeroes += block_dim*indices.size();
-            }
-        }
 
+              // correlated observations
 
-      sm = new Sparse(total_scaled_nonzeroes, mata->rows(), mata->columns());
+              std::vector<Index>& invp = dense[block_index].invp;
+              Mat<Float>&         T    = dense[block_index].T;
 
+              /* union of block columns as a sorted vector of pairs
+                 (column, order of appearance) */
 
-      /* assembling scaled sparse matrix */
+              std::vector<std::pair<Index, Index>> cols;
+              for (Index row=row0; row<rowN; row++)
+                {
+                  const Index* n = mata->ibegin(row);
+                  const Index* e = mata->iend  (row);
+                  while (n != e)
+                    {
+                      cols.emplace_back(*n++, Index(cols.size()));
+                    }
+                }
+              std::sort(cols.begin(), cols.end());
+              cols.erase(std::unique(cols.begin(), cols.end(),
+                                     [](const std::pair<Index, Index>& p,
+                                        const std::pair<Index, Index>& q)
+                                     {
+                                       return p.first == q.first;
+                                     }),
+                         cols.end());
+
+              const Index bcols = static_cast<Index>(cols.size());
+              std::vector<std::pair<Index, Index>> order(bcols);
+              for (Index i=0; i<bcols; i++)
+                {
+                  order[i] = std::make_pair(cols[i].second, i);
+                }
+              std::sort(order.begin(), order.end());
 
-      std::vector<Index> perm(mata->columns()+1);  // block index permutation
+              invp.resize(bcols+1);                // block inverse permutaion
+              for (Index j=1; j<=bcols; j++)
+                {
+                  std::pair<Index, Index>& col = cols[order[j-1].second];
+                  invp[j]    = col.first;
+                  col.second = j;                  // block column index
+                }
 
-      for (Index row=1, block_index=1; block_index<=bd->blocks(); block_index++)
-        {
-          const Float* block_b     = bd->begin(block_index);
-          const Index  block_dim   = bd->dim  (block_index);
-          const Index  block_width = bd->width(block_index);
-
-          if (block_width == 0)    // uncorrelated observations
-            for (Index i=1; i<=block_dim; i++, row++)
-              {
-                sm->new_row();
-                const Float  d = *block_b++;
-                const Index* n = mata->ibegin(row);
-                const Float* b = mata->begin (row);
-                const Float* e = mata->end   (row);
-                while (b != e)
-                  {
-                    sm->add_element(*b++/d, *n++);
-                  }
-              }
-          else                     // correlated observations
-            {
-              const Index bcols = block_cols[block_index];
-              std::vector<Index> invp(bcols+1);     // block inverse permutaion
-              Index invp_count = 0;
+              auto block_column = [&cols](Index c)
+                {
+                  return std::lower_bound(cols.begin(), cols.end(), c,
+                                          [](const std::pair<Index, Index>& p,
+                                             Index k) { return p.first < k; })
+                    ->second;
+                };
 
-              Mat<Float> T(block_dim, bcols);       // matrix of block columns
+              T.reset(block_dim, bcols);           // matrix of block columns
               T.set_zero();
 
               /* copy block sparse columns to T */
 
-              for (Index i=1; i<=block_dim; i++, row++)
+              for (Index i=1, row=row0; row<rowN; i++, row++)
                 {
                   const Float* b = mata->begin (row);
                   const Float* e = mata->end   (row);
                   const Index* n = mata->ibegin(row);
                   while (b != e)
                     {
-                      const Index c = *n++;
-                      if (perm[c] == 0)
-                        {
-                          perm[c] = ++invp_count;
-                          invp[invp_count] = c;
-                        }
-
-                      T(i, perm[c]) = *b++;
+                      T(i, block_column(*n++)) = *b++;
                     }
                 }
 
               /* forward substitution for T */
 
               for (Index c=1; c<=bcols; c++)
-                for (Index n, r=row-block_dim, i=1; i<=block_dim; i++, r++)
+                for (Index n, r=row0, i=1; i<=block_dim; i++, r++)
                   {
                     const Float* b = upper.begin(r);
                     const Float* e = upper.end  (r);
@@ -218,24 +239,81 @@ namespace GNU_gama {
                       }
                   }
 
-              /* move transformed T to ouput sparse matrix  */
-
-              for (Index i=1; i<=block_dim; i++)
+              for (Index i=1, row=row0; row<rowN; i++, row++)
                 {
-                  sm->new_row();
+                  Index nonz = 0;
                   for (Index j=1; j<=bcols; j++)
-                    if (const Float element = T(i,j))
-                      {
-                        sm->add_element(element, invp[j]);
-                      }
+                    if (T(i,j)) nonz++;
+                  row_size[row] = nonz;
                 }
+            }
+        };
+
+      parallel_for(Index(1), blocks+1, Index(16), transform);
+
+
+      /* offsets of rows in scaled sparse matrix */
+
+      std::size_t total_scaled_nonzeroes = 0;
+      for (Index row=1; row<=mata->rows(); row++)
+        {
+          total_scaled_nonzeroes += row_size[row];
+        }
+
+      sm = new Sparse(total_scaled_nonzeroes, mata->rows(), mata->columns());
+      sm->set_row_sizes(row_size.data());
 
-              for (Index i=1; i<=bcols; i++)      // clear permutation vector
+
+      /* assembling scaled sparse matrix */
+
+      auto fill = [&](Index first, Index last)
+        {
+          for (Index block_index=first; block_index<last; block_index++)
+            {
+              const Float* block_b     = bd->begin(block_index);
+              const Index  block_dim   = bd->dim  (block_index);
+              const Index  block_width = bd->width(block_index);
+              const Index  row0        = block_row[block_index];
+
+              if (block_width == 0)    // uncorrelated observations
+                for (Index row=row0; row<row0+block_dim; row++)
+                  {
+                    const Float  d = *block_b++;
+                    const Index* n = mata->ibegin(row);
+                    const Float* b = mata->begin (row);
+                    const Float* e = mata->end   (row);
+                    Float*       s = sm->begin (row);
+                    Index*       k = sm->ibegin(row);
+                    while (b != e)
+                      {
+                        *s++ = *b++/d;
+                        *k++ = *n++;
+                      }
+                  }
+              else                     // correlated observations
                 {
-                  perm[invp[i]] = 0;
+                  const std::vector<Index>& invp = dense[block_index].invp;
+                  Mat<Float>&               T    = dense[block_index].T;
+                  const Index               bcols = T.cols();
+
+                  for (Index i=1, row=row0; i<=block_dim; i++, row++)
+                    {
+                      Float* s = sm->begin (row);
+                      Index* k = sm->ibegin(row);
+                      for (Index j=1; j<=bcols; j++)
+                        if (const Float element = T(i,j))
+                          {
+                            *s++ = element;
+                            *k++ = invp[j];
+                          }
+                    }
+
+                  T.reset();
                 }
             }
-        }
+        };
+
+      parallel_for(Index(1), blocks+1, Index(16), fill);
 
       delete blockdiagonal;
       ready = true;
@@ -21,9 +21,11 @@
  */
 
 #include <gnu_gama/adj/icgs.h>
+#include <gnu_gama/parallel.h>
 #include <cmath>
 #include <memory>
 #include <algorithm>
+#include <vector>
 
 using namespace GNU_gama;
 
@@ -31,7 +33,6 @@ using namespace GNU_gama;
 ICGS::~ICGS()
 {
   if (internal_data) delete[] A;
-  delete[] p_ak;
   delete[] column;
   delete[] row;
 }
@@ -186,19 +187,83 @@ void ICGS::cscale2nd(double* column, double sc)
   while (column < cend) *column++ *= sc;
 }
 
-void ICGS::ccopy1st (double* from, double* to)
-{
-  double* from_end = from + M12;
-  while (from < from_end) *to++ = *from++;
-}
+/* Block version of iterated classical Gram-Schmidt (BCGS2)
+ *
+ * Columns are processed in panels of at most 'panel' columns. Each
+ * panel is first orthogonalized twice against all previous columns;
+ * these updates are independent for each panel column and run in
+ * parallel. The panel itself is then orthogonalized column by column
+ * with the original ICGS algorithm. For N12 <= panel there is only one
+ * panel and the result is identical with the unblocked algorithm.
+ */
 
-void ICGS::ccopy2nd (double* from, double* to)
+void ICGS::project1st(int q, int c0, int c1)
 {
-  from += M1;
-  to   += M1;
+  // orthogonalize columns c0, ..., c1-1 against columns 1, ..., q
+  //
+  // Dot products are computed for groups of up to four columns in a
+  // single pass over q_j and updates p -= q_j*r_jk are accumulated for
+  // four columns q_j at once. The order of floating point operations
+  // for each element is the same as in the unblocked algorithm.
+
+  const int G = 4;
+  std::vector<double> r((q+1)*G);
+
+  for (int g0=c0; g0<c1; g0+=G)
+    {
+      const int nc = std::min(G, c1-g0);
+      double* p[G];
+      for (int c=0; c<nc; c++) p[c] = column[g0+c];
 
-  double* from_end = from + M2;
-  while (from < from_end) *to++ = *from++;
+      for (int iter=1; iter<=2; iter++)
+        {
+          for (int j=1; j<=q; j++)
+            {
+              // r_jk := q^T_j p = <p,q_j>
+              const double* q_j = column[j];
+              double s[G] = {0, 0, 0, 0};
+              for (int i=0; i<M1; i++)
+                {
+                  const double t = q_j[i];
+                  for (int c=0; c<nc; c++) s[c] += p[c][i] * t;
+                }
+              for (int c=0; c<nc; c++) r[j*G + c] = s[c];
+            }
+
+          for (int c=0; c<nc; c++)
+            {
+              // p := = p - q_j*r_jk
+              double* pc = p[c];
+              int j = 1;
+              for (; j+3<=q; j+=4)
+                {
+                  const double* q1 = column[j];
+                  const double* q2 = column[j+1];
+                  const double* q3 = column[j+2];
+                  const double* q4 = column[j+3];
+                  const double  r1 = r[ j   *G + c];
+                  const double  r2 = r[(j+1)*G + c];
+                  const double  r3 = r[(j+2)*G + c];
+                  const double  r4 = r[(j+3)*G + c];
+                  for (int i=0; i<M12; i++)
+                    {
+                      double t = pc[i];
+                      t -= r1 * q1[i];
+                      t -= r2 * q2[i];
+                      t -= r3 * q3[i];
+                      t -= r4 * q4[i];
+                      pc[i] = t;
+                    }
+                }
+              for (; j<=q; j++)
+                {
+                  const double* q_j  = column[j];
+                  const double  r_jk = r[j*G + c];
+                  for (int i=0; i<M12; i++) pc[i] -= r_jk * q_j[i];
+                }
+            }
+        }
+    }
 }
 
 void ICGS::icgs1()
@@ -207,63 +272,96 @@ void ICGS::icgs1()
   icgs1_is_ready = false;
   error_icgs2_defect = 0;
 
-  if (p_ak) delete[] p_ak;
-  p_ak = new double[M12+1];
-  double* const p_end_M1  = p_ak + M1;
-  double* const p_end_M12 = p_ak + M12;
-
-  double* rjk = new double[N12+1];
+  std::vector<double> rjk(N12+1);
 
-  double r11 = norm1st(column[1]);
-  if (r11 > tolerance) cscale1st(column[1], 1/r11);
-  else
+  for (int k0=1; k0<=N12; k0+=panel_)
     {
-      lindep.insert(1);
-    }
+      const int k1 = std::min(k0 + panel_, N12 + 1);  // panel [k0, k1)
 
-  for (int k=2; k<=N12; k++)
-    {
-      ccopy1st(column[k], p_ak);
+      if (const int q = std::min(k0 - 1, N1))
+        {
+          parallel_for(k0, k1, 4, [this, q](int c0, int c1)
+                       {
+                         project1st(q, c0, c1);
+                       });
+        }
 
-      int jmax = k <= N1 ? k-1 : N1;
-      for (int iter=1; iter<=2; iter++)
+      for (int k=k0; k<k1; k++)
         {
-          for (int j=1; j<=jmax; j++)
-            {
-              // r_jk := q^T_j p = <p,q_j>
-              double* p = p_ak;
-              double* q_j  = column[j];
-              double  s = 0;
-              while (p != p_end_M1) s += *p++ * *q_j++;
-              rjk[j] = s;
-            }
-          for (int j=1; j<=jmax; j++)
+          double* const p_ak = column[k];
+          double* const p_end_M1  = p_ak + M1;
+          double* const p_end_M12 = p_ak + M12;
+
+          int jmax = k <= N1 ? k-1 : N1;
+          for (int iter=1; iter<=2 && k0<=jmax; iter++)
             {
-              // p := = p - q_j*r_jk
-              double* p = p_ak;
-              double* q = column[j];
-              double  r_jk = rjk[j];
-              while (p < p_end_M12) *p++ -= r_jk * *q++;
+              for (int j=k0; j<=jmax; j++)
+                {
+                  // r_jk := q^T_j p = <p,q_j>
+                  double* p = p_ak;
+                  double* q_j  = column[j];
+                  double  s = 0;
+                  while (p != p_end_M1) s += *p++ * *q_j++;
+                  rjk[j] = s;
+                }
+              for (int j=k0; j<=jmax; j++)
+                {
+                  // p := = p - q_j*r_jk
+                  double* p = p_ak;
+                  double* q = column[j];
+                  double  r_jk = rjk[j];
+                  while (p < p_end_M12) *p++ -= r_jk * *q++;
+                }
             }
-        }
 
-      if (k <= N1)
-        {
-          double rkk = norm1st(p_ak);
-          if (rkk > tolerance) cscale1st(p_ak, 1/rkk);
-          else
+          if (k <= N1)
             {
-              lindep.insert(k);
+              double rkk = norm1st(p_ak);
+              if (rkk > tolerance) cscale1st(p_ak, 1/rkk);
+              else
+                {
+                  lindep.insert(k);
+                }
             }
         }
-
-      ccopy1st(p_ak, column[k]);
     }
 
-  delete[] rjk;
   icgs1_is_ready = true;
 }
 
+void ICGS::project2nd(int k, std::vector<double>& rjk)
+{
+  // orthogonalize k-th column against the first min(k-1, defect)
+  // columns in the 2nd orthogonalization
+
+  double* const p_ak = column[k];
+  double* const p_end_M12 = p_ak + M12;
+
+  int jmax = k <= defect() ? k-1 : defect();
+  for (int iter=1; iter<=2; iter++)
+    {
+      for (int j=1; j<=jmax; j++)
+        {
+          // r_jk := q^T_j p = <p,q_j>
+          double* p = p_ak + M1 - 1;        // -1: 1-based indexing minx
+          double* q_j = column[j] + M1 - 1; // -1: 1-based undexing minx
+
+          double  s = 0;
+          // icgs1: while (p != p_end_M12) s += *p++ * *q_j++;
+          for (int i : minx) s += p[i]*q_j[i];
+          rjk[j] = s;
+        }
+      for (int j=1; j<=jmax; j++)
+        {
+          // p := = p - q_j*r_jk
+          double* p = p_ak + M1;
+          double* q = column[j] + M1;
+          double  r_jk = rjk[j];
+          while (p < p_end_M12) *p++ -= r_jk * *q++;
+        }
+    }
+}
+
 void ICGS::icgs2()
 {
     {
@@ -282,8 +380,7 @@ void ICGS::icgs2()
         }
     }
 
-  double* const p_end_M12 = p_ak + M12;
-  double* rjk = new double[N12+1];
+  std::vector<double> rjk(N12+1);
 
   double r11 = norm2nd(column[1]);
 
@@ -293,46 +390,27 @@ void ICGS::icgs2()
       error_icgs2_defect++;
     }
 
-  for (int k=2; k<=N12; k++)
+  for (int k=2; k<=defect(); k++)
     {
-      ccopy2nd(column[k], p_ak);
+      project2nd(k, rjk);
 
-      int jmax = k <= defect() ? k-1 : defect();
-      for (int iter=1; iter<=2; iter++)
-        {
-          for (int j=1; j<=jmax; j++)
-            {
-              // r_jk := q^T_j p = <p,q_j>
-              double* p = p_ak + M1 - 1;        // -1: 1-based indexing minx
-              double* q_j = column[j] + M1 - 1; // -1: 1-based undexing minx
-
-              double  s = 0;
-              // icgs1: while (p != p_end_M12) s += *p++ * *q_j++;
-              for (int i : minx) s += p[i]*q_j[i];
-              rjk[j] = s;
-            }
-          for (int j=1; j<=jmax; j++)
-            {
-              // p := = p - q_j*r_jk
-              double* p = p_ak + M1;
-              double* q = column[j] + M1;
-              double  r_jk = rjk[j];
-              while (p < p_end_M12) *p++ -= r_jk * *q++;
-            }
-        }
-
-      if (k <= defect())
+      double rkk = norm2nd(column[k]);
+      if (rkk > tolerance) cscale2nd(column[k], 1/rkk);
+      else
         {
-          double rkk = norm2nd(p_ak);
-          if (rkk > tolerance) cscale2nd(p_ak, 1/rkk);
-          else
-            {
-              error_icgs2_defect++;
-            }
+          error_icgs2_defect++;
         }
-      ccopy2nd(p_ak, column[k]);
     }
 
+  // remaining columns are orthogonalized only against the first
+  // defect() columns and are mutually independent
+
+  parallel_for(std::max(defect()+1, 2), N12+1, 16, [this](int c0, int c1)
+               {
+                 std::vector<double> r(defect()+1);
+                 for (int k=c0; k<c1; k++) project2nd(k, r);
+               });
+
   /* weight coefficients of adjusted unknowns are computed as dot products
    * of rows and elements of linearly dependent columns must be set to zero
    */
@@ -340,6 +418,4 @@ void ICGS::icgs2()
     {
       cscale2nd(column[i], 0);
     }
-
-  delete[] rjk;
 }
@@ -47,6 +47,7 @@
 #include <limits>
 #include <utility>
 #include <set>
+#include <vector>
 
 namespace GNU_gama {
 
@@ -88,6 +89,8 @@ public:
   void   blocks (int& m1, int& n1, int& m2, int& n2) const;
   double tol() const { return tolerance; };
   void   tol(double t) { tolerance = t; }
+  int    panel() const { return panel_; }    // block size in icgs1()
+  void   panel(int n)  { panel_ = n > 0 ? n : 1; }
 
   void min_x();
   void min_x(int, int[]);
@@ -101,14 +104,15 @@ private:
 
   double** column {nullptr};               // column pointers list
   double** row    {nullptr};               // row    pointers
-  double*  p_ak   {nullptr};               // column working space
+  int      panel_ {64};                    // columns in a block (panel)
 
   double tolerance { std::numeric_limits<double>::epsilon()*1e5 };
 
   void cscale1st(double* col, double sc);  // col *= sc
   void cscale2nd(double* col, double sc);
-  void ccopy1st (double* from, double* to);
-  void ccopy2nd (double* from, double* to);
+
+  void project1st(int q, int c0, int c1);
+  void project2nd(int k, std::vector<double>& rjk);
 
   std::set<int> lindep;
 
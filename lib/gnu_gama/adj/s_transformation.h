@@ -0,0 +1,233 @@
+/*
+  GNU Gama -- adjustment of geodetic networks
+  Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ library.
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_Gama_gnu_gama_adj_STransformation_h
+#define GNU_Gama_gnu_gama_adj_STransformation_h
+
+#include <gnu_gama/adj/adj_base.h>
+#include <matvec/symmat.h>
+#include <vector>
+
+namespace GNU_gama {
+
+  /** \brief S-transformation of a regularized solution to another datum.
+   *
+   * Unknowns x and cofactors Q of a singular system (free network)
+   * regularized on any subset of unknowns are transformed to the
+   * solution minimizing the norm of a new subset J
+   *
+   *     x_J = S*x,   Q_J = S*Q*S',   S = I - G*inv(G_J'*G)*G_J'
+   *
+   * where columns of G are the null space basis of the design matrix
+   * and G_J has zero rows outside J. S is identity matrix updated by
+   * a matrix of rank d (network defect), with K = G*inv(G_J'*G) and
+   * H = G_J'*Q the transformed cofactors are
+   *
+   *     Q_J = Q - K*H - H'*K' + K*(H*G_J)*K'
+   *
+   * and only rows J of the original Q are needed. The factorization
+   * of the adjustment is reused, no equations are solved again.
+   */
+
+  template <typename Float=double, typename Index=int,
+            typename Exc=Exception::matvec>
+  class STransformation {
+  public:
+
+    /** Transformation of the adjustment solution to the datum given
+     *  by n indexes of unknowns; false if null space basis is not
+     *  available in the adjustment class.
+     */
+    bool reset(AdjBase<Float, Index, Exc>* adj, Index n, const Index J[]);
+
+    const Vec<Float, Index, Exc>& unknowns() const { return x; }
+
+    Float q_xx(Index i, Index j) const;
+    Float q_bx(Index i, Index j) const;
+
+    /** Products Q_J*B for all columns of B (B is overwritten) */
+    void q_xx_batch(Mat<Float, Index, Exc>& B) const;
+
+  private:
+
+    AdjBase<Float, Index, Exc>* adj {nullptr};
+    Index                       nullity {0};
+    std::vector<Index>          datum;
+
+    Vec<Float, Index, Exc> x;       // transformed unknowns
+    Mat<Float, Index, Exc> G;       // null space basis
+    Mat<Float, Index, Exc> K;       // G*inv(G_J'*G)
+    Mat<Float, Index, Exc> H;       // G_J'*Q
+    Mat<Float, Index, Exc> F;       // G_J'*Q*G_J
+  };
+
+  // ---  Implementation  ------------------------------------------------
+
+  template <typename Float, typename Index, typename Exc>
+  bool STransformation<Float, Index, Exc>
+    ::reset(AdjBase<Float, Index, Exc>* a, Index n, const Index J[])
+  {
+    adj = a;
+    datum.assign(J, J+n);
+    x = adj->unknowns();
+    const Index N = x.dim();
+
+    nullity = adj->defect();
+    if (nullity == 0) return true;
+    if (!adj->null_space_basis(G) || G.cols() != nullity) return false;
+
+    // inv(G_J'*G)
+
+    SymMat<Float, Index, Exc> GJG(nullity);
+    for (Index r=1; r<=nullity; r++)
+      for (Index c=1; c<=r; c++)
+        {
+          Float s = Float();
+          for (Index k : datum) s += G(k,r)*G(k,c);
+          GJG(r,c) = s;
+        }
+    GJG.cholDec();
+    if (GJG.nullity())
+      throw Exc(Exception::BadRegularization,
+                "STransformation::reset() --- bad regularization");
+
+    K.reset(N, nullity);
+    Vec<Float, Index, Exc> row(nullity);
+    for (Index i=1; i<=N; i++)
+      {
+        for (Index c=1; c<=nullity; c++) row(c) = G(i,c);
+        GJG.solve(row);
+        for (Index c=1; c<=nullity; c++) K(i,c) = row(c);
+      }
+
+    // x_J = x - K*(G_J'*x)
+
+    Vec<Float, Index, Exc> gx(nullity);
+    for (Index c=1; c<=nullity; c++)
+      {
+        Float s = Float();
+        for (Index k : datum) s += G(k,c)*x(k);
+        gx(c) = s;
+      }
+    for (Index i=1; i<=N; i++)
+      for (Index c=1; c<=nullity; c++)
+        x(i) -= K(i,c)*gx(c);
+
+    // H = G_J'*Q and F = H*G_J, rows of Q are read sequentially
+
+    H.reset(nullity, N);
+    H.set_zero();
+    for (Index k : datum)
+      for (Index j=1; j<=N; j++)
+        {
+          const Float q = adj->q_xx(k, j);
+          for (Index c=1; c<=nullity; c++) H(c,j) += G(k,c)*q;
+        }
+
+    F.reset(nullity, nullity);
+    for (Index r=1; r<=nullity; r++)
+      for (Index c=1; c<=nullity; c++)
+        {
+          Float s = Float();
+          for (Index k : datum) s += H(r,k)*G(k,c);
+          F(r,c) = s;
+        }
+
+    return true;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float STransformation<Float, Index, Exc>::q_xx(Index i, Index j) const
+  {
+    Float q = adj->q_xx(i, j);
+    if (nullity == 0) return q;
+
+    for (Index c=1; c<=nullity; c++)
+      {
+        q -= K(i,c)*H(c,j) + K(j,c)*H(c,i);
+
+        Float s = Float();
+        for (Index e=1; e<=nullity; e++) s += F(c,e)*K(j,e);
+        q += K(i,c)*s;
+      }
+
+    return q;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  Float STransformation<Float, Index, Exc>::q_bx(Index i, Index j) const
+  {
+    Float q = adj->q_bx(i, j);
+    if (nullity == 0) return q;
+
+    for (Index c=1; c<=nullity; c++)
+      {
+        Float s = Float();
+        for (Index k : datum) s += G(k,c)*adj->q_bx(i, k);
+        q -= K(j,c)*s;
+      }
+
+    return q;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void STransformation<Float, Index, Exc>
+    ::q_xx_batch(Mat<Float, Index, Exc>& B) const
+  {
+    const Index N = B.rows();
+    Vec<Float, Index, Exc> t(nullity);
+
+    // S'*B = B - G_J*(K'*B)
+
+    for (Index c=1; c<=B.cols() && nullity; c++)
+      {
+        for (Index d=1; d<=nullity; d++)
+          {
+            Float s = Float();
+            for (Index i=1; i<=N; i++) s += K(i,d)*B(i,c);
+            t(d) = s;
+          }
+        for (Index k : datum)
+          for (Index d=1; d<=nullity; d++) B(k,c) -= G(k,d)*t(d);
+      }
+
+    adj->q_xx_batch(B);
+
+    // S*(Q*S'*B) = Q*S'*B - K*(G_J'*Q*S'*B)
+
+    for (Index c=1; c<=B.cols() && nullity; c++)
+      {
+        for (Index d=1; d<=nullity; d++)
+          {
+            Float s = Float();
+            for (Index k : datum) s += G(k,d)*B(k,c);
+            t(d) = s;
+          }
+        for (Index i=1; i<=N; i++)
+          for (Index d=1; d<=nullity; d++) B(i,c) -= K(i,d)*t(d);
+      }
+  }
+
+}  // namespace GNU_gama
+
+#endif
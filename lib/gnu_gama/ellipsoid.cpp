@@ -155,3 +155,79 @@ void Ellipsoid::xyz2blh(double  x, double  y, double  z,
   else
     h = z/sin(b) - Ime2*N(b);
 }
+
+
+void Ellipsoid::blh2xyz(std::size_t count, const double* pb, const double* pl,
+                        const double* ph, double* px, double* py, double* pz) const
+{
+  for (std::size_t i=0; i<count; i++)
+    {
+      const double h  = ph[i];
+      const double sb = sin(pb[i]);
+      const double cb = cos(pb[i]);
+      const double sl = sin(pl[i]);
+      const double cl = cos(pl[i]);
+      const double nn = A/sqrt(1 - e2*sb*sb);
+      const double n1 = nn*Ime2 + h;
+      const double nh = nn + h;
+
+      px[i] = nh*cb*cl;
+      py[i] = nh*cb*sl;
+      pz[i] = n1*sb;
+    }
+}
+
+void Ellipsoid::xyz2blh(std::size_t count, const double* px, const double* py,
+                        const double* pz, double* pb, double* pl, double* ph) const
+{
+  /* Bowring's method with one iteration as in the scalar xyz2blh().
+   * Sine and cosine of the reduced latitude and of the first latitude
+   * approximation are computed algebraically from the tangent, only
+   * the final latitude and longitude need atan2. The loop body is
+   * free of branches except for points on the polar axis.
+   */
+
+  const double e22B = e22*B;
+  const double e2A  = e2*A;
+
+  for (std::size_t i=0; i<count; i++)
+    {
+      const double x = px[i];
+      const double y = py[i];
+      const double z = pz[i];
+      const double p = sqrt(x*x + y*y);
+
+      if (p == 0)
+        {
+          xyz2blh(x, y, z, pb[i], pl[i], ph[i]);
+          continue;
+        }
+
+      double tan_u  = AB*z/p;
+      double cos2_u = 1/(1 + tan_u*tan_u);
+      double cos_u  = sqrt(cos2_u);
+      double sin2_u = 1 - cos2_u;
+      double sin_u  = copysign(sqrt(sin2_u), z);
+
+      double s  = z + e22B*sin2_u*sin_u;
+      double c  = p - e2A*cos2_u*cos_u;
+      double r  = sqrt(s*s + c*c);
+      double sb = s/r;
+      double nn = A/sqrt(1 - e2*sb*sb);
+
+      sin_u  = Ime2*nn/B*sb;
+      sin2_u = sin_u*sin_u;
+      cos2_u = 1 - sin2_u;
+      cos_u  = sqrt(cos2_u);
+
+      s  = z + e22B*sin2_u*sin_u;
+      c  = p - e2A*cos2_u*cos_u;
+      r  = sqrt(s*s + c*c);
+      sb = s/r;
+      nn = A/sqrt(1 - e2*sb*sb);
+
+      pb[i] = atan2(s, c);
+      pl[i] = atan2(y, x);
+      ph[i] = p > fabs(z) ? p/(c/r) - nn : z/sb - Ime2*nn;
+    }
+}
@@ -22,6 +22,8 @@
 #ifndef GNU_gama_gnu_gama_local_ellipsoid_H_ELLIPSOID_H_
 #define GNU_gama_gnu_gama_local_ellipsoid_H_ELLIPSOID_H_
 
+#include <cstddef>
+
 namespace GNU_gama {
 
   class Ellipsoid {
@@ -41,6 +43,13 @@ namespace GNU_gama {
     void blh2xyz(double, double, double, double&, double&, double&) const;
     void xyz2blh(double, double, double, double&, double&, double&) const;
 
+    // batch transformations of n points stored in separate arrays
+
+    void blh2xyz(std::size_t n, const double* b, const double* l,
+                 const double* h, double* x, double* y, double* z) const;
+    void xyz2blh(std::size_t n, const double* x, const double* y,
+                 const double* z, double* b, double* l, double* h) const;
+
     void set_ab (double pa, double pb) { set_abff1( pa, pb,  0,  0); }
     void set_af (double pa, double pf) { set_abff1( pa,  0, pf,  0); }
     void set_af1(double pa, double pf) { set_abff1( pa,  0,  0, pf); }
@@ -67,15 +67,7 @@ Model::~Model()
 
 Point* Model::get_point(const Point::Name& name)
 {
-  Point* p = points->find(name);
-  if (p == 0)
-    {
-      p = new Point;
-      p->name = name;
-      points->put(p);
-    }
-
-  return p;
+  return points->add(name);
 }
 
 
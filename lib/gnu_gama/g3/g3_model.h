@@ -105,6 +105,8 @@ namespace GNU_gama {
     void write_xml_adjusted(std::ostream&, const ZenithAngle*,int);
 
     void set_algorithm(Adj::algorithm a) { adj->set_algorithm(a); }
+    void set_mixed_precision(bool mp)    { adj->set_mixed_precision(mp); }
+    const Adj* adjustment() const        { return adj; }
 
     void   set_apriori_sd(double s) { apriori_sd = s;          }
     double get_apriori_sd() const   { return apriori_sd;       }
@@ -171,9 +173,12 @@ namespace GNU_gama {
     bool check_init() const { return state_ > init_; }
     void update_init();
 
+    Point* find_point(Observation*, int, const Point::Name&);
+
 
     // design matrix
-    int dm_rows, dm_cols, dm_floats;
+    int dm_rows, dm_cols;
+    std::size_t dm_floats;
     SparseMatrix <>*  A {nullptr};
     Vec          <>   rhs;
     int               rhs_ind;
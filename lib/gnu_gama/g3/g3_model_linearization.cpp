@@ -114,9 +114,11 @@ void GNU_gama::g3::Model::update_linearization()
 
     } while (!check_observations());
 
-  if (dm_floats * dm_rows * dm_cols == 0)
+  if (dm_floats == 0 || dm_rows == 0 || dm_cols == 0)
     throw GNU_gama::Exception::string("No parameters and/or observations");
 
+  A->shrink_to_fit();   // dm_floats is an upper bound of nonzero elements
+
   adj_input_data->set_mat(A);
   adj_input_data->set_rhs(rhs);
 
@@ -154,7 +156,8 @@ void GNU_gama::g3::Model::update_linearization()
   }
 
   {
-    int nonzeroes=0, blocks=0;
+    std::size_t nonzeroes=0;
+    int blocks=0;
     for (ClusterList::iterator ci = obsdata.clusters.begin(),
            ce = obsdata.clusters.end(); ci!=ce; ++ci)
       {
@@ -192,9 +195,9 @@ void Model::linearization(Angle* pangle)
 {
   using namespace std;
 
-  Point* from  = points->find(pangle->from);
-  Point* left  = points->find(pangle->left);
-  Point* right = points->find(pangle->right);
+  Point* from  = points->at(pangle->point_index[0]);
+  Point* left  = points->at(pangle->point_index[1]);
+  Point* right = points->at(pangle->point_index[2]);
 
   const double sca = Angular().scale();
   const double scl = Linear ().scale();
@@ -280,8 +283,8 @@ void Model::linearization(Angle* pangle)
 
 void Model::linearization(Azimuth* a)
 {
-  Point* from = points->find(a->from);
-  Point* to   = points->find(a->to  );
+  Point* from = points->at(a->point_index[0]);
+  Point* to   = points->at(a->point_index[1]);
 
   E_3 from_vertical, from_to, p1, v1, p2, v2;
 
@@ -348,8 +351,8 @@ void Model::linearization(Azimuth* a)
 
 void Model::linearization(Distance* d)
 {
-  Point* from = points->find(d->from);
-  Point* to   = points->find(d->to  );
+  Point* from = points->at(d->point_index[0]);
+  Point* to   = points->at(d->point_index[1]);
 
   {
     double dx = to->X() - from->X();
@@ -419,7 +422,7 @@ void Model::linearization(Distance* d)
 
 void Model::linearization(Height* height)
 {
-  Point* point = points->find(height->id);
+  Point* point = points->at(height->point_index[0]);
 
   // nonzero derivatives in project equations
   A->new_row();
@@ -435,8 +438,8 @@ void Model::linearization(Height* height)
 
 void Model::linearization(HeightDiff* dh)
 {
-  Point* from = points->find(dh->from);
-  Point* to   = points->find(dh->to  );
+  Point* from = points->at(dh->point_index[0]);
+  Point* to   = points->at(dh->point_index[1]);
 
   // nonzero derivatives in project equations
   A->new_row();
@@ -454,8 +457,8 @@ void Model::linearization(HeightDiff* dh)
 
 void Model::linearization(Vector* v)
 {
-  Point* from = points->find(v->from);
-  Point* to   = points->find(v->to  );
+  Point* from = points->at(v->point_index[0]);
+  Point* to   = points->at(v->point_index[1]);
 
   for (int i=1; i<=3; i++)
    {
@@ -526,7 +529,7 @@ void Model::linearization(Vector* v)
 
 void Model::linearization(XYZ* xyz)
 {
-  Point* point = points->find(xyz->id);
+  Point* point = points->at(xyz->point_index[0]);
 
   for (int i=1; i<=3; i++)
    {
@@ -586,8 +589,8 @@ void Model::linearization(XYZ* xyz)
 
 void Model::linearization(ZenithAngle* z)
 {
-  Point* from = points->find(z->from);
-  Point* to   = points->find(z->to  );
+  Point* from = points->at(z->point_index[0]);
+  Point* to   = points->at(z->point_index[1]);
 
   E_3 from_vertical, from_to, p1, v1, p2, v2;
 
@@ -116,13 +116,23 @@ void Model::update_observations()
 
 
 
+Point* Model::find_point(Observation* obs, int n, const Point::Name& name)
+{
+  const std::size_t index = points->index(name);
+  obs->point_index[n] = index;
+
+  return index == PointBase::npos ? nullptr : points->at(index);
+}
+
+
+
 bool Model::revision(Angle* angle)
 {
   if (!angle->active()) return false;
 
-  Point* from  = points->find(angle->from);
-  Point* left  = points->find(angle->left);
-  Point* right = points->find(angle->right);
+  Point* from  = find_point(angle, 0, angle->from);
+  Point* left  = find_point(angle, 1, angle->left);
+  Point* right = find_point(angle, 2, angle->right);
 
   if ( from  == 0      ) return angle->set_active(false);
   if ( from->unused()  ) return angle->set_active(false);
@@ -166,8 +176,8 @@ bool Model::revision(Azimuth* a)
 {
   if (!a->active()) return false;
 
-  Point* from = points->find(a->from);
-  Point* to   = points->find(a->to  );
+  Point* from = find_point(a, 0, a->from);
+  Point* to   = find_point(a, 1, a->to);
 
   if ( from == 0      ||  to == 0      ) return a->set_active(false);
   if ( from->unused() ||  to->unused() ) return a->set_active(false);
@@ -199,8 +209,8 @@ bool Model::revision(Distance* d)
 {
   if (!d->active()) return false;
 
-  Point* from = points->find(d->from);
-  Point* to   = points->find(d->to  );
+  Point* from = find_point(d, 0, d->from);
+  Point* to   = find_point(d, 1, d->to);
 
   if ( from == 0      ||  to == 0      ) return d->set_active(false);
   if ( from->unused() ||  to->unused() ) return d->set_active(false);
@@ -232,7 +242,7 @@ bool Model::revision(Height* height)
 {
   if (!height->active()) return false;
 
-  Point* point = points->find(height->id);
+  Point* point = find_point(height, 0, height->id);
 
   if ( point == 0                ) return height->set_active(false);
   if ( point->unused()           ) return height->set_active(false);
@@ -255,8 +265,8 @@ bool Model::revision(HeightDiff* dh)
 {
   if (!dh->active()) return false;
 
-  Point* from = points->find(dh->from);
-  Point* to   = points->find(dh->to  );
+  Point* from = find_point(dh, 0, dh->from);
+  Point* to   = find_point(dh, 1, dh->to);
 
   if ( from == 0      ||  to == 0     ) return dh->set_active(false);
   if ( from->unused() ||  to->unused()) return dh->set_active(false);
@@ -282,8 +292,8 @@ bool Model::revision(Vector* v)
 {
   if (!v->active()) return false;
 
-  Point* from = points->find(v->from);
-  Point* to   = points->find(v->to  );
+  Point* from = find_point(v, 0, v->from);
+  Point* to   = find_point(v, 1, v->to);
 
   if ( from == 0      ||  to == 0      ) return v->set_active(false);
   if ( from->unused() ||  to->unused() ) return v->set_active(false);
@@ -315,7 +325,7 @@ bool Model::revision(XYZ* xyz)
 {
   if (!xyz->active()) return false;
 
-  Point* point = points->find(xyz->id);
+  Point* point = find_point(xyz, 0, xyz->id);
 
   if ( point == 0           ) return xyz->set_active(false);
   if ( point->unused()      ) return xyz->set_active(false);
@@ -340,8 +350,8 @@ bool Model::revision(ZenithAngle* z)
 {
   if (!z->active()) return false;
 
-  Point* from = points->find(z->from);
-  Point* to   = points->find(z->to  );
+  Point* from = find_point(z, 0, z->from);
+  Point* to   = find_point(z, 1, z->to);
 
   if ( from == 0      ||  to == 0      ) return z->set_active(false);
   if ( from->unused() ||  to->unused() ) return z->set_active(false);
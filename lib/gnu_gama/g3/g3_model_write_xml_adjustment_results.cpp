@@ -158,6 +158,8 @@ void Model::write_xml_adjustment_results_statistics(std::ostream& out)
   else if (alg == Adj::gso)      out << "gso";
   else if (alg == Adj::svd)      out << "svd";
   else if (alg == Adj::cholesky) out << "cholesky";
+  else if (alg == Adj::cgls)     out << "cgls";
+  else if (alg == Adj::helmert)  out << "helmert";
   else                           out << "unknown";
   out << " </algorithm>\n\n";
 
@@ -19,6 +19,7 @@
     Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <cstddef>
 #include <matvec/covmat.h>
 #include <gnu_gama/visitor.h>
 #include <gnu_gama/model.h>
@@ -39,6 +40,10 @@ namespace GNU_gama {  namespace g3 {
   {
   public:
 
+    // indices of observed points in the model point base, set in the
+    // revision of the observation and used in its linearization
+
+    std::size_t point_index[3] {};
   };
 
 
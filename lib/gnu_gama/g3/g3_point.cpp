@@ -87,6 +87,16 @@ void Point::point_copy(const Point& point)
   has_xyz_    = point.has_xyz_;
   has_blh_    = point.has_blh_;
   has_height_ = point.has_height_;
+
+  // parameters copied from the other point refer to their owner
+
+  N     .set_owner(this);
+  E     .set_owner(this);
+  U     .set_owner(this);
+  height.set_owner(this);
+  geoid .set_owner(this);
+  dB    .set_owner(this);
+  dL    .set_owner(this);
 }
 
 void Point::set_unused()
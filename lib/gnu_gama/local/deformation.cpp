@@ -19,29 +19,71 @@
     Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  $
 */
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include <gnu_gama/local/deformation.h>
+#include <gnu_gama/parallel.h>
 #include <gnu_gama/local/network.h>
+#include <gnu_gama/local/snapshot.h>
 #include <gnu_gama/xml/localnetwork_adjustment_results.h>
 #include <gnu_gama/local/svg.h>
 #include <matvec/bandmat.h>
 
 using namespace GNU_gama::local;
 
+namespace {
+
+  // adjustment results from xml output or from a binary snapshot
+
+  void read_results(std::istream& inp,
+                    GNU_gama::LocalNetworkAdjustmentResults* results)
+  {
+    if (!Snapshot::test(inp))
+      {
+        results->read_xml(inp);
+        return;
+      }
+
+    Snapshot snapshot;
+    snapshot.read(inp);
+    snapshot.get_results(*results);
+  }
+
+}
+
 void GamaLocalDeformation::init()
 {
   if (is_ready) return;
 
   adjrec12.clear();
+  adjrec12.reserve(ptr_epoch1()->adjusted_points.size());
+
+  // points of both epochs are matched by hashed ids, the records are
+  // sorted by ids afterwards
+
+  std::unordered_map<std::string, std::size_t> ids;
+  ids.reserve(ptr_epoch1()->adjusted_points.size() +
+              ptr_epoch2()->adjusted_points.size());
+
+  auto record = [&](const std::string& id) -> Rec12&
+    {
+      auto p = ids.emplace(id, adjrec12.size());
+      if (p.second)
+        {
+          adjrec12.emplace_back();
+          adjrec12.back().id = id;
+        }
+      return adjrec12[p.first->second];
+    };
 
   for (const auto& p1 : ptr_epoch1()->adjusted_points)
   {
-    auto& rec = adjrec12[p1.id];
-    rec.id = p1.id; // p1.cxy p1.cz constrained
+    auto& rec = record(p1.id); // p1.cxy p1.cz constrained
     rec.indx1 = p1.indx; rec.x1 = p1.x;
     rec.indy1 = p1.indy; rec.y1 = p1.y;
     rec.indz1 = p1.indz; rec.z1 = p1.z;
@@ -49,13 +91,15 @@ void GamaLocalDeformation::init()
 
   for (const auto& p2 : ptr_epoch2()->adjusted_points)
   {
-    auto& rec = adjrec12[p2.id];
-    rec.id = p2.id; // p1.cxy p1.cz constrained
+    auto& rec = record(p2.id); // p1.cxy p1.cz constrained
     rec.indx2 = p2.indx; rec.x2 = p2.x;
     rec.indy2 = p2.indy; rec.y2 = p2.y;
     rec.indz2 = p2.indz; rec.z2 = p2.z;
   }
 
+  std::sort(adjrec12.begin(), adjrec12.end(),
+            [](const Rec12& a, const Rec12& b) { return a.id < b.id; });
+
 #ifdef DEBUG_GAMA_LOCAL_DEFORMATION
   for (const auto& r : adjrec) std::cerr << r.second;
   std::cerr << epoch2->cov;
@@ -67,7 +111,7 @@ void GamaLocalDeformation::init()
 #endif
 
   int adjcov_dim = 0;
-  for (const auto& r : adjrec12) adjcov_dim += r.second.dim();
+  for (const auto& r : adjrec12) adjcov_dim += r.dim();
 
 #ifdef DEBUG_GAMA_LOCAL_DEFORMATION
     // std::cerr << adjcov << "\n";
@@ -79,16 +123,16 @@ void GamaLocalDeformation::init()
 
   for (const auto& r : adjrec12)
   {
-    if (r.second.indx1 && r.second.indx2) {
-      t1.push_back( r.second.indx1 );
-      t1.push_back( r.second.indy1 );
+    if (r.indx1 && r.indx2) {
+      t1.push_back( r.indx1 );
+      t1.push_back( r.indy1 );
 
-      t2.push_back( r.second.indx2 );
-      t2.push_back( r.second.indy2 );
+      t2.push_back( r.indx2 );
+      t2.push_back( r.indy2 );
     }
-    if (r.second.indz1 && r.second.indz2) {
-      t1.push_back( r.second.indz1 );
-      t2.push_back( r.second.indz2 );
+    if (r.indz1 && r.indz2) {
+      t1.push_back( r.indz1 );
+      t2.push_back( r.indz2 );
     }
   }
 
@@ -111,31 +155,31 @@ void GamaLocalDeformation::init()
   cov_index = 0;
 
   adjdiff.clear();
-  for (auto& adjr : adjrec12)
-    if (!adjr.second.empty())
+  for (std::size_t k=0; k<adjrec12.size(); k++)
+    if (!adjrec12[k].empty())
     {
-      std::string id = adjr.second.id;
+      const Rec12& adjr = adjrec12[k];
       RecDiff rec;
-      rec.id  = id;
-      rec.dx  = adjr.second.x2 - adjr.second.x1;
-      rec.dy  = adjr.second.y2 - adjr.second.y1;
-      rec.dz  = adjr.second.z2 - adjr.second.z1;
-      // rec.dim = adjr.second.dim();
+      rec.id  = adjr.id;
+      rec.dx  = adjr.x2 - adjr.x1;
+      rec.dy  = adjr.y2 - adjr.y1;
+      rec.dz  = adjr.z2 - adjr.z1;
+      rec.rec12 = k;
 
-      if (adjr.second.dim() == 3) {
+      if (adjr.dim() == 3) {
         rec.indx = ++cov_index;
         rec.indy = ++cov_index;
         rec.indz = ++cov_index;
       }
-      else if (adjr.second.dim() == 2) {
+      else if (adjr.dim() == 2) {
         rec.indx = ++cov_index;
         rec.indy = ++cov_index;
       }
-      else if (adjr.second.dim() == 1) {
+      else if (adjr.dim() == 1) {
         rec.indz = ++cov_index;
       }
 
-      adjdiff[id] = rec;
+      adjdiff.push_back(rec);
     }
 
   is_ready = true;
@@ -235,22 +279,22 @@ General help using GNU software: <https://www.gnu.org/gethelp/>
   argv_epoch2 = epoch[1];
 
 
-  std::ifstream inp_epoch1(argv_epoch1);
+  std::ifstream inp_epoch1(argv_epoch1, std::ios_base::binary);
   if (!inp_epoch1) {
     vec_errors.push_back("ERROR OPENING 1st EPOCH ADJUSTMENT FILE "
                       + argv_epoch1);
   } else {
     ptr_epoch_1 = new Results;
-    ptr_epoch_1->read_xml(inp_epoch1);
+    read_results(inp_epoch1, ptr_epoch_1);
   }
 
-  std::ifstream inp_epoch2(argv_epoch2);
+  std::ifstream inp_epoch2(argv_epoch2, std::ios_base::binary);
   if (!inp_epoch2) {
     vec_errors.push_back("ERROR OPENING 2nd EPOCH ADJUSTMENT FILE "
                       + argv_epoch2);
   } else {
     ptr_epoch_2 = new Results;
-    ptr_epoch_2->read_xml(inp_epoch2);
+    read_results(inp_epoch2, ptr_epoch_2);
   }
 
   return vec_errors.size();
@@ -288,9 +332,8 @@ void GamaLocalDeformation::write_txt()
   std::cout.precision(prec);
 
   int indxw {0}, indyw {0}, indzw {0};
-  for (const auto& rec : adjdiff)
+  for (const auto& r : adjdiff)
   {
-    auto& r = rec.second;
 
     std::ostringstream strx;
     strx.precision(prec);
@@ -315,9 +358,9 @@ void GamaLocalDeformation::write_txt()
   int indw = 1 + std::log10<int>(cov_index);
   std::cout.precision(prec);
 
-  for (auto& rec : adjdiff)
+  for (const auto& r : adjdiff)
   {
-    auto& r = rec.second;
+    const auto& r12 = adjrec12[r.rec12];
     std::cout << std::setw(idw)   << r.id   << "   "
 
 	      << std::setw(indw)  << r.indx << " "
@@ -328,9 +371,9 @@ void GamaLocalDeformation::write_txt()
 	      << std::setw(indyw) << r.dy   << "  "
 	      << std::setw(indzw) << r.dz   << "    "
 
-	      << adjrec12[r.id].x2 << "  "
-	      << adjrec12[r.id].y2 << "  "
-	      << adjrec12[r.id].z2
+	      << r12.x2 << "  "
+	      << r12.y2 << "  "
+	      << r12.z2
 
               << std::endl;
   }
@@ -341,17 +384,70 @@ void GamaLocalDeformation::write_txt()
   std::cerr << epoch1->cov << "\n\n" << epoch2->cov << "\n\n";
 #endif
 
-  GNU_gama::CovMat<> C(cov_index, cov_index-1);
+  std::cout << shifts_cov();
+
+}
+// GamaLocalDeformation::write_txt()
+
+
+GNU_gama::CovMat<> GamaLocalDeformation::shifts_cov()
+{
+  init();
+
+  /* Covariance matrix of shifts is the sum of epoch covariances
+   * restricted to common points. Only elements within the bands of
+   * epoch covariance matrices can be nonzero; they are found through
+   * the inverse index transformations s1 and s2. */
+
+  const GNU_gama::CovMat<>& cov1 = ptr_epoch1()->cov;
+  const GNU_gama::CovMat<>& cov2 = ptr_epoch2()->cov;
+
+  std::vector<int> s1(1), s2(1);
   for (int i=1; i<=cov_index; i++)
-    for (int j=i; j<=cov_index; j++)
     {
-      C(i,j) = ptr_epoch1()->cov(t1[i],t1[j]) + ptr_epoch2()->cov(t2[i],t2[j]);
+      if (t1[i] >= int(s1.size())) s1.resize(t1[i]+1, 0);
+      if (t2[i] >= int(s2.size())) s2.resize(t2[i]+1, 0);
+      s1[t1[i]] = i;
+      s2[t2[i]] = i;
     }
 
-  std::cout << C;
+  // calls f(j) for shift indexes j >= i within the band of cov1 or cov2
+  auto band_elements = [&](int i, auto f)
+    {
+      const int b1 = cov1.bandWidth(), n1 = int(s1.size()) - 1;
+      for (int k=std::max(1, t1[i]-b1); k<=std::min(n1, t1[i]+b1); k++)
+        if (s1[k] >= i) f(s1[k]);
+
+      const int b2 = cov2.bandWidth(), n2 = int(s2.size()) - 1;
+      for (int k=std::max(1, t2[i]-b2); k<=std::min(n2, t2[i]+b2); k++)
+        if (s2[k] >= i) f(s2[k]);
+    };
+
+  const int band = GNU_gama::parallel_reduce(1, cov_index+1, 256, 0,
+    [&](int i0, int i1)
+    {
+      int b = 0;
+      for (int i=i0; i<i1; i++)
+        band_elements(i, [&b, i](int j) { b = std::max(b, j-i); });
+      return b;
+    },
+    [](int a, int b) { return std::max(a, b); });
+
+  GNU_gama::CovMat<> C(cov_index, band);
+  C.set_zero();
 
+  GNU_gama::parallel_for(1, cov_index+1, 256, [&](int i0, int i1)
+    {
+      for (int i=i0; i<i1; i++)
+        band_elements(i, [&](int j)
+          {
+            C(i,j) = cov1(t1[i],t1[j]) + cov2(t2[i],t2[j]);
+          });
+    });
+
+  return C;
 }
-// GamaLocalDeformation::write_txt()
+// GamaLocalDeformation::shifts_cov()
 
 
 void GamaLocalDeformation::write_svg()
@@ -467,12 +563,12 @@ void GamaLocalDeformation::write_svg()
   }
 
   for (const auto& recdiff : adjdiff) {
-    auto id = recdiff.first;
-    int dim = recdiff.second.indx + recdiff.second.indy + recdiff.second.indz;
+    auto id = recdiff.id;
+    int dim = recdiff.indx + recdiff.indy + recdiff.indz;
 
-    double dx = recdiff.second.dx;
-    double dy = recdiff.second.dy;
-    double dz = recdiff.second.dz;
+    double dx = recdiff.dx;
+    double dy = recdiff.dy;
+    double dz = recdiff.dz;
 
     svg.shifts[id] = std::make_tuple(dim, dx, dy, dz);
   }
@@ -22,7 +22,6 @@
 #ifndef gama_local_deformation
 #define gama_local_deformation
 
-#include <map>
 #include <string>
 #include <vector>
 #include <gnu_gama/version.h>
@@ -50,7 +49,7 @@ class GamaLocalDeformation {
     int indy {0}; double dy {0};
     int indz {0}; double dz {0};
 
-    //int dim {0};
+    std::size_t rec12 {0};  // index of the point in adjrec12
   };
 
   struct Rec12 {
@@ -66,8 +65,8 @@ class GamaLocalDeformation {
 
     int dim() const {
       int d = 0;
-      if (indz1*indz2) d += 1;
-      if (indx1*indx2) d += 2;
+      if (indz1 && indz2) d += 1;
+      if (indx1 && indx2) d += 2;
       return d;
     }
 
@@ -96,13 +95,15 @@ class GamaLocalDeformation {
 
   void init();
 
-  std::map<std::string, RecDiff> adjdiff;
-  std::map<std::string, Rec12>   adjrec12;
+  std::vector<RecDiff> adjdiff;     // common points sorted by id
+  std::vector<Rec12>   adjrec12;    // all points sorted by id
   bool is_ready;
 
   std::vector<int> t1 {0}, t2 {0};  // 1 based index transformation
   int cov_index {0};
 
+  GNU_gama::CovMat<> shifts_cov();
+
 public:
 
   GamaLocalDeformation() : is_ready(false) {}
@@ -0,0 +1,280 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <gnu_gama/local/design_analysis.h>
+#include <gnu_gama/parallel.h>
+#include <gnu_gama/statan.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+
+using namespace GNU_gama::local;
+
+namespace {
+
+  const double power_of_test = 0.80;
+  const double min_redundancy = 1e-8;     // removal gives a singular system
+  const int    batch_columns  = 256;      // candidates solved in one batch
+
+}
+
+
+DesignAnalysis::DesignAnalysis(LocalNetwork* ln, Criterion c)
+  : lnet(ln), criterion_(c)
+{
+}
+
+
+void DesignAnalysis::init()
+{
+  m0_ = lnet->m_0();
+
+  const double alfa = 1 - lnet->conf_pr();
+  delta0_ = GNU_gama::Normal(alfa/2) + GNU_gama::Normal(1 - power_of_test);
+
+  coords_.clear();
+  for (int i=1; i<=lnet->unknowns_count(); i++)
+    if (lnet->unknown_type(i) != 'R') coords_.push_back(i);
+
+  qdiag_.reset(int(coords_.size()));
+  for (std::size_t k=0; k<coords_.size(); k++)
+    qdiag_(int(k)+1) = lnet->qxx(coords_[k], coords_[k]);
+
+  Vec u(lnet->unknowns_count());
+  u.set_zero();
+  current_ = updated_criterion(u, 0);
+  ready_   = true;
+}
+
+
+double DesignAnalysis::updated_criterion(const Vec& u, double s) const
+{
+  if (coords_.empty()) return 0;
+
+  double c = 0;
+  for (std::size_t k=0; k<coords_.size(); k++)
+    {
+      const double uk = u(coords_[k]);
+      const double q  = qdiag_(int(k)+1) + s*uk*uk;
+      if (criterion_ == Trace)
+        c += q;
+      else
+        c = std::max(c, q);
+    }
+  if (criterion_ == Trace) c /= coords_.size();
+
+  return m0_*std::sqrt(std::max(c, 0.0));
+}
+
+
+void DesignAnalysis::analyse()
+{
+  init();
+  removals_.clear();
+  additions_.clear();
+  skipped_ = 0;
+
+  const Mat& A = lnet->homogenized_design_matrix();
+  const int  N = A.cols();
+
+  // rows of homogenized design matrix of observations from clusters
+  // with diagonal covariance matrices are not mixed with other rows
+
+  std::map<const GNU_gama::Cluster<Observation>*, bool> diagonal;
+  std::vector<int> candidates;
+  for (int i=1; i<=A.rows(); i++)
+    {
+      const GNU_gama::Cluster<Observation>* c = lnet->ptr_obs(i)->ptr_cluster();
+      auto d = diagonal.find(c);
+      if (d == diagonal.end())
+        d = diagonal.emplace(c, c->activeCov().bandWidth() == 0).first;
+
+      if (d->second)
+        candidates.push_back(i);
+      else
+        skipped_++;
+    }
+
+  const int count = int(candidates.size());
+  removals_ .resize(count);
+  additions_.resize(count);
+
+  Mat B;
+  for (int first=0; first<count; first+=batch_columns)
+    {
+      const int cols = std::min(batch_columns, count - first);
+      B.reset(N, cols);
+      for (int c=1; c<=cols; c++)
+        for (int j=1; j<=N; j++) B(j,c) = A(candidates[first+c-1], j);
+
+      lnet->qxx_batch(B);
+
+      GNU_gama::parallel_for(1, cols+1, 8, [&](int c0, int c1)
+        {
+          Vec u(N);
+          for (int c=c0; c<c1; c++)
+            {
+              const int n = first + c - 1;
+              const int i = candidates[n];
+
+              double q = 0;
+              for (int j=1; j<=N; j++)
+                {
+                  u(j) = B(j,c);
+                  q += A(i,j)*u(j);
+                }
+              const double stdev = lnet->ptr_obs(i)->stdDev();
+              const double r = 1 - q;
+
+              Candidate& rem = removals_[n];
+              rem.index      = i;
+              rem.removed    = true;
+              rem.redundancy = std::max(r, 0.0);
+              rem.singular   = r < min_redundancy;
+              if (rem.singular)
+                {
+                  rem.mdb       = std::numeric_limits<double>::infinity();
+                  rem.criterion = std::numeric_limits<double>::infinity();
+                }
+              else
+                {
+                  rem.mdb       = stdev*delta0_/std::sqrt(r);
+                  rem.criterion = updated_criterion(u, 1/r);
+                }
+
+              // redundancy numbers of both identical observations
+
+              Candidate& add = additions_[n];
+              add.index      = i;
+              add.removed    = false;
+              add.redundancy = 1/(1 + q);
+              add.mdb        = stdev*delta0_/std::sqrt(add.redundancy);
+              add.criterion  = updated_criterion(u, -1/(1 + q));
+            }
+        });
+    }
+
+  auto rank = [](const Candidate& a, const Candidate& b)
+    {
+      if (a.criterion != b.criterion) return a.criterion < b.criterion;
+      return a.index < b.index;
+    };
+  std::sort(removals_ .begin(), removals_ .end(), rank);
+  std::sort(additions_.begin(), additions_.end(), rank);
+}
+
+
+DesignAnalysis::Candidate DesignAnalysis::evaluate(const Vec& row, double stdev)
+{
+  if (!ready_) init();
+
+  const int N = lnet->unknowns_count();
+  const double p = lnet->apriori_m_0()/stdev;
+
+  Mat B(N, 1);
+  for (int j=1; j<=N; j++) B(j,1) = p*row(j);
+  Vec a(N);
+  for (int j=1; j<=N; j++) a(j) = B(j,1);
+
+  lnet->qxx_batch(B);
+
+  Vec u(N);
+  double q = 0;
+  for (int j=1; j<=N; j++)
+    {
+      u(j) = B(j,1);
+      q += a(j)*u(j);
+    }
+
+  Candidate add;
+  add.redundancy = 1/(1 + q);
+  add.mdb        = stdev*delta0_/std::sqrt(add.redundancy);
+  add.criterion  = updated_criterion(u, -1/(1 + q));
+
+  return add;
+}
+
+
+void DesignAnalysis::write_txt(std::ostream& out) const
+{
+  using std::setw;
+
+  const double scale = lnet->gons() ? 1.0 : 0.324;
+  const int    w     = lnet->maxw_id();
+  DisplayObservationVisitor obsvis(lnet);
+
+  out << "Network design analysis\n"
+      << "***********************\n\n"
+      << (criterion_ == Trace
+          ? "Mean standard deviation of coordinates    [mm] "
+          : "Maximal standard deviation of coordinates [mm] ")
+      << std::fixed << std::setprecision(3) << setw(10) << current_ << "\n"
+      << "Noncentrality parameter of MDB (power " << int(100*power_of_test)
+      << "%)  " << std::setprecision(2) << setw(8) << delta0_ << "\n";
+  if (skipped_)
+    out << "Observations of correlated clusters not evaluated "
+        << skipped_ << "\n";
+
+  auto table = [&](const std::vector<Candidate>& list, const char* title)
+    {
+      out << "\n" << title << "\n"
+          << std::string(std::string(title).size(), '=') << "\n\n"
+          << setw(lnet->maxw_obs()) << "i" << " "
+          << std::left << setw(w) << "standpoint" << " "
+          << setw(w) << "target" << " "
+          << setw(12) << "observation" << std::right
+          << "  redund.        mdb  criterion\n"
+          << std::string(lnet->maxw_obs() + 2*w + 16, '=')
+          << (lnet->gons() ? " [%] ===== [mm|cc] ===== [mm] ==\n\n"
+                           : " [%] ===== [mm|ss] ===== [mm] ==\n\n");
+
+      for (const Candidate& c : list)
+        {
+          Observation* obs = lnet->ptr_obs(c.index);
+          obs->accept(&obsvis);
+          std::string target = obsvis.str_to;
+          if (target.empty()) target = obsvis.str_fs;
+
+          out << setw(lnet->maxw_obs()) << c.index << " "
+              << std::left << setw(w) << obsvis.str_from << " "
+              << setw(w) << target << " "
+              << setw(12) << obsvis.xml_name << std::right
+              << std::setprecision(1) << setw(9) << 100*c.redundancy;
+          if (c.singular)
+            {
+              out << setw(11) << "-" << setw(11) << "-" << "\n";
+              continue;
+            }
+
+          const double s = obs->angular() ? scale : 1.0;
+          out << std::setprecision(2) << setw(11) << c.mdb*s
+              << std::setprecision(3) << setw(11) << c.criterion << "\n";
+        }
+    };
+
+  table(removals_,  "Removed observations");
+  table(additions_, "Repeated observations");
+}
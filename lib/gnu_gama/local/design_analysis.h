@@ -0,0 +1,120 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef gama_local_DesignAnalysis_network_design_rank_one_updates_h_
+#define gama_local_DesignAnalysis_network_design_rank_one_updates_h_
+
+#include <iosfwd>
+#include <vector>
+
+#include <gnu_gama/local/network.h>
+
+namespace GNU_gama { namespace local {
+
+  /** \brief Network design analysis by rank-one updates
+   *
+   * Observations of an adjusted network are evaluated as candidates
+   * for removal or repetition (an identical observation with the same
+   * standard deviation is added). For the homogenized row a of the
+   * design matrix, u = Q*a and q = a'*u, cofactors of unknowns after
+   * the change are
+   *
+   *     removed:   Q + u*u'/(1 - q)
+   *     repeated:  Q - u*u'/(1 + q)
+   *
+   * Vectors u are computed in batches from the existing factorization
+   * of the adjustment (LocalNetwork::qxx_batch()), no equations are
+   * solved again and candidates are evaluated in parallel. Only
+   * observations of clusters with diagonal covariance matrix are
+   * candidates, observations of correlated clusters are skipped.
+   *
+   * Minimal detectable biases are computed from a priori standard
+   * deviations of observations for the confidence probability of the
+   * network and the power of test 80%. Precision criteria are computed
+   * from the reference standard deviation of the adjustment.
+   */
+
+  class DesignAnalysis {
+  public:
+
+    enum Criterion
+    {
+      Trace,         // mean standard deviation of coordinates
+      Max            // maximal standard deviation of coordinates
+    };
+
+    struct Candidate
+    {
+      int    index      {0};       // observation index, 0 for a new one
+      bool   removed    {false};   // removed or added observation
+      bool   singular   {false};   // removal causes undetermined unknowns
+      double redundancy {0};       // redundancy number of the observation
+      double mdb        {0};       // minimal detectable bias [mm|cc]
+      double criterion  {0};       // precision criterion after change [mm]
+    };
+
+    explicit DesignAnalysis(LocalNetwork* lnet, Criterion c = Trace);
+
+    /** All candidates are evaluated and ranked by the criterion. */
+    void analyse();
+
+    /** Effect of a new observation given by its coefficients of project
+     *  equations (design matrix row) and standard deviation [mm|cc]. */
+    Candidate evaluate(const Vec& row, double stdev);
+
+    Criterion criterion_type() const { return criterion_; }
+    /** precision criterion of the adjusted network [mm] */
+    double    criterion() const      { return current_; }
+    /** noncentrality parameter of minimal detectable biases */
+    double    delta0() const         { return delta0_; }
+    /** observations of correlated clusters not evaluated */
+    int       skipped() const        { return skipped_; }
+
+    /** removals ranked from the least to the most damaging */
+    const std::vector<Candidate>& removals()  const { return removals_;  }
+    /** repetitions ranked from the most to the least improving */
+    const std::vector<Candidate>& additions() const { return additions_; }
+
+    void write_txt(std::ostream&) const;
+
+  private:
+
+    LocalNetwork*    lnet;
+    const Criterion  criterion_;
+    double           m0_     {0};
+    double           delta0_ {0};
+    double           current_{0};
+    int              skipped_{0};
+    bool             ready_  {false};
+
+    std::vector<int> coords_;       // indexes of coordinate unknowns
+    Vec              qdiag_;        // diagonal cofactors of coordinates
+
+    std::vector<Candidate> removals_;
+    std::vector<Candidate> additions_;
+
+    void   init();
+    double updated_criterion(const Vec& u, double s) const;  // Q + s*u*u'
+  };
+
+}}
+
+#endif
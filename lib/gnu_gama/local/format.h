@@ -32,24 +32,16 @@ class Format {
 
 public:
 
-  static int coord_p(int n = coordinates_p)
-             {
-                int p = coordinates_p;
-                coordinates_p = n;
-                return p;
-             }
-  static int gon_p(int n = centesimal_degrees_p)
-             {
-                int p = centesimal_degrees_p;
-                centesimal_degrees_p = n;
-                return p;
-             }
-  static int stdev_p(int n = standard_deviations_p)
-             {
-                int p = standard_deviations_p;
-                standard_deviations_p = n;
-                return p;
-             }
+  // getters only read the precisions and can be called concurrently,
+  // setters must not be called while networks are being written
+
+  static int coord_p() { return coordinates_p; }
+  static int gon_p()   { return centesimal_degrees_p; }
+  static int stdev_p() { return standard_deviations_p; }
+
+  static void set_coord_p(int n) { coordinates_p = n; }
+  static void set_gon_p  (int n) { centesimal_degrees_p = n; }
+  static void set_stdev_p(int n) { standard_deviations_p = n; }
 
 };
 
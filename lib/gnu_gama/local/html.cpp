@@ -994,7 +994,8 @@ void GamaLocalHTML::htmlInfo()
           std::ostringstream outv;
           outv.setf(std::ios_base::fixed, std::ios_base::floatfield);
           outv.precision(4);
-          WriteVisitor<std::ostringstream> write_visitor(outv, true, lnet->y_sign());
+          WriteVisitor<std::ostringstream> write_visitor(outv, true, lnet->y_sign(),
+                                                           lnet->gons());
           ptr->accept(&write_visitor);
           out << str2xml(outv.str());
 
@@ -1599,7 +1600,8 @@ void GamaLocalHTML::htmlRejected()
           Observation* obs = const_cast<Observation*>(*i);
           std::ostringstream out;
           out.setf(std::ios_base::fixed, std::ios_base::floatfield);
-          WriteVisitor<std::ostringstream> write_visitor(out, true, lnet->y_sign());
+          WriteVisitor<std::ostringstream> write_visitor(out, true, lnet->y_sign(),
+                                                           lnet->gons());
           obs->accept(&write_visitor);
 
           str += "<tr>" + tdLeft(out.str()) + "</tr>\n";
@@ -50,8 +50,9 @@ namespace GNU_gama { namespace local {
       PointData*   SB;
       virtual void observation_check(Observation*, Observation*) = 0;
 
-      static double small_angle_limit_;
-      static bool   small_angle_detected_;
+      // thread local, networks can be processed concurrently
+      static thread_local double small_angle_limit_;
+      static thread_local bool   small_angle_detected_;
 
     private:
 
@@ -39,6 +39,9 @@
 #include <gnu_gama/local/network.h>
 #include <gnu_gama/local/local_linearization.h>
 #include <gnu_gama/local/test_linearization_visitor.h>
+#include <gnu_gama/adj/adj_helmert.h>
+#include <gnu_gama/adj/adj_sequential.h>
+#include <gnu_gama/local/sequential.h>
 #include <gnu_gama/local/itstream.h>
 #include <gnu_gama/local/skipcomm.h>
 #include <gnu_gama/statan.h>
@@ -46,6 +49,7 @@
 #include <gnu_gama/version.h>
 #include <gnu_gama/ellipsoids.h>
 #include <gnu_gama/gon2deg.h>
+#include <gnu_gama/parallel.h>
 
 using namespace std;
 using namespace GNU_gama::local;
@@ -216,7 +220,8 @@ private:
 LocalNetwork::LocalNetwork()
   : pocbod_(0), tst_redbod_(false), pocmer_(0), tst_redmer_(false),
     m_0_apr_(10), konf_pr_(0.95), tol_abs_(1000), typ_m_0_(empiricka_),
-    tst_rov_opr_(false), tst_vyrovnani_(false), min_n_(0), min_x_(nullptr),
+    tst_rov_opr_(false), tst_vyrovnani_(false), tst_results_(false),
+    min_n_(0), min_x_(nullptr),
     gons_(true)
 {
   least_squares = nullptr;
@@ -290,12 +295,15 @@ void LocalNetwork::set_algorithm(std::string alg)
   typedef GNU_gama::AdjGSO     <double, int, MVE> OLS_gso;
   typedef GNU_gama::AdjSVD     <double, int, MVE> OLS_svd;
   typedef GNU_gama::AdjCholDec <double, int, MVE> OLS_chol;
+  typedef GNU_gama::AdjHelmert <double, int, MVE> OLS_helm;
+  typedef GNU_gama::AdjSequential<double, int, MVE> OLS_seq;
 
   AdjBase* adjb;
   if      (alg == "gso" )     adjb = new OLS_gso;
   else if (alg == "svd" )     adjb = new OLS_svd;
   else if (alg == "cholesky") adjb = new OLS_chol;
   else if (alg == "envelope") adjb = new OLS_env;
+  else if (alg == "helmert" ) adjb = new OLS_helm;
   else
     {
       alg  = "envelope";
@@ -304,6 +312,13 @@ void LocalNetwork::set_algorithm(std::string alg)
   algorithm_ = alg;
   has_algorithm_ = true;
 
+  if (prior_)           // epochs are adjusted sequentially
+    {
+      delete adjb;
+      adjb = new OLS_seq;
+    }
+
+  s_transf_.reset();
   delete least_squares;
   least_squares = adjb;
 
@@ -311,6 +326,78 @@ void LocalNetwork::set_algorithm(std::string alg)
 }
 
 
+void LocalNetwork::set_prior(const EpochPrior& prior)
+{
+  prior_ = std::make_shared<const EpochPrior>(prior);
+
+  const double s = removed_inconsistency_ ? y_sign() : 1.0;
+  for (const auto& pp : prior_->points)
+    {
+      PointData::iterator i = PD.find(pp.first);
+      if (i == PD.end()) continue;
+
+      LocalPoint& p = (*i).second;
+      const EpochPrior::Point& q = pp.second;
+      if (p.free_xy() && !p.test_xy() && q.indx && q.indy)
+        p.set_xy(q.x, s*q.y);
+      if (p.free_z() && !p.test_z() && q.indz)
+        p.set_z(q.z);
+    }
+
+  s_transf_.reset();
+  delete least_squares;
+  least_squares = new GNU_gama::AdjSequential<double, int, MVE>;
+
+  update(Points);
+}
+
+
+void LocalNetwork::prior_equations_()
+{
+  // prior expected values of unknowns are differences of prior and
+  // approximate coordinates, cofactors are related to a priori m_0
+
+  std::vector<int> ind, cind;         // unknowns and indexes in prior cov
+  std::vector<double> mean, sign;
+  const double s = removed_inconsistency_ ? y_sign() : 1.0;
+  for (const auto& pp : prior_->points)
+    {
+      PointData::const_iterator i = PD.find(pp.first);
+      if (i == PD.end()) continue;
+
+      const LocalPoint& p = (*i).second;
+      const EpochPrior::Point& q = pp.second;
+      if (p.free_xy() && p.index_x() && q.indx && q.indy)
+        {
+          ind.push_back(p.index_x());  cind.push_back(q.indx);
+          mean.push_back((q.x - p.x())*1000);  sign.push_back(1);
+          ind.push_back(p.index_y());  cind.push_back(q.indy);
+          mean.push_back((s*q.y - p.y())*1000);  sign.push_back(s);
+        }
+      if (p.free_z() && p.index_z() && q.indz)
+        {
+          ind.push_back(p.index_z());  cind.push_back(q.indz);
+          mean.push_back((q.z - p.z())*1000);  sign.push_back(1);
+        }
+    }
+
+  prior_dim_ = int(ind.size());
+  Vec  pmean(prior_dim_);
+  GNU_gama::SymMat<double, int, MVE> pcof(prior_dim_);
+  const double m2 = m_0_apr_*m_0_apr_;
+  for (int k=1; k<=prior_dim_; k++)
+    {
+      pmean(k) = mean[k-1];
+      for (int l=1; l<=k; l++)
+        pcof(k,l) = prior_->cov(cind[k-1], cind[l-1])
+                    *sign[k-1]*sign[l-1]/m2;
+    }
+
+  using OLS_seq = GNU_gama::AdjSequential<double, int, MVE>;
+  static_cast<OLS_seq*>(least_squares)->set_prior(ind, pmean, pcof);
+}
+
+
 int LocalNetwork::adj_covband() const
 {
   return adj_covband_;
@@ -563,11 +650,10 @@ void LocalNetwork::project_equations()
     LocalLinearization  loclin(PD, m_0_apr_);
 
     const int V = pocmer_;               // vectors
-    const int M = V * loclin.max_size;   // reserved memory
+    const std::size_t M = std::size_t(V) * loclin.max_size;  // reserved
 
-
-    GNU_gama::SparseMatrix<double, int>*
-       tmp = new GNU_gama::SparseMatrix<double, int>(M, V, 0);
+    delete Asp;
+    Asp = new GNU_gama::SparseMatrix<double, int>(M, V, 0);
 
     b.reset(pocmer_);   // initialisation of base class OLS
     rhs_.reset(pocmer_);
@@ -580,18 +666,17 @@ void LocalNetwork::project_equations()
         obs->accept(&loclin);
         b(++r)  = loclin.rhs;
         rhs_(r) = loclin.rhs;
-        tmp->new_row();
+        Asp->new_row();
         for (long i=0; i<loclin.size; i++)
-            tmp->add_element(loclin.coeff[i], loclin.index[i]);
+            Asp->add_element(loclin.coeff[i], loclin.index[i]);
     }
 
     pocet_neznamych_ = loclin.unknowns();
     A.reset(pocmer_, pocet_neznamych_);   // initialization of base class OLS
     A.set_zero();
 
-    delete Asp;
-    Asp =  tmp->replicate(tmp->nonzeroes(), pocmer_, pocet_neznamych_ );
-    delete tmp;
+    Asp->set_columns(pocet_neznamych_);
+    Asp->shrink_to_fit();
 
     {
       GNU_gama::SparseMatrixGraph<double, int> graph(Asp);
@@ -671,9 +756,11 @@ void LocalNetwork::project_equations()
       return;
     }
 
+  prior_dim_ = 0;
   if (AdjBaseFull* full = dynamic_cast<AdjBaseFull*>(least_squares))
     {
       full->reset(A, b);
+      if (prior_) prior_equations_();
     }
   else if (AdjBaseSparse* sparse = dynamic_cast<AdjBaseSparse*>(least_squares))
     {
@@ -689,7 +776,7 @@ void LocalNetwork::project_equations()
       // ---  cofactors  --------------------------------------------------
 
       int count = 0;   // number of diagonal blocks
-      int msize = 0;   // memory size
+      std::size_t msize = 0;   // memory size
 
       for (ClusterList::const_iterator
              cluster=OD.clusters.begin(); cluster!=OD.clusters.end(); ++cluster)
@@ -698,7 +785,7 @@ void LocalNetwork::project_equations()
           int W = (*cluster)->covariance_matrix.bandWidth();
           W = std::min(N-1, W);         // 2.16.4 ... added to fix the bug in W
           count++;
-          msize += 1+(N+N-W)*(W+1)/2;   // += number of band matrix elements
+          msize += 1+std::size_t(N+N-W)*(W+1)/2;   // += band matrix elements
         }                               // 2.16.4 ... why plus one?
 
       GNU_gama::BlockDiagonal<> *bd = new GNU_gama::BlockDiagonal<>(count, msize);
@@ -735,6 +822,17 @@ void LocalNetwork::project_equations()
   //--opr.write((char*)(&n), sizeof(int));
   //--opr.write((char*)(A.begin()), sizeof(double)*m*n);
 
+  min_x_list_();
+  least_squares->min_x(min_n_, min_x_);
+  s_transf_.reset();
+
+  tst_rov_opr_ = true;
+  update(Adjustment);
+}
+
+
+void LocalNetwork::min_x_list_()
+{
   delete[] min_x_;
   min_x_ = nullptr;
   min_n_ = 0;
@@ -764,10 +862,49 @@ void LocalNetwork::project_equations()
             }
         }
     }
-  least_squares->min_x(min_n_, min_x_);
+}
 
-  tst_rov_opr_ = true;
-  update(Adjustment);
+
+void LocalNetwork::set_datum(const std::vector<PointID>& points)
+{
+  std::set<PointID> datum;
+  for (const PointID& id : points)
+    {
+      PointData::const_iterator i = PD.find(id);
+      if (i == PD.end() || (!(*i).second.free_xy() && !(*i).second.free_z()))
+        throw GNU_gama::local::Exception("Datum: point " + id.str()
+                                         + " is not adjusted");
+      datum.insert(id);
+    }
+
+  for (PointData::iterator i=PD.begin(); i!=PD.end(); ++i)
+    {
+      LocalPoint& p = (*i).second;
+      const bool c = datum.count((*i).first) != 0;
+      if (p.free_xy()) c ? p.set_constrained_xy() : p.set_free_xy();
+      if (p.free_z())  c ? p.set_constrained_z()  : p.set_free_z();
+    }
+
+  // regularization of the next adjustment is given by constrained points
+
+  if (!tst_rov_opr_) return;
+
+  s_transf_.reset();
+  if (tst_vyrovnani_)
+    {
+      min_x_list_();
+
+      using STrans = GNU_gama::STransformation<double, int, MVE>;
+      auto s = std::make_unique<STrans>();
+      if (s->reset(least_squares, min_n_, min_x_))
+        {
+          s_transf_ = std::move(s);
+          update(Adjustment);
+          return;
+        }
+    }
+
+  update(Points);
 }
 
 
@@ -782,6 +919,12 @@ bool LocalNetwork::singular_coords(const Mat& A)
     {
       LocalPoint&  p  = (*i).second;
       if (p.fixed_xy() || !p.active_xy()) continue;
+      if (prior_ && p.index_x())
+        {
+          auto q = prior_->points.find((*i).first);
+          if (q != prior_->points.end() && (*q).second.indx)
+            continue;            // coordinates with prior information
+        }
 
       if(p.index_x() == 0 || p.index_y() == 0)
       {
@@ -896,6 +1039,7 @@ void LocalNetwork::conf_pr(double p)
   if (p <= 0 || p >= 1)
     throw GNU_gama::local::Exception(T_LN_undefined_confidence_level);
   konf_pr_ = p;
+  tst_results_ = false;
 }
 
 
@@ -930,7 +1074,7 @@ double LocalNetwork::m_0_aposteriori_value()
 }
 
 
-double LocalNetwork::conf_int_coef()
+double LocalNetwork::conf_int_coef_()
 {
   using namespace GNU_gama::local;
 
@@ -1033,8 +1177,6 @@ int LocalNetwork::null_space()
 void LocalNetwork::std_error_ellipse(const PointID& cb,
                                      double& a, double& b, double& alfa)
 {
-  using namespace std;
-
   // stashed ellipses are needed only in SVG drawing from adjustment XML
   auto p = stashed_ellipses.find(cb);
   if (p != stashed_ellipses.end())
@@ -1045,25 +1187,10 @@ void LocalNetwork::std_error_ellipse(const PointID& cb,
       return;
   }
 
-  const LocalPoint& bod = PD[cb];
-  int iy = bod.index_y();
-  int ix = bod.index_x();
-  double cyy = least_squares->q_xx(iy,iy);
-  double cyx = least_squares->q_xx(iy,ix);
-  double cxx = least_squares->q_xx(ix,ix);
-  double c = sqrt((cxx-cyy)*(cxx-cyy) + 4*cyx*cyx);
-  b = (cyy+cxx-c)/2;
-  if (b < 0) b = 0;
-
-  double m = m_0();
-  a = m * sqrt(b+c);
-  b = m * sqrt(b);
-  if (c == 0) {
-     alfa = 0;
-     return;
-  }
-  alfa = atan2(2*cyx, cxx-cyy)/2;
-  if (alfa < 0) alfa += M_PI;
+  const Results::Ellipse& e = results().ellipse[PD[cb].index_y()];
+  a    = e.a;
+  b    = e.b;
+  alfa = e.alfa;
 }
 
 // 1.7.09 added optional update of constrained coordinates; inspired
@@ -1079,7 +1206,7 @@ void LocalNetwork::stash_std_error_ellipse(const PointID& cb,
 
 void LocalNetwork::refine_approx_coordinates()
 {
-  const Vec& x = least_squares->unknowns();
+  const Vec& x = s_transf_ ? s_transf_->unknowns() : least_squares->unknowns();
 
   for (int i=1; i<=unknowns_count(); i++)
     if (unknown_type(i) == 'X')
@@ -1154,15 +1281,28 @@ void LocalNetwork::forwardSubstitution(const CovMat& chol, Vec& v)
 
 void LocalNetwork::prepareProjectEquations()
 {
-  int ind_0 = 0;
+  // clusters are decorrelated independently, each of them on its own
+  // block of rows in A and b
 
+  std::vector<std::pair<const Cluster_*, int>> blocks;   // cluster, ind_0
+  int ind_0 = 0;
   for (const auto cluster : OD.clusters)
     if (const int N = cluster->activeObs())
+      {
+        blocks.emplace_back(cluster, ind_0);
+        ind_0 += N;
+      }
+
+  auto decorrelate = [this, &blocks](std::size_t first, std::size_t last)
+    {
+      for (std::size_t n=first; n<last; n++)
         {
+          const Cluster_* cluster = blocks[n].first;
+          const int       ind_0   = blocks[n].second;
+          const int       N       = cluster->activeObs();
+
           Vec t(N);
-          CovMat C = cluster->activeCov();
-          C /= (m_0_apr_*m_0_apr_);        // covariances ==> cofactors
-          Adj::choldec(C);                 // cofactors   ==> weights
+          const CovMat& C = cluster->activeChol(m_0_apr_*m_0_apr_);
 
           for (int j=1; j<=A.cols(); j++)
             {
@@ -1182,9 +1322,11 @@ void LocalNetwork::prepareProjectEquations()
           for (int k=1; k<=N; k++) t(k) = b(ind_0+k);
           Adj::forwardSubstitution(C, t);
           for (int l=1; l<=N; l++) b(ind_0+l) = t(l);
-
-          ind_0 += N;
         }
+    };
+
+  GNU_gama::parallel_for(std::size_t(0), blocks.size(), std::size_t(8),
+                         decorrelate);
 }
 
 
@@ -1216,9 +1358,9 @@ void LocalNetwork::vyrovnani_()
         if (!P.free_xy() && !P.free_z()) continue;
 
         double tx=0, ty=0, tz=0;
-        if (int ix = P.index_x()) tx =m_0_apr_*sqrt(least_squares->q_xx(ix,ix));
-        if (int iy = P.index_y()) ty =m_0_apr_*sqrt(least_squares->q_xx(iy,iy));
-        if (int iz = P.index_z()) tz=m_0_apr_*sqrt(least_squares->q_xx(iz,iz));
+        if (int ix = P.index_x()) tx =m_0_apr_*sqrt(qxx(ix,ix));
+        if (int iy = P.index_y()) ty =m_0_apr_*sqrt(qxx(iy,iy));
+        if (int iz = P.index_z()) tz=m_0_apr_*sqrt(qxx(iz,iz));
 
         bool bxy = (tx > 1e4) || (ty > 1e4);
         bool bz  = (tz > 1e4);
@@ -1260,9 +1402,7 @@ void LocalNetwork::vyrovnani_()
       if (const int N = (*cluster)->activeObs())
         {
           Vec t(N), u(N);
-          CovMat C = (*cluster)->activeCov();
-          C /= (m_0_apr_*m_0_apr_);
-          Adj::choldec(C);
+          const CovMat& CC = (*cluster)->activeChol(m_0_apr_*m_0_apr_);
 
           for (int k=1; k<=N; k++)
             {
@@ -1270,7 +1410,6 @@ void LocalNetwork::vyrovnani_()
               t(k) = tmp;
               suma_pvv_ += tmp*tmp;
             }
-          const CovMat&  CC = C;
           const int b  = CC.bandWidth();
           {
             for (int m, i=1; i<=N; i++)
@@ -1286,6 +1425,8 @@ void LocalNetwork::vyrovnani_()
 
           ind_0 += N;
         }
+
+    if (prior_) suma_pvv_ = full->sum_of_squares();  // including prior
   }
   else if (AdjBaseSparse* sparse = dynamic_cast<AdjBaseSparse*>(least_squares))
     {
@@ -1298,10 +1439,37 @@ void LocalNetwork::vyrovnani_()
     }
 
 
+  vyrovnani_results_();
+}
+
+
+void LocalNetwork::vyrovnani_results_()
+{
+  Results& R = results_;
+  tst_results_ = false;
+
   { /* ----------------------------------------------------------------- */
-    sigma_L.reset(pocmer_);
+    // weight coefficients of adjusted observations; the first q_bb() call
+    // is serial to complete any pending lazy computation in the solver,
+    // the remaining ones are independent
+
+    R.qbb_diag.reset(pocmer_);
+    if (pocmer_ > 0) R.qbb_diag(1) = least_squares->q_bb(1, 1);
+
+    GNU_gama::parallel_for(2, pocmer_+1, 64, [this](int first, int last)
+                           {
+                             for (int i=first; i<last; i++)
+                               results_.qbb_diag(i) = least_squares->q_bb(i, i);
+                           });
+  }
+
+  R.m_0 = m_0();
+  R.conf_int_coef = conf_int_coef_();
+
+  { /* ----------------------------------------------------------------- */
+    R.stdev_obs.reset(pocmer_);
 
-    double MM = m_0() / m_0_apr_;
+    double MM = R.m_0 / m_0_apr_;
     int ind_0 = 0;
 
     for (ClusterList::const_iterator
@@ -1322,7 +1490,7 @@ void LocalNetwork::vyrovnani_()
                 if ((*i)->active())
                   {
                     // sigma_L = m0() * sqrt(least_squares->q_bb(n,n)) / weight_l
-                    sigma_L(n) = MM * sqrt(least_squares->q_bb(n,n)) * (*i)->stdDev();
+                    R.stdev_obs(n) = MM * sqrt(R.qbb_diag(n)) * (*i)->stdDev();
                     n++;
                   }
             }
@@ -1333,49 +1501,117 @@ void LocalNetwork::vyrovnani_()
 
 
   { /* ----------------------------------------------------------------- */
-    vahkopr.reset(pocmer_);
+    R.wcoef_res.reset(pocmer_);
+    R.stdev_res.reset(pocmer_);
+    R.studentized_residual.reset(pocmer_);
+    R.obs_control.reset(pocmer_);
 
     for (int i=1; i<=pocmer_; i++)
       {
         // F.Charamza: Geodet/PC p. 171
         // 1.1.56 double  qv = (1.0 - q_bb(i, i))/w(i);
-        double  qv = (1.0 - least_squares->q_bb(i, i))/ weight_obs(i);
-        vahkopr(i) = (qv >= 0) ? qv : 0;       // removing noise
+        double  qv = (1.0 - R.qbb_diag(i))/ weight_obs(i);
+        R.wcoef_res(i) = (qv >= 0) ? qv : 0;       // removing noise
+
+        const double sr = R.m_0*sqrt(fabs(R.wcoef_res(i)));
+        R.stdev_res(i) = sr;
+        R.studentized_residual(i) = sr > 0 ? r(i)/sr : 0;
+
+        /*
+         * It is supposed that standard deviation mL of adjusted
+         * observation is derived from apriori reference standard
+         * deviation m0 (ml is standard deviation of the
+         * observation). F. Charamza: Geodet/PC, Zdiby 1990
+         * p. 180.
+         *
+         *      f = 100*(ml - mL)/ml
+         *
+         *      f < 0.1%     uncontrolled observation
+         *      f < 5%       weakly controlled observation
+         */
+        // 1.1.20 return 100*fabs((1-sqrt(q_bb(i,i)*w(i))));
+        R.obs_control(i) = 100*fabs(1-sqrt(R.qbb_diag(i)));
+      }
+  }
+
+
+  { /* ----------------------------------------------------------------- */
+    // standard deviations of unknowns and error ellipses
+
+    const int N = unknowns_count();
+    R.unknown_stdev.reset(N);
+    for (int i=1; i<=N; i++)
+      R.unknown_stdev(i) = R.m_0*sqrt(qxx(i, i));
+
+    R.ellipse.assign(N+1, Results::Ellipse());
+    for (PointData::const_iterator i=PD.begin(); i!=PD.end(); ++i)
+      {
+        const LocalPoint& bod = (*i).second;
+        const int iy = bod.index_y();
+        const int ix = bod.index_x();
+        if (!iy || !ix) continue;
+
+        Results::Ellipse& e = R.ellipse[iy];
+        const double cyy = e.cyy = qxx(iy,iy);
+        const double cyx = e.cxy = qxx(iy,ix);
+        const double cxx = e.cxx = qxx(ix,ix);
+        double c = sqrt((cxx-cyy)*(cxx-cyy) + 4*cyx*cyx);
+        double b = (cyy+cxx-c)/2;
+        if (b < 0) b = 0;
+
+        e.a = R.m_0 * sqrt(b+c);
+        e.b = R.m_0 * sqrt(b);
+        if (c == 0)
+          {
+            e.alfa = 0;
+            continue;
+          }
+        e.alfa = atan2(2*cyx, cxx-cyy)/2;
+        if (e.alfa < 0) e.alfa += M_PI;
       }
   }
 
+  tst_results_ = true;
 }
 
 
 std::string LocalNetwork::export_xml(std::string version)
 {
-  std::string xml =
-    "<?xml version=\"1.0\" ?>\n";
+  std::ostringstream xml;
+  export_xml(xml, version);
+  return xml.str();
+}
+
+void LocalNetwork::export_xml(std::ostream& stream, std::string version)
+{
+  GNU_gama::StreamWriter out(stream);
+
+  out << "<?xml version=\"1.0\" ?>\n";
 
-  if (!version.empty()) xml += version;  // optional xml comment
+  if (!version.empty()) out << version;  // optional xml comment
 
-  xml +=
+  out <<
     "<gama-local xmlns=\"http://www.gnu.org/software/gama/gama-local\">\n"
     "<network axes-xy=";
 
   switch(PD.local_coordinate_system)
     {
-    case LocalCoordinateSystem::CS::EN: xml += "\"en\""; break;
-    case LocalCoordinateSystem::CS::NW: xml += "\"nw\""; break;
-    case LocalCoordinateSystem::CS::SE: xml += "\"se\""; break;
-    case LocalCoordinateSystem::CS::WS: xml += "\"ws\""; break;
-    case LocalCoordinateSystem::CS::NE: xml += "\"ne\""; break;
-    case LocalCoordinateSystem::CS::SW: xml += "\"sw\""; break;
-    case LocalCoordinateSystem::CS::ES: xml += "\"es\""; break;
-    case LocalCoordinateSystem::CS::WN: xml += "\"wn\""; break;
+    case LocalCoordinateSystem::CS::EN: out << "\"en\""; break;
+    case LocalCoordinateSystem::CS::NW: out << "\"nw\""; break;
+    case LocalCoordinateSystem::CS::SE: out << "\"se\""; break;
+    case LocalCoordinateSystem::CS::WS: out << "\"ws\""; break;
+    case LocalCoordinateSystem::CS::NE: out << "\"ne\""; break;
+    case LocalCoordinateSystem::CS::SW: out << "\"sw\""; break;
+    case LocalCoordinateSystem::CS::ES: out << "\"es\""; break;
+    case LocalCoordinateSystem::CS::WN: out << "\"wn\""; break;
     default:
-      xml +=  "\"ne\""; break;
+      out <<  "\"ne\""; break;
     }
 
-  xml += " angles=";
-  xml += PD.left_handed_angles() ? "\"left-handed\"" : "\"right-handed\"";
-  if (has_epoch()) xml += " epoch=\"" + to_xmlstr(epoch()) + "\"";
-  xml += ">\n";
+  out << " angles=";
+  out << (PD.left_handed_angles() ? "\"left-handed\"" : "\"right-handed\"");
+  if (has_epoch()) out << " epoch=\"" << to_xmlstr(epoch()) << "\"";
+  out << ">\n";
 
 
   if (!description.empty())
@@ -1387,33 +1623,33 @@ std::string LocalNetwork::export_xml(std::string version)
           else descr += c;
         }
 
-      xml += "\n<description>" + descr + "</description>\n";
+      out << "\n<description>" << descr << "</description>\n";
     }
-  xml += "\n<parameters\n";
-  xml += "  sigma-apr=\"" + to_xmlstr(apriori_m_0(), 8) + "\"\n";
-  xml += "  conf-pr=\""   + to_xmlstr(conf_pr(), 8)     + "\"\n";
-  xml += "  tol-abs=\""   + to_xmlstr(tol_abs(), 8)     + "\"\n";
-  xml += "  sigma-act=\"";
-  xml +=         m_0_apriori() ? "apriori\"\n" : "aposteriori\"\n";
-  xml += "  angles=\"" + std::string(gons() ? "400" : "360") + "\"\n";
-  if (has_algorithm()) xml += "  algorithm=\"" + algorithm() + "\"\n";
+  out << "\n<parameters\n";
+  out << "  sigma-apr=\"" << to_xmlstr(apriori_m_0(), 8) << "\"\n";
+  out << "  conf-pr=\""   << to_xmlstr(conf_pr(), 8)     << "\"\n";
+  out << "  tol-abs=\""   << to_xmlstr(tol_abs(), 8)     << "\"\n";
+  out << "  sigma-act=\"";
+  out << (m_0_apriori() ? "apriori\"\n" : "aposteriori\"\n");
+  out << "  angles=\"" << std::string(gons() ? "400" : "360") << "\"\n";
+  if (has_algorithm()) out << "  algorithm=\"" << algorithm() << "\"\n";
   if (has_latitude())
-    xml += "  latitude=\"" + to_xmlstr(latitude()) + "\"\n";
-  if (has_ellipsoid()) xml += "  ellipsoid=\"" + ellipsoid() + "\"\n";
-  xml += "  cov-band=\"" + to_xmlstr(adj_covband()) + "\"\n";
+    out << "  latitude=\"" << to_xmlstr(latitude()) << "\"\n";
+  if (has_ellipsoid()) out << "  ellipsoid=\"" << ellipsoid() << "\"\n";
+  out << "  cov-band=\"" << to_xmlstr(adj_covband()) << "\"\n";
   // iterations ... not implemented in XML input
   // language .....
   // encoding .....
-  xml += "/>\n";
+  out << "/>\n";
 
 
-  xml += "\n<points-observations \n";
+  out << "\n<points-observations \n";
   // implicit parameters
   // xml += "   distance-stdev=  '5.0' \n";
   // xml += "   direction-stdev= '10.0' \n";
   // xml += "   angle-stdev=     '10.0' \n";
   // xml += "   azimuth-stdev=   '10.0' \n";
-  xml += "   >\n\n";
+  out << "   >\n\n";
 
 
   for (auto p=PD.begin(); p!=PD.end(); ++p)
@@ -1422,15 +1658,15 @@ std::string LocalNetwork::export_xml(std::string version)
       LocalPoint point = p->second;
       if (!point.active()) continue;
 
-      xml += "<point id=\"" + id.str() + "\"";
+      out << "<point id=\"" << id.str() << "\"";
 
       if (point.test_xy()) {
-        xml += " x=\"" + to_xmlstr(point.x(), 16) + "\"";
-        xml += " y=\"" + to_xmlstr(y_sign()*point.y(), 16) + "\"";
+        out << " x=\"" << to_xmlstr(point.x(), 16) << "\"";
+        out << " y=\"" << to_xmlstr(y_sign()*point.y(), 16) << "\"";
       }
 
       if (point.test_z()) {
-          xml += " z=\"" + to_xmlstr(point.z()) + "\"";
+          out << " z=\"" << to_xmlstr(point.z()) << "\"";
       }
 
       std::string fix {}, adj {};
@@ -1442,10 +1678,10 @@ std::string LocalNetwork::export_xml(std::string version)
       else if (point.constrained_z())  adj += "Z";
       else if (point.free_z())         adj += "z";
 
-      if (!fix.empty()) xml += " fix=\"" + fix + "\"";
-      if (!adj.empty()) xml += " adj=\"" + adj + "\"";
+      if (!fix.empty()) out << " fix=\"" << fix << "\"";
+      if (!adj.empty()) out << " adj=\"" << adj << "\"";
 
-      xml += " />\n";
+      out << " />\n";
     }
 
 
@@ -1455,92 +1691,92 @@ std::string LocalNetwork::export_xml(std::string version)
     if (auto cluster = dynamic_cast<StandPoint*>(*c))
       {
         auto cluster_from = cluster->station.str();
-        xml += "\n<obs";
+        out << "\n<obs";
         if (!cluster_from.empty())
           {
-            xml += " from=\"" + cluster->station.str() + "\"";
+            out << " from=\"" << cluster->station.str() << "\"";
           }
-        xml += ">\n";
+        out << ">\n";
 
         for (auto p  = cluster->observation_list.begin();
                   p != cluster->observation_list.end(); ++p) {
           Observation* obs = *p;
           obs->accept(&info);
 
-          xml += "<" +  info.xml_name;
+          out << "<" <<  info.xml_name;
           if (!info.str_from.empty()) {
               if (cluster_from != info.str_from) {
-                  xml += " from=\"" + info.str_from + "\"";
+                  out << " from=\"" << info.str_from << "\"";
                 }
             }
           if (!info.str_to.empty()) {
-            xml += " to=\"" + info.str_to + "\"";
+            out << " to=\"" << info.str_to << "\"";
             double fdh = obs->from_dh();
             double tdh = obs->to_dh();
-            if (fdh) xml += " from_dh=\"" + to_xmlstr(fdh, 8) + "\"";
-            if (tdh) xml +=   " to_dh=\"" + to_xmlstr(tdh, 8) + "\"";
+            if (fdh) out << " from_dh=\"" << to_xmlstr(fdh, 8) << "\"";
+            if (tdh) out <<   " to_dh=\"" << to_xmlstr(tdh, 8) << "\"";
           }
           else if (!info.str_bs.empty()) {
-            xml += " bs=\"" + info.str_bs + "\"";
-            xml += " fs=\"" + info.str_fs + "\"";
+            out << " bs=\"" << info.str_bs << "\"";
+            out << " fs=\"" << info.str_fs << "\"";
 
             Angle* a = static_cast<Angle*>(obs);
             double rdh = a->from_dh();
             double bdh = a->bs_dh();
             double fdh = a->fs_dh();
-            if (rdh) xml += " from_dh=\"" + to_xmlstr(rdh, 8) + "\"";
-            if (bdh) xml +=   " bs_dh=\"" + to_xmlstr(bdh, 8) + "\"";
-            if (fdh) xml +=   " fs_dh=\"" + to_xmlstr(fdh, 8) + "\"";
+            if (rdh) out << " from_dh=\"" << to_xmlstr(rdh, 8) << "\"";
+            if (bdh) out <<   " bs_dh=\"" << to_xmlstr(bdh, 8) << "\"";
+            if (fdh) out <<   " fs_dh=\"" << to_xmlstr(fdh, 8) << "\"";
           }
-          xml += " val=\"" + info.str_val + "\"";
-          xml += " stdev=\"" + info.str_stdev + "\"";
-          xml += " />\n";
+          out << " val=\"" << info.str_val << "\"";
+          out << " stdev=\"" << info.str_stdev << "\"";
+          out << " />\n";
         }
 
-        updated_xml_covmat(xml, cluster->covariance_matrix, false);
-         xml += "</obs>\n";
+        updated_xml_covmat(out, cluster->covariance_matrix, false);
+         out << "</obs>\n";
       }
     else if (auto cluster = dynamic_cast<HeightDifferences*>(*c))
       {
-        xml += "\n<height-differences>\n";
+        out << "\n<height-differences>\n";
         for (auto p  = cluster->observation_list.begin();
                   p != cluster->observation_list.end(); ++p) {
           Observation* obs = *p;
           obs->accept(&info);
 
-         xml += "<" +  info.xml_name;
-         xml += " from=\"" + info.str_from + "\"";
-         xml += " to=\"" + info.str_to + "\"";
-         xml += " val=\"" + info.str_val + "\"";
+         out << "<" <<  info.xml_name;
+         out << " from=\"" << info.str_from << "\"";
+         out << " to=\"" << info.str_to << "\"";
+         out << " val=\"" << info.str_val << "\"";
 
          double dist = 0;
          if (H_Diff* p = dynamic_cast<H_Diff*>(obs)) dist = p->dist();
          if (dist > 0)
-           xml += " dist=\"" +to_xmlstr(dist) + "\"";
+           out << " dist=\"" << to_xmlstr(dist) << "\"";
          else
-           xml += " stdev=\"" + info.str_stdev + "\"";
-         xml += "/>\n";
+           out << " stdev=\"" << info.str_stdev << "\"";
+         out << "/>\n";
         }
 
-        updated_xml_covmat(xml, cluster->covariance_matrix, false);
-        xml += "</height-differences>\n";
+        updated_xml_covmat(out, cluster->covariance_matrix, false);
+        out << "</height-differences>\n";
       }
     else if (auto cluster = dynamic_cast<Coordinates*>(*c))
       {
-        xml += "\n<coordinates>\n";
+        out << "\n<coordinates>\n";
         for (auto p  = cluster->observation_list.begin();
                   p != cluster->observation_list.end(); ++p) {
           Observation* obs = *p;
           obs->accept(&info);
           std::string from = info.str_from;
-          xml += "<point id=\"" + from + "\"";
+          out << "<point id=\"" << from << "\"";
           if (info.xml_name == "x")
             {
-              xml += " x=\"" + info.str_val + "\"";
+              out << " x=\"" << info.str_val << "\"";
               ++p;
               (*p)->accept(&info);
 
-              xml += " y=\"" + info.str_val + "\"";
+              out << " y=\"" << info.str_val << "\"";
               auto q = p;
               ++q;
               if (q != cluster->observation_list.end())
@@ -1556,79 +1792,76 @@ std::string LocalNetwork::export_xml(std::string version)
             }
           if (info.xml_name == "z")
             {
-              xml += " z=\"" + info.str_val + "\"";
+              out << " z=\"" << info.str_val << "\"";
             }
-          xml += " />\n";
+          out << " />\n";
         }
 
-        updated_xml_covmat(xml, cluster->covariance_matrix, true);
-        xml += "</coordinates>\n";
+        updated_xml_covmat(out, cluster->covariance_matrix, true);
+        out << "</coordinates>\n";
       }
     else if (auto cluster = dynamic_cast<Vectors*>(*c))
       {
-        xml += "\n<vectors>\n";
+        out << "\n<vectors>\n";
 
         for (auto p  = cluster->observation_list.begin();
                   p != cluster->observation_list.end(); ++p) {
           Observation* obs = *p;
           obs->accept(&info);
 
-          xml += "<vec from=\"" +info.str_from+ "\" to=\"" +info.str_to+ "\"";
+          out << "<vec from=\"" +info.str_from+ "\" to=\"" +info.str_to+ "\"";
           obs->accept(&info);
-          xml += " dx=\"" + info.str_val + "\"";
+          out << " dx=\"" << info.str_val << "\"";
           (*++p)->accept(&info);
-          xml += " dy=\"" + info.str_val + "\"";
+          out << " dy=\"" << info.str_val << "\"";
           (*++p)->accept(&info);
-          xml += " dz=\"" + info.str_val + "\"";
+          out << " dz=\"" << info.str_val << "\"";
 
           // double fdh = (*p)->from_dh(); ... unrealistic
           // double tdh = (*p)->to_dh();
           // if (fdh) xml += " from_dh=\"" + xml_string(fdh, 8) + "\"";
           // if (tdh) xml +=   " to_dh=\"" + xml_string(tdh, 8) + "\"";
-          xml += " />\n";
+          out << " />\n";
         }
 
-        updated_xml_covmat(xml, cluster->covariance_matrix, true);
-        xml += "\n</vectors>\n";
+        updated_xml_covmat(out, cluster->covariance_matrix, true);
+        out << "\n</vectors>\n";
       }
     else
       {
-        xml += "\n### Undefined cluster\n";
+        out << "\n### Undefined cluster\n";
       }
   }
 
 
-  xml +=
+  out <<
     "\n</points-observations>\n"
     "\n</network>\n"
     "</gama-local>\n";
-
-  return xml;
 }
 
-void LocalNetwork::updated_xml_covmat(std::string& xml, const CovMat& C,
-                                      bool always)
+void LocalNetwork::updated_xml_covmat(GNU_gama::StreamWriter& out,
+                                      const CovMat& C, bool always)
 {
   int  dim  = C.dim();
   int  band = C.bandWidth();
   if (!always && band == 0) return;
 
-  xml += "\n<cov-mat dim=\"" + to_string(dim) + "\"";
-  xml += " band=\"" + to_string(band) + "\">\n";
+  out << "\n<cov-mat dim=\"" << dim << "\"";
+  out << " band=\"" << band << "\">\n";
+  out.setf(ios_base::scientific, ios_base::floatfield);
+  out.precision(16);
   for (int i=1; i<=dim; i++)
     {
-      std::ostringstream out;
-      out.setf(ios_base::scientific, ios_base::floatfield);
-      out.precision(16);
       out << "\n";
       for (int n=1, j=i; j<=i+band && j <=dim; j++, n++)
         {
-          out << setw(24) << C(i,j) << ((n%3 == 0 && j != dim) ? "\n" : " ");
+          out.width(24);
+          out << C(i,j) << ((n%3 == 0 && j != dim) ? "\n" : " ");
         }
       out << "\n";
-      xml += out.str();
     }
-  xml += "\n</cov-mat>\n";
+  out << "\n</cov-mat>\n";
 }
 
 bool LocalNetwork::consistent() const
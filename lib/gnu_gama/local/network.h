@@ -29,17 +29,22 @@
 #include <fstream>
 #include <iomanip>
 #include <list>
+#include <memory>
 #include <gnu_gama/exception.h>
+#include <gnu_gama/streamwriter.h>
 #include <gnu_gama/local/gamadata.h>
 #include <gnu_gama/adj/adj_basefull.h>
 #include <gnu_gama/adj/adj_basesparse.h>
 #include <gnu_gama/local/cluster.h>
 #include <gnu_gama/local/local_revision.h>
 #include <gnu_gama/adj/adj.h>
+#include <gnu_gama/adj/s_transformation.h>
 
 namespace GNU_gama { namespace local
 {
 
+  class EpochPrior;
+
   class LocalNetwork
   {
     using MVE = GNU_gama::Exception::matvec;
@@ -121,7 +126,11 @@ namespace GNU_gama { namespace local
     void project_equations();
     void project_equations(std::ostream&);
     void project_equations(Mat& A, Vec& b, Vec& w);
-    double conf_int_coef();
+    const Mat& homogenized_design_matrix()
+    {
+      project_equations(); return A;
+    }
+    double conf_int_coef() { return results().conf_int_coef; }
     int min_n() const
     {
       return min_n_;
@@ -135,8 +144,7 @@ namespace GNU_gama { namespace local
     StandPoint* unknown_standpoint(int i) const { return unknowns_[i-1].ori; }
     double      unknown_stdev     (int i)
     {
-      using namespace std;
-      return m_0()*sqrt(least_squares->q_xx(i, i));
+      return results().unknown_stdev(i);
     }
 
 
@@ -176,7 +184,7 @@ namespace GNU_gama { namespace local
     const Vec& solve()
     {
       vyrovnani_();
-      return least_squares->unknowns();
+      return s_transf_ ? s_transf_->unknowns() : least_squares->unknowns();
     }
     const Vec& residuals()
     {
@@ -196,7 +204,7 @@ namespace GNU_gama { namespace local
     int degrees_of_freedom()
     {
       vyrovnani_();
-      return A.rows() - A.cols() + least_squares->defect();
+      return A.rows() - A.cols() + least_squares->defect() + prior_dim_;
     }
     int null_space();
 
@@ -204,48 +212,43 @@ namespace GNU_gama { namespace local
     double m_0();
     double apriori_m_0() const   { return m_0_apr_; }
 
-    double qxx(int i, int j) { return least_squares->q_xx(i,j); }
+    double qxx(int i, int j)
+    {
+      return s_transf_ ? s_transf_->q_xx(i,j) : least_squares->q_xx(i,j);
+    }
+    /** products Q_xx*B computed for all columns of B in one batch */
+    void qxx_batch(Mat& B)
+    {
+      vyrovnani_();
+      if (s_transf_) s_transf_->q_xx_batch(B);
+      else least_squares->q_xx_batch(B);
+    }
     double qbb(int i, int j) { return least_squares->q_bb(i,j); }
-    double qbx(int i, int j) { return least_squares->q_bx(i,j); }
+    double qbx(int i, int j)
+    {
+      return s_transf_ ? s_transf_->q_bx(i,j) : least_squares->q_bx(i,j);
+    }
 
     double cond();
     bool lindep(int i);
 
     void refine_approx_coordinates();
 
-    void   apriori_m_0(double m)  { m_0_apr_ = m; }
+    void   apriori_m_0(double m)  { m_0_apr_ = m; update(Adjustment); }
     void   tol_abs(double m)      { tol_abs_ = m; }
     double tol_abs() const        { return tol_abs_; }
 
-    double stdev_obs(int i) { return sigma_L(i); }
-    double wcoef_res(int i) { return vahkopr(i); }
-    double stdev_res(int i)
-    {
-      using namespace std;
-      return m_0()*sqrt(fabs(wcoef_res(i)));
-    }
+    double stdev_obs(int i) { return results().stdev_obs(i); }
+    double wcoef_res(int i) { return results().wcoef_res(i); }
+    double stdev_res(int i) { return results().stdev_res(i); }
 
     double studentized_residual(int i)
     {
-      return stdev_res(i) > 0 ? residuals()(i)/stdev_res(i) : 0;
+      return results().studentized_residual(i);
     }
     double obs_control(int i)
     {
-      /*
-       * It is supposed that standard deviation mL of adjusted
-       * observation is derived from apriori reference standard
-       * deviation m0 (ml is standard deviation of the
-       * observation). F. Charamza: Geodet/PC, Zdiby 1990
-       * p. 180.
-       *
-       *      f = 100*(ml - mL)/ml
-       *
-       *      f < 0.1%     uncontrolled observation
-       *      f < 5%       weakly controlled observation
-       */
-      // 1.1.20 return 100*fabs((1-sqrt(q_bb(i,i)*w(i))));
-      using namespace std;
-      return 100*fabs(1-sqrt(least_squares->q_bb(i,i)));
+      return results().obs_control(i);
     }
     void std_error_ellipse(const PointID&, double& a,
                            double& b, double& alfa);
@@ -253,14 +256,55 @@ namespace GNU_gama { namespace local
         const PointID&, double a, double b, double alfa);
 
 
+    // ...  results of adjustment  .........................................
+
+    /** \brief Results of adjustment shared by all output writers.
+     *
+     * Computed once after the adjustment. Vectors are indexed by
+     * unknowns and observations of the design matrix (1 based).
+     * Changes of the type of m_0 or of the confidence probability
+     * recompute only the results, the a priori m_0 weights the project
+     * equations and its change invalidates the adjustment.
+     *
+     * Once results() has been called, accessors of the adjusted network
+     * only read its data and output writers can run concurrently.
+     */
+    struct Results
+    {
+      double m_0 {0};              // actual reference standard deviation
+      double conf_int_coef {0};    // coefficient of confidence intervals
+      Vec    unknown_stdev;        // standard deviations of unknowns
+      Vec    qbb_diag;             // weight coefficients of adjusted obs.
+      Vec    stdev_obs;            // std. deviations of adjusted obs.
+      Vec    wcoef_res;            // weight coefficients of residuals
+      Vec    stdev_res;            // std. deviations of residuals
+      Vec    studentized_residual;
+      Vec    obs_control;          // observation control 100*(1-sqrt(qbb))
+
+      struct Ellipse               // xy weight coefficients and
+      {                            // standard error ellipse of a point
+        double cxx, cxy, cyy;
+        double a, b, alfa;
+      };
+      std::vector<Ellipse> ellipse;   // indexed by index_y() of points
+    };
+
+    const Results& results()
+    {
+      vyrovnani_();
+      if (!tst_results_) vyrovnani_results_();
+      return results_;
+    }
+
+
     // ...  parameters of statistic analysis  ...............................
 
     bool m_0_apriori    () const { return typ_m_0_ == apriorni_;  }
     bool m_0_aposteriori() const { return typ_m_0_ == empiricka_; }
     double m_0_aposteriori_value();
 
-    void set_m_0_apriori    ()   { typ_m_0_ = apriorni_; }
-    void set_m_0_aposteriori()   { typ_m_0_ = empiricka_; }
+    void set_m_0_apriori    ()   { typ_m_0_ = apriorni_;  tst_results_ = false; }
+    void set_m_0_aposteriori()   { typ_m_0_ = empiricka_; tst_results_ = false; }
 
     double conf_pr() const       { return konf_pr_; }
     void   conf_pr(double p);
@@ -274,8 +318,8 @@ namespace GNU_gama { namespace local
 
     bool gons()    const { return  gons_; }
     bool degrees() const { return !gons_; }
-    void set_gons()      { gons_ = true;  Observation::gons = true;  }
-    void set_degrees()   { gons_ = false; Observation::gons = false; }
+    void set_gons()      { gons_ = true;  }
+    void set_degrees()   { gons_ = false; }
 
     // sign 0  conversion without sign
     //      1  sign left-padded
@@ -304,6 +348,28 @@ namespace GNU_gama { namespace local
     bool        correction_to_ellipsoid() const;
     void        clear_nullable_data();
 
+    // ... sequential adjustment of epochs .................................
+
+    /** Adjusted coordinates and covariances of the previous epoch are
+     * used as prior information, unknowns are updated by observations
+     * of this epoch. Missing approximate coordinates of adjusted points
+     * are set to their prior values.
+     */
+    void set_prior(const EpochPrior& prior);
+    bool has_prior() const { return prior_ != nullptr; }
+    const EpochPrior* prior() const { return prior_.get(); }
+    int  prior_dim() { project_equations(); return prior_dim_; }
+
+    // ... datum of free networks ..........................................
+
+    /** Adjusted coordinates of listed points are constrained, the others
+     * are free. Unknowns of an adjusted network and their cofactors are
+     * S-transformed to the new datum if the algorithm provides the null
+     * space basis, otherwise they are computed again by the algorithm.
+     */
+    void set_datum(const std::vector<PointID>& points);
+    bool s_transformed() const { return s_transf_ != nullptr; }
+
     // ... linearization iterations ........................................
 
     void set_max_linearization_iterations(int value=5);
@@ -316,6 +382,7 @@ namespace GNU_gama { namespace local
     bool refine_adjustment();
 
     std::string export_xml(std::string version=std::string());
+    void export_xml(std::ostream&, std::string version=std::string());
 
     // ... verbose output ..................................................
 
@@ -331,7 +398,15 @@ namespace GNU_gama { namespace local
 
   private:
 
-    void updated_xml_covmat(std::string& xml, const CovMat& C, bool always);
+    void updated_xml_covmat(GNU_gama::StreamWriter& out, const CovMat& C,
+                            bool always);
+
+    std::unique_ptr<GNU_gama::STransformation<double, int, MVE>> s_transf_;
+    void        min_x_list_();
+
+    std::shared_ptr<const EpochPrior> prior_;
+    int         prior_dim_ {0};       // unknowns with prior information
+    void        prior_equations_();
 
     int         adj_covband_;         // output XML xyz cov bandWidth
     int         max_linearization_iterations_;
@@ -383,8 +458,7 @@ namespace GNU_gama { namespace local
     Vec b;
     Vec rhs_;             // right-hand side
     Vec r;
-    Vec sigma_L;          // standard deviation of adjusted observation
-    Vec vahkopr;          // weight coefficient of residuals
+    Results results_;
     double suma_pvv_;
     GNU_gama::SparseMatrix<double, int>*  Asp;
 
@@ -393,7 +467,10 @@ namespace GNU_gama { namespace local
     // solution of Least Squares
 
     bool tst_vyrovnani_;
+    bool tst_results_;
     void vyrovnani_();
+    void vyrovnani_results_();
+    double conf_int_coef_();
 
     int  min_n_;           // regularization of free network
     int* min_x_;
@@ -24,23 +24,27 @@
 #include <gnu_gama/gon2deg.h>
 
 #include <cctype>
+#include <charconv>
 #include <sstream>
 #include <limits>
 
 
 namespace GNU_gama { namespace local
 {
-  // the static member Observation::gons was introduced in 1.7.09 to
-  // enable selection between grades and degrees in virtual functions
-  // Observation::write() with minimal changes in existing old code of
-  // GNU_gama::local
-
-  bool Observation::gons = true;
-
    std::string to_xmlstr(double val, int prec)
    {
      // std::to_string(double) depends on locales
      // https://en.cppreference.com/w/cpp/string/basic_string/to_string
+     // std::to_chars is locale independent and gives the same output
+     // as ostream with std::defaultfloat
+     char str[64];
+     if (prec >= 0 && prec <= 40)
+       {
+         auto [end, ec] = std::to_chars(str, str + sizeof(str), val,
+                                        std::chars_format::general, prec);
+         if (ec == std::errc()) return std::string(str, end);
+       }
+
      std::ostringstream ostr;
      ostr << std::setprecision(prec) << std::defaultfloat << val;
      return ostr.str();
@@ -156,8 +156,6 @@ namespace GNU_gama { namespace local {
 
       bool check_std_dev() const;
 
-      static  bool gons;   // added in 1.7.09
-
       // instrument / reflector height
 
       double  from_dh() const { return from_dh_; }
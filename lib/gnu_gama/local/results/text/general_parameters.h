@@ -479,7 +479,8 @@ bool GeneralParameters(GNU_gama::local::LocalNetwork* IS, OutStream& out)
               << setprecision(0) << (1 - IS->conf_pr())*100
               << T_GaMa_genpar_for_observation_ind
               << imax << "\n";
-          WriteVisitor<OutStream> write_visitor(out, true, IS->y_sign());
+          WriteVisitor<OutStream> write_visitor(out, true, IS->y_sign(),
+                                                  IS->gons());
           obs->accept(&write_visitor);
           out << "\n";
         }
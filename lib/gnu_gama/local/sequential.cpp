@@ -0,0 +1,114 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <gnu_gama/local/sequential.h>
+
+#include <vector>
+
+using namespace GNU_gama::local;
+
+
+EpochPrior::EpochPrior(LocalNetwork& previous)
+{
+  const double y_sign = previous.y_sign();
+  const Vec& X = previous.solve();
+
+  // the same coordinates and covariances as in LocalNetworkXML
+
+  std::vector<int> ind(1);            // adjustment indexes, 1 based
+  std::vector<double> sign(1);        // y_sign for y coordinates
+  for (PointData::const_iterator
+         i=previous.PD.begin(); i!=previous.PD.end(); ++i)
+    {
+      const LocalPoint& p = (*i).second;
+      if (!p.active_xy() && !p.active_z()) continue;
+      const bool bxy = p.active_xy() && p.index_x() != 0;
+      const bool bz  = p.active_z () && p.index_z() != 0;
+      if (!bxy && !bz) continue;
+
+      Point& q = points[(*i).first];
+      if (bxy)
+        {
+          q.x = p.x() + X(p.index_x())/1000;
+          q.y =(p.y() + X(p.index_y())/1000)*y_sign;
+          ind.push_back(p.index_x());  sign.push_back(1);
+          q.indx = int(ind.size()) - 1;
+          ind.push_back(p.index_y());  sign.push_back(y_sign);
+          q.indy = int(ind.size()) - 1;
+        }
+      if (bz)
+        {
+          q.z = p.z() + X(p.index_z())/1000;
+          ind.push_back(p.index_z());  sign.push_back(1);
+          q.indz = int(ind.size()) - 1;
+        }
+    }
+
+  const int dim = int(ind.size()) - 1;
+  const double m2 = previous.m_0() * previous.m_0();
+  cov.reset(dim, dim ? dim-1 : 0);
+  for (int i=1; i<=dim; i++)
+    for (int j=i; j<=dim; j++)
+      cov(i,j) = m2*previous.qxx(ind[i], ind[j])*sign[i]*sign[j];
+}
+
+
+EpochPrior::EpochPrior(const GNU_gama::LocalNetworkAdjustmentResultsData& adj)
+{
+  for (const auto& p : adj.adjusted_points)
+    {
+      if (!p.hxy && !p.hz) continue;
+
+      Point& q = points[p.id];
+      if (p.hxy)
+        {
+          q.x = p.x;     q.indx = p.indx;
+          q.y = p.y;     q.indy = p.indy;
+        }
+      if (p.hz)
+        {
+          q.z = p.z;     q.indz = p.indz;
+        }
+    }
+
+  // covariances out of the band of XML output are not available,
+  // correlations of prior coordinates cannot be neglected
+
+  const int dim  = adj.cov.dim();
+  const int band = adj.cov.bandWidth();
+  if (dim && band < dim-1)
+    throw GNU_gama::local::Exception("Prior: incomplete covariance matrix, "
+                                     "results must be written with "
+                                     "--cov-band -1");
+
+  cov.reset(dim, dim ? dim-1 : 0);
+  for (int i=1; i<=dim; i++)
+    for (int j=i; j<=dim; j++)
+      cov(i,j) = adj.cov(i,j);
+
+  for (const auto& p : points)
+    {
+      const Point& q = p.second;
+      for (int k : {q.indx, q.indy, q.indz})
+        if (k < 0 || k > dim)
+          throw GNU_gama::local::Exception("Prior: bad covariance matrix");
+    }
+}
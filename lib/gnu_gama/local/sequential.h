@@ -0,0 +1,65 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef gama_local_EpochPrior_sequential_adjustment_of_epochs_h_
+#define gama_local_EpochPrior_sequential_adjustment_of_epochs_h_
+
+#include <map>
+
+#include <gnu_gama/local/network.h>
+#include <gnu_gama/xml/localnetwork_adjustment_results_data.h>
+
+namespace GNU_gama { namespace local {
+
+  /** \brief Prior information for sequential adjustment of epochs
+   *
+   * Adjusted coordinates of the previous epoch and their covariance
+   * matrix, taken either from the adjusted LocalNetwork or from its
+   * XML adjustment results (gama-local --prior). Coordinates and
+   * covariances are stored as written to XML output, i.e. in the
+   * coordinate system of input data, covariances are in [mm^2]. XML
+   * results must contain the full covariance band (--cov-band -1).
+   *
+   * \sa LocalNetwork::set_prior()
+   */
+
+  class EpochPrior {
+  public:
+
+    struct Point
+    {
+      double x {0}, y {0}, z {0};
+      int    indx {0}, indy {0}, indz {0};    // indexes in cov, 0 if none
+    };
+
+    std::map<PointID, Point> points;
+    CovMat                   cov;
+
+    EpochPrior() = default;
+    explicit EpochPrior(LocalNetwork& previous);
+    explicit EpochPrior(const GNU_gama::LocalNetworkAdjustmentResultsData&);
+
+    int dim() const { return cov.dim(); }
+  };
+
+}}
+
+#endif
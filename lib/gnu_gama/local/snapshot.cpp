@@ -0,0 +1,1195 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <gnu_gama/local/snapshot.h>
+#include <gnu_gama/local/gamadata.h>
+#include <gnu_gama/local/float.h>
+#include <gnu_gama/statan.h>
+#include <gnu_gama/version.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+using namespace GNU_gama::local;
+using GNU_gama::LocalNetworkAdjustmentResultsData;
+
+namespace {
+
+  const char          signature[8] = {'G','A','M','A','S','N','A','P'};
+  const std::uint32_t byte_order   = 0x01020304;
+
+  enum Section : std::uint32_t { network_section = 1, results_section = 2 };
+
+  // observation and cluster types stored in a snapshot, never reorder
+
+  enum ObsType : std::int32_t
+    {
+      t_distance, t_direction, t_angle, t_h_diff, t_s_distance, t_z_angle,
+      t_x, t_y, t_z, t_xdiff, t_ydiff, t_zdiff, t_azimuth
+    };
+
+  enum ClusterType : std::int32_t
+    {
+      t_standpoint, t_coordinates, t_height_differences, t_vectors
+    };
+
+  // point flags: defined xy and z, xy and z status in bits 2-3 and 4-5
+
+  enum PointFlags : std::int32_t
+    {
+      p_xy = 1, p_z = 2, p_fixed = 1, p_free = 2, p_constrained = 3
+    };
+
+  // point flags of adjustment results
+
+  enum ResultFlags : std::int32_t
+    {
+      r_hxy = 1, r_hz = 2, r_cxy = 4, r_cz = 8
+    };
+
+
+  class Writer {
+  public:
+    explicit Writer(std::ostream& out) : out_(out) {}
+
+    void bytes(const void* data, std::uint64_t n)
+    {
+      out_.write(static_cast<const char*>(data), n);
+      pos_ += n;
+    }
+
+    template <typename T> void value(T v) { bytes(&v, sizeof(T)); }
+
+    template <typename Column> void operator()(const Column& column)
+    {
+      using T = typename Column::value_type;
+      value(std::uint64_t(column.size()));
+      bytes(column.data(), column.size()*sizeof(T));
+      const char zero[8] {};
+      if (pos_ % 8) bytes(zero, 8 - pos_ % 8);
+    }
+
+  private:
+    std::ostream& out_;
+    std::uint64_t pos_ {0};
+  };
+
+
+  // columns refer to the read data, which are aligned to 8 bytes
+
+  class Reader {
+  public:
+    Reader(const char* data, std::uint64_t size)
+      : data_(data), size_(size)
+    {
+    }
+
+    void bytes(void* data, std::uint64_t n)
+    {
+      if (n > size_ - pos_)
+        throw GNU_gama::local::Exception("Snapshot: unexpected end of data");
+
+      std::memcpy(data, data_ + pos_, n);
+      pos_ += n;
+    }
+
+    template <typename T> T value() { T v; bytes(&v, sizeof(T)); return v; }
+
+    template <typename Column> void operator()(Column& column)
+    {
+      using T = typename Column::value_type;
+      const std::uint64_t n = value<std::uint64_t>();
+      if (n > (size_ - pos_)/sizeof(T))
+        throw GNU_gama::local::Exception("Snapshot: bad column size");
+
+      column.view(reinterpret_cast<const T*>(data_ + pos_), n);
+      pos_ = std::min<std::uint64_t>(size_, (pos_ + n*sizeof(T) + 7)/8*8);
+    }
+
+  private:
+    const char*   data_;
+    std::uint64_t size_;
+    std::uint64_t pos_ {0};
+  };
+
+
+  // columns of observations
+
+  template <typename Columns>
+  class ObservationColumns : public AllObservationsVisitor
+  {
+  public:
+    ObservationColumns(Columns& c) : col(c) {}
+
+    void visit(Distance*)   override { add(t_distance);   }
+    void visit(Direction*)  override { add(t_direction);  }
+    void visit(S_Distance*) override { add(t_s_distance); }
+    void visit(Z_Angle*)    override { add(t_z_angle);    }
+    void visit(X*)          override { add(t_x);          }
+    void visit(Y*)          override { add(t_y);          }
+    void visit(Z*)          override { add(t_z);          }
+    void visit(Xdiff*)      override { add(t_xdiff);      }
+    void visit(Ydiff*)      override { add(t_ydiff);      }
+    void visit(Zdiff*)      override { add(t_zdiff);      }
+    void visit(Azimuth*)    override { add(t_azimuth);    }
+    void visit(Angle* obs)  override
+    {
+      add(t_angle, col.strings.add(obs->fs().str()), obs->fs_dh());
+    }
+    void visit(H_Diff* obs) override
+    {
+      add(t_h_diff, -1, obs->dist());
+    }
+
+  private:
+    Columns& col;
+
+    void add(std::int32_t type, std::int32_t fs = -1, double aux = 0)
+    {
+      col.ob_type.push_back(type);
+      col.ob_fs  .push_back(fs);
+      col.ob_aux .push_back(aux);
+    }
+  };
+
+
+  // observations as written to xml adjustment results, angular values
+  // are in gons, adjusted directions, angles and azimuths are reduced
+  // to the interval <0, 400)
+
+  class ResultsObservation : public AllObservationsVisitor
+  {
+  public:
+    const char* tag {""};
+    std::string from, to, left, right;
+    double value  {0};
+    double scale  {1};          // y sign or 1
+    bool   angular{false};
+    bool   reduced{false};
+
+    explicit ResultsObservation(double ys) : y_sign(ys) {}
+
+    void visit(Distance*   obs) override { linear("distance", obs);       }
+    void visit(H_Diff*     obs) override { linear("height-diff", obs);    }
+    void visit(S_Distance* obs) override { linear("slope-distance", obs); }
+    void visit(Xdiff*      obs) override { linear("dx", obs);             }
+    void visit(Ydiff*      obs) override { linear("dy", obs, y_sign);     }
+    void visit(Zdiff*      obs) override { linear("dz", obs);             }
+    void visit(X*          obs) override { coordinate("coordinate-x", obs); }
+    void visit(Y*          obs) override { coordinate("coordinate-y", obs,
+                                                      y_sign); }
+    void visit(Z*          obs) override { coordinate("coordinate-z", obs); }
+    void visit(Direction*  obs) override { angle("direction", obs, true); }
+    void visit(Z_Angle*    obs) override { angle("zenith-angle", obs, false); }
+    void visit(Azimuth*    obs) override { angle("azimuth", obs, true); }
+    void visit(Angle*      obs) override
+    {
+      angle("angle", obs, true);
+      to.clear();
+      left  = obs->bs().str();
+      right = obs->fs().str();
+    }
+
+  private:
+    const double y_sign;
+
+    void set(const char* t, const Observation* obs)
+    {
+      tag  = t;
+      from = obs->from().str();
+      to   = obs->to().str();
+      left.clear();
+      right.clear();
+      scale   = 1;
+      angular = reduced = false;
+    }
+    void linear(const char* t, const Observation* obs, double ys = 1)
+    {
+      set(t, obs);
+      value = obs->value();
+      scale = ys;
+    }
+    void coordinate(const char* t, const Observation* obs, double ys = 1)
+    {
+      linear(t, obs, ys);
+      to.clear();
+    }
+    void angle(const char* t, const Observation* obs, bool red)
+    {
+      set(t, obs);
+      value   = R2G*(obs->value());
+      angular = true;
+      reduced = red;
+    }
+  };
+
+
+  Observation* new_observation(std::int32_t type,
+                               const PointID& from, const PointID& to,
+                               const PointID& fs, double value, double aux)
+  {
+    switch (type)
+      {
+      case t_distance  : return new Distance  (from, to, value);
+      case t_direction : return new Direction (from, to, value);
+      case t_angle     :
+        {
+          Angle* angle = new Angle(from, to, fs, value);
+          angle->set_fs_dh(aux);
+          return angle;
+        }
+      case t_h_diff    : return new H_Diff    (from, to, value, aux);
+      case t_s_distance: return new S_Distance(from, to, value);
+      case t_z_angle   : return new Z_Angle   (from, to, value);
+      case t_x         : return new X         (from, value);
+      case t_y         : return new Y         (from, value);
+      case t_z         : return new Z         (from, value);
+      case t_xdiff     : return new Xdiff     (from, to, value);
+      case t_ydiff     : return new Ydiff     (from, to, value);
+      case t_zdiff     : return new Zdiff     (from, to, value);
+      case t_azimuth   : return new Azimuth   (from, to, value);
+      }
+
+    throw GNU_gama::local::Exception("Snapshot: unknown observation type");
+  }
+
+}  // unnamed namespace
+
+
+std::int32_t Snapshot::StringTable::add(const std::string& s)
+{
+  auto [iter, inserted] = index.try_emplace(s, offsets.size() - 1);
+  if (inserted)
+    {
+      chars.append(s.begin(), s.end());
+      offsets.push_back(chars.size());
+    }
+
+  return iter->second;
+}
+
+
+std::string Snapshot::StringTable::get(std::int32_t i) const
+{
+  if (i < 0) return std::string();
+
+  if (std::uint64_t(i) + 1 >= offsets.size() ||
+      offsets[i] > offsets[i+1] || offsets[i+1] > chars.size())
+    throw GNU_gama::local::Exception("Snapshot: bad string index");
+
+  return std::string(chars.data() + offsets[i], chars.data() + offsets[i+1]);
+}
+
+
+template <typename Self, typename Action>
+void Snapshot::network_columns(Self& self, Action& column)
+{
+  auto& n = self.net_;
+
+  column(n.strings.offsets);
+  column(n.strings.chars);
+  column(n.par_double);
+  column(n.par_int);
+
+  column(n.pt_id);
+  column(n.pt_flags);
+  column(n.pt_x);
+  column(n.pt_y);
+  column(n.pt_z);
+
+  column(n.cl_type);
+  column(n.cl_size);
+  column(n.cl_dim);
+  column(n.cl_band);
+  column(n.cl_station);
+  column(n.cl_test_or);
+  column(n.cl_extern);
+  column(n.cl_orientation);
+  column(n.cl_cov);
+
+  column(n.ob_type);
+  column(n.ob_from);
+  column(n.ob_to);
+  column(n.ob_fs);
+  column(n.ob_active);
+  column(n.ob_extern);
+  column(n.ob_value);
+  column(n.ob_from_dh);
+  column(n.ob_to_dh);
+  column(n.ob_aux);
+}
+
+
+template <typename Self, typename Action>
+void Snapshot::results_columns(Self& self, Action& column)
+{
+  auto& r = self.res_;
+
+  column(r.strings.offsets);
+  column(r.strings.chars);
+  column(r.par_double);
+  column(r.par_int);
+
+  column(r.pt_list);
+  column(r.pt_id);
+  column(r.pt_flags);
+  column(r.pt_indx);
+  column(r.pt_indy);
+  column(r.pt_indz);
+  column(r.pt_x);
+  column(r.pt_y);
+  column(r.pt_z);
+
+  column(r.el_id);
+  column(r.el_major);
+  column(r.el_minor);
+  column(r.el_alpha);
+
+  column(r.or_id);
+  column(r.or_index);
+  column(r.or_approx);
+  column(r.or_adj);
+
+  column(r.cov);
+  column(r.original_index);
+
+  column(r.ob_tag);
+  column(r.ob_from);
+  column(r.ob_to);
+  column(r.ob_left);
+  column(r.ob_right);
+  column(r.ob_err_obs);
+  column(r.ob_err_adj);
+  column(r.ob_obs);
+  column(r.ob_adj);
+  column(r.ob_stdev);
+  column(r.ob_qrr);
+  column(r.ob_f);
+  column(r.ob_std_residual);
+}
+
+
+void Snapshot::set_network(LocalNetwork& lnet)
+{
+  net_ = decltype(net_)();
+  auto& n = net_;
+  auto& strings = n.strings;
+
+  n.par_double =
+    {
+      lnet.apriori_m_0(),
+      lnet.conf_pr(),
+      lnet.tol_abs(),
+      lnet.has_epoch()    ? lnet.epoch()    : 0,
+      lnet.has_latitude() ? lnet.latitude() : 0
+    };
+
+  n.par_int =
+    {
+      lnet.m_0_apriori(),
+      lnet.gons(),
+      std::int32_t(lnet.PD.local_coordinate_system),
+      lnet.PD.left_handed_angles(),
+      lnet.adj_covband(),
+      lnet.has_algorithm(),
+      lnet.has_epoch(),
+      lnet.has_latitude(),
+      lnet.has_ellipsoid(),
+      lnet.has_algorithm() ? strings.add(lnet.algorithm()) : -1,
+      lnet.has_ellipsoid() ? strings.add(lnet.ellipsoid()) : -1,
+      strings.add(lnet.description)
+    };
+
+  for (const auto& [id, point] : lnet.PD)
+    {
+      std::int32_t flags = 0;
+      if (point.test_xy()) flags |= p_xy;
+      if (point.test_z())  flags |= p_z;
+
+      if      (point.constrained_xy()) flags |= p_constrained << 2;
+      else if (point.fixed_xy())       flags |= p_fixed       << 2;
+      else if (point.free_xy())        flags |= p_free        << 2;
+
+      if      (point.constrained_z())  flags |= p_constrained << 4;
+      else if (point.fixed_z())        flags |= p_fixed       << 4;
+      else if (point.free_z())         flags |= p_free        << 4;
+
+      n.pt_id   .push_back(strings.add(id.str()));
+      n.pt_flags.push_back(flags);
+      n.pt_x    .push_back(point.x());
+      n.pt_y    .push_back(point.y());
+      n.pt_z    .push_back(point.z());
+    }
+
+  ObservationColumns<decltype(net_)> obs_columns(n);
+
+  for (const auto* cluster : lnet.OD.clusters)
+    {
+      std::int32_t type {}, station = -1, test_or = 0, ext = -1;
+      double orientation = 0;
+
+      if (auto sp = dynamic_cast<const StandPoint*>(cluster))
+        {
+          type    = t_standpoint;
+          station = strings.add(sp->station.str());
+          test_or = sp->test_orientation();
+          if (test_or) orientation = sp->orientation();
+        }
+      else if (auto cr = dynamic_cast<const Coordinates*>(cluster))
+        {
+          type = t_coordinates;
+          if (!cr->get_extern().empty()) ext = strings.add(cr->get_extern());
+        }
+      else if (dynamic_cast<const HeightDifferences*>(cluster))
+        {
+          type = t_height_differences;
+        }
+      else if (dynamic_cast<const Vectors*>(cluster))
+        {
+          type = t_vectors;
+        }
+      else
+        {
+          throw GNU_gama::local::Exception("Snapshot: unknown cluster type");
+        }
+
+      const auto& cov = cluster->covariance_matrix;
+      n.cl_type       .push_back(type);
+      n.cl_size       .push_back(cluster->observation_list.size());
+      n.cl_dim        .push_back(cov.dim());
+      n.cl_band       .push_back(cov.bandWidth());
+      n.cl_station    .push_back(station);
+      n.cl_test_or    .push_back(test_or);
+      n.cl_extern     .push_back(ext);
+      n.cl_orientation.push_back(orientation);
+      n.cl_cov.append(cov.begin(), cov.end());
+
+      for (Observation* obs : cluster->observation_list)
+        {
+          const std::string& ext = obs->get_extern();
+
+          n.ob_from   .push_back(strings.add(obs->from().str()));
+          n.ob_to     .push_back(strings.add(obs->to().str()));
+          n.ob_active .push_back(obs->active());
+          n.ob_extern .push_back(ext.empty() ? -1 : strings.add(ext));
+          n.ob_value  .push_back(obs->raw_value());
+          n.ob_from_dh.push_back(obs->from_dh());
+          n.ob_to_dh  .push_back(obs->to_dh());
+
+          obs->accept(&obs_columns);
+        }
+    }
+
+  has_network_ = true;
+}
+
+
+void Snapshot::get_network(LocalNetwork& lnet) const
+{
+  if (!has_network_)
+    throw GNU_gama::local::Exception("Snapshot: no network data");
+
+  const auto& n = net_;
+  const auto& strings = n.strings;
+
+  if (n.par_double.size() != 5 || n.par_int.size() != 12)
+    throw GNU_gama::local::Exception("Snapshot: bad network parameters");
+
+  const double* pd = n.par_double.data();
+  const std::int32_t* pi = n.par_int.data();
+
+  lnet.clear_nullable_data();
+
+  lnet.apriori_m_0(pd[0]);
+  lnet.conf_pr    (pd[1]);
+  lnet.tol_abs    (pd[2]);
+
+  if (pi[0]) lnet.set_m_0_apriori();
+  else       lnet.set_m_0_aposteriori();
+  if (pi[1]) lnet.set_gons();
+  else       lnet.set_degrees();
+  lnet.PD.local_coordinate_system = LocalCoordinateSystem::CS(pi[2]);
+  if (pi[3]) lnet.PD.setAngularObservations_Lefthanded();
+  else       lnet.PD.setAngularObservations_Righthanded();
+  lnet.set_adj_covband(pi[4]);
+
+  if (pi[5]) lnet.set_algorithm(strings.get(pi[9]));
+  if (pi[6]) lnet.set_epoch(pd[3]);
+  if (pi[7]) lnet.set_latitude(pd[4]);
+  if (pi[8]) lnet.set_ellipsoid(strings.get(pi[10]));
+  lnet.description = strings.get(pi[11]);
+
+  const std::size_t points = n.pt_id.size();
+  if (n.pt_flags.size() != points || n.pt_x.size() != points ||
+      n.pt_y.size() != points || n.pt_z.size() != points)
+    throw GNU_gama::local::Exception("Snapshot: bad point data");
+
+  for (std::size_t i=0; i<points; i++)
+    {
+      const std::int32_t flags = n.pt_flags[i];
+      LocalPoint point;
+      if (flags & p_xy) point.set_xy(n.pt_x[i], n.pt_y[i]);
+      if (flags & p_z)  point.set_z (n.pt_z[i]);
+
+      switch ((flags >> 2) & 3)
+        {
+        case p_fixed      : point.set_fixed_xy();       break;
+        case p_free       : point.set_free_xy();        break;
+        case p_constrained: point.set_constrained_xy(); break;
+        }
+      switch ((flags >> 4) & 3)
+        {
+        case p_fixed      : point.set_fixed_z();       break;
+        case p_free       : point.set_free_z();        break;
+        case p_constrained: point.set_constrained_z(); break;
+        }
+
+      lnet.PD[strings.get(n.pt_id[i])] = point;
+    }
+
+  const std::size_t clusters = n.cl_type.size();
+  const std::size_t obs_size = n.ob_type.size();
+  std::size_t obs = 0, cov = 0;
+
+  for (std::size_t c=0; c<clusters; c++)
+    {
+      ObservationData::ClusterType* cluster {nullptr};
+
+      switch (n.cl_type[c])
+        {
+        case t_standpoint:
+          {
+            StandPoint* sp = new StandPoint(&lnet.OD);
+            sp->station = strings.get(n.cl_station[c]);
+            if (n.cl_test_or[c]) sp->set_orientation(n.cl_orientation[c]);
+            cluster = sp;
+          }
+          break;
+        case t_coordinates:
+          {
+            Coordinates* cr = new Coordinates(&lnet.OD);
+            cr->set_extern(strings.get(n.cl_extern[c]));
+            cluster = cr;
+          }
+          break;
+        case t_height_differences:
+          cluster = new HeightDifferences(&lnet.OD);
+          break;
+        case t_vectors:
+          cluster = new Vectors(&lnet.OD);
+          break;
+        default:
+          throw GNU_gama::local::Exception("Snapshot: unknown cluster type");
+        }
+      lnet.OD.clusters.push_back(cluster);
+
+      if (n.cl_size[c] < 0 || obs_size - obs < std::size_t(n.cl_size[c]))
+        throw GNU_gama::local::Exception("Snapshot: bad cluster size");
+
+      for (const std::size_t e = obs + n.cl_size[c]; obs < e; obs++)
+        {
+          Observation* m = new_observation(n.ob_type[obs],
+                                           strings.get(n.ob_from[obs]),
+                                           strings.get(n.ob_to[obs]),
+                                           strings.get(n.ob_fs[obs]),
+                                           n.ob_value[obs], n.ob_aux[obs]);
+          cluster->observation_list.push_back(m);
+
+          if (n.ob_from_dh[obs]) m->set_from_dh(n.ob_from_dh[obs]);
+          if (n.ob_to_dh  [obs]) m->set_to_dh  (n.ob_to_dh  [obs]);
+          if (!n.ob_active[obs]) m->set_passive();
+          if (n.ob_extern[obs] >= 0)
+            m->set_extern(strings.get(n.ob_extern[obs]));
+        }
+
+      cluster->update();      // bind observations to the cluster
+
+      const int dim  = n.cl_dim [c];
+      const int band = n.cl_band[c];
+      const std::size_t size = std::size_t(dim)*(band+1) - band*(band+1)/2;
+      if (dim < 0 || band < 0 || (dim && band >= dim) ||
+          n.cl_cov.size() - cov < size)
+        throw GNU_gama::local::Exception("Snapshot: bad covariance matrix");
+
+      cluster->covariance_matrix.reset(dim, band);
+      std::copy(n.cl_cov.begin() + cov, n.cl_cov.begin() + cov + size,
+                cluster->covariance_matrix.begin());
+      cov += size;
+    }
+}
+
+
+void Snapshot::set_results(LocalNetwork& lnet)
+{
+  // adjustment results are stored as read from xml output by
+  // gama-local-deformation and compare-xyz (LocalNetworkXML), values
+  // are computed directly from the adjusted network
+
+  res_ = decltype(res_)();
+  auto& r = res_;
+  auto& strings = r.strings;
+
+  const double y_sign = lnet.y_sign();
+  const Vec& x = lnet.solve();
+  const Vec& v = lnet.residuals();
+
+  const char* axes = "";
+  switch (lnet.PD.local_coordinate_system)
+    {
+    case LocalCoordinateSystem::CS::EN: axes = "en"; break;
+    case LocalCoordinateSystem::CS::NW: axes = "nw"; break;
+    case LocalCoordinateSystem::CS::SE: axes = "se"; break;
+    case LocalCoordinateSystem::CS::WS: axes = "ws"; break;
+    case LocalCoordinateSystem::CS::NE: axes = "ne"; break;
+    case LocalCoordinateSystem::CS::SW: axes = "sw"; break;
+    case LocalCoordinateSystem::CS::ES: axes = "es"; break;
+    case LocalCoordinateSystem::CS::WN: axes = "wn"; break;
+    default : break;
+    }
+
+  auto fixed = [](double d, int precision)
+    {
+      std::ostringstream out;
+      out << std::fixed << std::setprecision(precision) << d;
+      return out.str();
+    };
+
+  // coordinates summary
+
+  std::int32_t a_xyz = 0, a_xy = 0, a_z = 0;
+  std::int32_t c_xyz = 0, c_xy = 0, c_z = 0;
+  std::int32_t f_xyz = 0, f_xy = 0, f_z = 0;
+  for (const auto& [id, p] : lnet.PD)
+    {
+      if (!p.active()) continue;
+
+      if (p.free_xy() && p.free_z()) a_xyz++;
+      else if (p.free_xy()) a_xy++;
+      else if (p.free_z())  a_z++;
+
+      if (p.constrained_xy() && p.constrained_z()) c_xyz++;
+      else if (p.constrained_xy()) c_xy++;
+      else if (p.constrained_z())  c_z++;
+
+      if (p.fixed_xy() && p.fixed_z()) f_xyz++;
+      else if (p.fixed_xy()) f_xy++;
+      else if (p.fixed_z())  f_z++;
+    }
+
+  // observations summary
+
+  class Counter : public AllObservationsVisitor
+  {
+  public:
+    std::int32_t dirs {0}, angles {0}, dists {0}, coords {0}, hdiffs {0},
+                 zangles {0}, chords {0}, vectors {0}, azimuths {0};
+
+    void visit(Direction*)  override { dirs++;     }
+    void visit(Distance*)   override { dists++;    }
+    void visit(Angle*)      override { angles++;   }
+    void visit(H_Diff*)     override { hdiffs++;   }
+    void visit(S_Distance*) override { chords++;   }
+    void visit(Z_Angle*)    override { zangles++;  }
+    void visit(X*)          override { coords++;   }
+    void visit(Y*)          override { coords++;   }
+    void visit(Z*)          override { coords++;   }
+    void visit(Xdiff*)      override { vectors++;  }
+    void visit(Ydiff*)      override { }
+    void visit(Zdiff*)      override { }
+    void visit(Azimuth*)    override { azimuths++; }
+  } counter;
+
+  const int observations = lnet.observations_count();
+  for (int i=1; i<=observations; i++) lnet.ptr_obs(i)->accept(&counter);
+
+  // standard deviation
+
+  const int    dof = lnet.degrees_of_freedom();
+  const double aposteriori = dof > 0 ? std::sqrt(lnet.trans_VWV()/dof) : 0;
+  double ratio = 0, lower = 0, upper = 0;
+  auto status = LocalNetworkAdjustmentResultsData::Status::not_applicable;
+  if (dof)
+    {
+      const double alfa_pul = (1 - lnet.conf_pr())/2;
+      ratio = lnet.m_0_aposteriori_value() / lnet.apriori_m_0();
+      lower = std::sqrt(GNU_gama::Chi_square(1-alfa_pul, dof)/dof);
+      upper = std::sqrt(GNU_gama::Chi_square(  alfa_pul, dof)/dof);
+      status = (lower < ratio && ratio < upper)
+        ? LocalNetworkAdjustmentResultsData::Status::passed
+        : LocalNetworkAdjustmentResultsData::Status::failed;
+    }
+
+  // points: fixed, approximate and adjusted coordinates, indexes of
+  // the covariance matrix follow the order of adjusted points
+
+  std::vector<int> ind(lnet.unknowns_count() + 1);
+  int dim = 0;
+
+  for (std::int32_t list : {0, 1, 2})
+    for (const auto& [id, p] : lnet.PD)
+      {
+        if (!p.active_xy() && !p.active_z()) continue;
+        const bool bxy = p.active_xy() && (p.index_x() != 0) == (list != 0);
+        const bool bz  = p.active_z () && (p.index_z() != 0) == (list != 0);
+        if (!bxy && !bz) continue;
+
+        std::int32_t flags = 0;
+        double px = 0, py = 0, pz = 0;
+        std::int32_t ix = 0, iy = 0, iz = 0;
+        if (bxy)
+          {
+            flags |= r_hxy;
+            if (list && p.constrained_xy()) flags |= r_cxy;
+            px = p.x();
+            py = p.y();
+            if (list == 2)
+              {
+                px += x(p.index_x())/1000;
+                py += x(p.index_y())/1000;
+                ind[++dim] = p.index_x();  ix = dim;
+                ind[++dim] = p.index_y();  iy = dim;
+              }
+            py *= y_sign;
+          }
+        if (bz)
+          {
+            flags |= r_hz;
+            if (list && p.constrained_z()) flags |= r_cz;
+            pz = p.z();
+            if (list == 2)
+              {
+                pz += x(p.index_z())/1000;
+                ind[++dim] = p.index_z();  iz = dim;
+              }
+          }
+
+        r.pt_list .push_back(list);
+        r.pt_id   .push_back(strings.add(id.str()));
+        r.pt_flags.push_back(flags);
+        r.pt_indx .push_back(ix);
+        r.pt_indy .push_back(iy);
+        r.pt_indz .push_back(iz);
+        r.pt_x    .push_back(px);
+        r.pt_y    .push_back(py);
+        r.pt_z    .push_back(pz);
+      }
+
+  for (const auto& [id, p] : lnet.PD)
+    {
+      if (!p.active_xy() || !p.free_xy()) continue;
+
+      double major, minor, alpha;
+      lnet.std_error_ellipse(id, major, minor, alpha);
+
+      r.el_id   .push_back(strings.add(id.str()));
+      r.el_major.push_back(major);
+      r.el_minor.push_back(minor);
+      r.el_alpha.push_back(alpha);
+    }
+
+  for (int i=1; i<=lnet.unknowns_count(); i++)
+    if (lnet.unknown_type(i) == 'R')
+      {
+        StandPoint* k = lnet.unknown_standpoint(i);
+        ind[++dim] = k->index_orientation();
+
+        double z = y_sign*(k->orientation())*R2G;
+        if (z <  0 ) z += 400;
+        if (z > 400) z -= 400;
+        double a = z + y_sign*x(i)/10000;
+        if (a <  0 ) a += 400;
+        if (a > 400) a -= 400;
+
+        r.or_id    .push_back(strings.add(lnet.unknown_pointid(i).str()));
+        r.or_index .push_back(dim);
+        r.or_approx.push_back(z);
+        r.or_adj   .push_back(a);
+      }
+
+  int band = 0;
+  if (dim)
+    {
+      band = lnet.adj_covband();
+      if (band == -1 || band > dim-1) band = dim - 1;
+    }
+  const double m2 = lnet.m_0() * lnet.m_0();
+  for (int i=1; i<=dim; i++)
+    for (int j=i; j<=std::min(dim, i+band); j++)
+      r.cov.push_back(m2*lnet.qxx(ind[i], ind[j]));
+
+  r.original_index.push_back(-1);        // indexing from 1
+  for (const auto& [id, p] : lnet.PD)
+    {
+      if (!p.active_xy() && !p.active_z()) continue;
+      const bool bxy = p.active_xy() && p.index_x() != 0;
+      const bool bz  = p.active_z () && p.index_z() != 0;
+      if (bxy) r.original_index.push_back(p.index_x());
+      if (bxy) r.original_index.push_back(p.index_y());
+      if (bz ) r.original_index.push_back(p.index_z());
+    }
+  for (int i=1; i<=lnet.unknowns_count(); i++)
+    if (lnet.unknown_type(i) == 'R') r.original_index.push_back(i);
+
+  // observations
+
+  const double kki = lnet.conf_int_coef();
+  ResultsObservation obs(y_sign);
+  for (int i=1; i<=observations; i++)
+    {
+      Observation* pm = lnet.ptr_obs(i);
+      pm->accept(&obs);
+
+      double adj = obs.value + v(i)/(obs.angular ? 10000 : 1000);
+      if (obs.reduced)
+        {
+          if (adj <  0  ) adj += 400;
+          if (adj >= 400) adj -= 400;
+        }
+
+      const double f = lnet.obs_control(i);
+      double std_residual = 0;
+      std::int32_t err_obs = -1, err_adj = -1;
+      if (f >= 0.1)
+        {
+          std_residual = std::fabs(lnet.studentized_residual(i));
+          if (pm->ptr_cluster()->covariance_matrix.bandWidth() == 0 &&
+              (f >= 5 || std_residual > kki))
+            {
+              const double em = v(i)/(lnet.wcoef_res(i)*lnet.weight_obs(i));
+              err_obs = strings.add(fixed(em, 3));
+              err_adj = strings.add(fixed(em - v(i), 3));
+            }
+        }
+
+      r.ob_tag         .push_back(strings.add(obs.tag));
+      r.ob_from        .push_back(strings.add(obs.from));
+      r.ob_to          .push_back(strings.add(obs.to));
+      r.ob_left        .push_back(strings.add(obs.left));
+      r.ob_right       .push_back(strings.add(obs.right));
+      r.ob_err_obs     .push_back(err_obs);
+      r.ob_err_adj     .push_back(err_adj);
+      r.ob_obs         .push_back(obs.scale*obs.value);
+      r.ob_adj         .push_back(obs.scale*adj);
+      r.ob_stdev       .push_back(lnet.stdev_obs(i));
+      r.ob_qrr         .push_back(lnet.wcoef_res(i));
+      r.ob_f           .push_back(f);
+      r.ob_std_residual.push_back(std_residual);
+    }
+
+  r.par_int =
+    {
+      true,                              // angular values in gons
+      a_xyz, a_xy, a_z, c_xyz, c_xy, c_z, f_xyz, f_xy, f_z,
+      counter.dists, counter.dirs, counter.angles, counter.coords,
+      counter.hdiffs, counter.zangles, counter.chords, counter.vectors,
+      counter.azimuths,
+      observations, lnet.unknowns_count(), dof, lnet.null_space(),
+      lnet.connected_network(), lnet.linearization_iterations(),
+      lnet.m_0_aposteriori(), std::int32_t(status),
+      dim, band,
+      strings.add(lnet.description),
+      strings.add(GNU_gama::version()),
+      strings.add(lnet.has_prior() ? "sequential" : lnet.algorithm()),
+      strings.add(GNU_gama::compiler()),
+      strings.add(axes),
+      strings.add(lnet.PD.right_handed_angles() ? "right-handed"
+                                                : "left-handed"),
+      lnet.has_epoch() ? strings.add(fixed(lnet.epoch(), 7)) : -1,
+      lnet.has_latitude()
+        ? strings.add(fixed(lnet.latitude()/M_PI*200, 7)) : -1,
+      lnet.has_ellipsoid() ? strings.add(lnet.ellipsoid()) : -1
+    };
+
+  r.par_double =
+    {
+      lnet.trans_VWV(),
+      lnet.apriori_m_0(), aposteriori, lnet.conf_pr(), ratio,
+      lower, upper, kki
+    };
+
+  has_results_ = true;
+}
+
+
+void Snapshot::get_results(LocalNetworkAdjustmentResultsData& adj) const
+{
+  if (!has_results_)
+    throw GNU_gama::local::Exception("Snapshot: no adjustment results");
+
+  const auto& r = res_;
+  const auto& strings = r.strings;
+
+  if (r.par_int.size() != 38 || r.par_double.size() != 8)
+    throw GNU_gama::local::Exception("Snapshot: bad adjustment results");
+
+  const std::int32_t* pi = r.par_int.data();
+  const double* pd = r.par_double.data();
+
+  auto& gp = adj.network_general_parameters;
+  auto& cs = adj.coordinates_summary;
+  auto& os = adj.observations_summary;
+  auto& pe = adj.project_equations;
+  auto& sd = adj.standard_deviation;
+
+  adj.gons = *pi++;
+  for (auto* count : {&cs.adjusted, &cs.constrained, &cs.fixed})
+    {
+      count->xyz = *pi++;
+      count->xy  = *pi++;
+      count->z   = *pi++;
+    }
+  for (int* count : {&os.distances, &os.directions, &os.angles,
+                     &os.xyz_coords, &os.h_diffs, &os.z_angles,
+                     &os.s_dists, &os.vectors, &os.azimuths})
+    {
+      *count = *pi++;
+    }
+  pe.equations                = *pi++;
+  pe.unknowns                 = *pi++;
+  pe.degrees_of_freedom       = *pi++;
+  pe.defect                   = *pi++;
+  pe.connected_network        = *pi++;
+  pe.linearization_iterations = *pi++;
+  sd.using_aposteriori        = *pi++;
+  sd.status = LocalNetworkAdjustmentResultsData::Status(*pi++);
+
+  const int dim  = *pi++;
+  const int band = *pi++;
+
+  adj.description         = strings.get(*pi++);
+  gp.gama_local_version   = strings.get(*pi++);
+  gp.gama_local_algorithm = strings.get(*pi++);
+  gp.gama_local_compiler  = strings.get(*pi++);
+  gp.axes_xy              = strings.get(*pi++);
+  gp.angles               = strings.get(*pi++);
+  gp.epoch                = strings.get(*pi++);
+  gp.latitude             = strings.get(*pi++);
+  gp.ellipsoid            = strings.get(*pi++);
+
+  pe.sum_of_squares   = pd[0];
+  sd.apriori          = pd[1];
+  sd.aposteriori      = pd[2];
+  sd.probability      = pd[3];
+  sd.ratio            = pd[4];
+  sd.lower            = pd[5];
+  sd.upper            = pd[6];
+  sd.confidence_scale = pd[7];
+
+  LocalNetworkAdjustmentResultsData::PointList* lists[] =
+    {
+      &adj.fixed_points, &adj.approximate_points, &adj.adjusted_points
+    };
+  for (auto* list : lists) list->clear();
+
+  for (std::size_t i=0; i<r.pt_id.size(); i++)
+    {
+      if (r.pt_list[i] < 0 || r.pt_list[i] > 2)
+        throw GNU_gama::local::Exception("Snapshot: bad point data");
+
+      LocalNetworkAdjustmentResultsData::Point p;
+      const std::int32_t flags = r.pt_flags[i];
+      p.id   = strings.get(r.pt_id[i]);
+      p.x    = r.pt_x[i];
+      p.y    = r.pt_y[i];
+      p.z    = r.pt_z[i];
+      p.hxy  = flags & r_hxy;
+      p.hz   = flags & r_hz;
+      p.cxy  = flags & r_cxy;
+      p.cz   = flags & r_cz;
+      p.indx = r.pt_indx[i];
+      p.indy = r.pt_indy[i];
+      p.indz = r.pt_indz[i];
+
+      lists[r.pt_list[i]]->push_back(p);
+    }
+
+  adj.ellipses.clear();
+  for (std::size_t i=0; i<r.el_id.size(); i++)
+    {
+      LocalNetworkAdjustmentResultsData::Ellipse e;
+      e.id    = strings.get(r.el_id[i]);
+      e.major = r.el_major[i];
+      e.minor = r.el_minor[i];
+      e.alpha = r.el_alpha[i];
+      adj.ellipses.push_back(e);
+    }
+
+  adj.orientations.clear();
+  for (std::size_t i=0; i<r.or_id.size(); i++)
+    {
+      LocalNetworkAdjustmentResultsData::Orientation o;
+      o.id     = strings.get(r.or_id[i]);
+      o.index  = r.or_index[i];
+      o.approx = r.or_approx[i];
+      o.adj    = r.or_adj[i];
+      adj.orientations.push_back(o);
+    }
+
+  if (dim < 0 || band < 0 || (dim && band >= dim) ||
+      r.cov.size() != std::size_t(dim)*(band+1) - band*(band+1)/2)
+    throw GNU_gama::local::Exception("Snapshot: bad covariance matrix");
+
+  adj.cov.reset(dim, band);
+  std::copy(r.cov.begin(), r.cov.end(), adj.cov.begin());
+  adj.original_index.assign(r.original_index.begin(),
+                            r.original_index.end());
+
+  adj.obslist.clear();
+  for (std::size_t i=0; i<r.ob_tag.size(); i++)
+    {
+      LocalNetworkAdjustmentResultsData::Observation o;
+      o.xml_tag      = strings.get(r.ob_tag[i]);
+      o.from         = strings.get(r.ob_from[i]);
+      o.to           = strings.get(r.ob_to[i]);
+      o.left         = strings.get(r.ob_left[i]);
+      o.right        = strings.get(r.ob_right[i]);
+      o.err_obs      = strings.get(r.ob_err_obs[i]);
+      o.err_adj      = strings.get(r.ob_err_adj[i]);
+      o.obs          = r.ob_obs[i];
+      o.adj          = r.ob_adj[i];
+      o.stdev        = r.ob_stdev[i];
+      o.qrr          = r.ob_qrr[i];
+      o.f            = r.ob_f[i];
+      o.std_residual = r.ob_std_residual[i];
+      adj.obslist.push_back(o);
+    }
+}
+
+
+void Snapshot::write(std::ostream& out) const
+{
+  std::uint32_t sections = 0;
+  if (has_network_) sections |= network_section;
+  if (has_results_) sections |= results_section;
+
+  Writer writer(out);
+  writer.bytes(signature, sizeof signature);
+  writer.value(version);
+  writer.value(byte_order);
+  writer.value(sections);
+  writer.value(std::uint32_t(0));      // reserved
+
+  if (has_network_) network_columns(*this, writer);
+  if (has_results_) results_columns(*this, writer);
+}
+
+
+void Snapshot::read(std::istream& inp)
+{
+  // the whole snapshot is read into a buffer of 64 bit words, the
+  // size of seekable streams is known in advance
+
+  std::uint64_t size = 0, capacity = 1 << 16;
+  const auto pos = inp.tellg();
+  if (pos != std::istream::pos_type(-1) && inp.seekg(0, std::ios_base::end))
+    {
+      capacity = std::uint64_t(inp.tellg() - pos) + 1;
+      inp.seekg(pos);
+    }
+  inp.clear();
+
+  has_network_ = has_results_ = false;
+  net_ = decltype(net_)();
+  res_ = decltype(res_)();
+
+  for (;;)
+    {
+      buffer_.resize((capacity + 7)/8);
+      char* data = reinterpret_cast<char*>(buffer_.data());
+      inp.read(data + size, capacity - size);
+      size += inp.gcount();
+      if (size < capacity) break;
+      capacity *= 2;
+    }
+
+  Reader reader(reinterpret_cast<const char*>(buffer_.data()), size);
+  char sig[sizeof signature];
+  reader.bytes(sig, sizeof sig);
+  if (std::memcmp(sig, signature, sizeof signature))
+    throw GNU_gama::local::Exception("Snapshot: bad signature");
+  if (reader.value<std::uint32_t>() != version)
+    throw GNU_gama::local::Exception("Snapshot: unsupported version");
+  if (reader.value<std::uint32_t>() != byte_order)
+    throw GNU_gama::local::Exception("Snapshot: unsupported byte order");
+
+  const std::uint32_t sections = reader.value<std::uint32_t>();
+  reader.value<std::uint32_t>();       // reserved
+
+  has_network_ = sections & network_section;
+  has_results_ = sections & results_section;
+
+  if (has_network_) network_columns(*this, reader);
+  if (has_results_) results_columns(*this, reader);
+
+  // columns of the same table must have equal lengths
+
+  const auto& n = net_;
+  const std::size_t nc = n.cl_type.size();
+  const std::size_t no = n.ob_type.size();
+  for (std::size_t s : {n.cl_size.size(), n.cl_dim.size(), n.cl_band.size(),
+                        n.cl_station.size(), n.cl_test_or.size(),
+                        n.cl_extern.size(), n.cl_orientation.size()})
+    if (s != nc) throw GNU_gama::local::Exception("Snapshot: bad clusters");
+  for (std::size_t s : {n.ob_from.size(), n.ob_to.size(), n.ob_fs.size(),
+                        n.ob_active.size(), n.ob_extern.size(),
+                        n.ob_value.size(), n.ob_from_dh.size(),
+                        n.ob_to_dh.size(), n.ob_aux.size()})
+    if (s != no) throw GNU_gama::local::Exception("Snapshot: bad observations");
+
+  const auto& r = res_;
+  const std::size_t rp = r.pt_id.size();
+  const std::size_t re = r.el_id.size();
+  const std::size_t ro = r.or_id.size();
+  const std::size_t rb = r.ob_tag.size();
+  for (std::size_t s : {r.pt_list.size(), r.pt_flags.size(), r.pt_indx.size(),
+                        r.pt_indy.size(), r.pt_indz.size(), r.pt_x.size(),
+                        r.pt_y.size(), r.pt_z.size()})
+    if (s != rp) throw GNU_gama::local::Exception("Snapshot: bad points");
+  for (std::size_t s : {r.el_major.size(), r.el_minor.size(),
+                        r.el_alpha.size()})
+    if (s != re) throw GNU_gama::local::Exception("Snapshot: bad ellipses");
+  for (std::size_t s : {r.or_index.size(), r.or_approx.size(),
+                        r.or_adj.size()})
+    if (s != ro) throw GNU_gama::local::Exception("Snapshot: bad orientations");
+  for (std::size_t s : {r.ob_from.size(), r.ob_to.size(), r.ob_left.size(),
+                        r.ob_right.size(), r.ob_err_obs.size(),
+                        r.ob_err_adj.size(), r.ob_obs.size(), r.ob_adj.size(),
+                        r.ob_stdev.size(), r.ob_qrr.size(), r.ob_f.size(),
+                        r.ob_std_residual.size()})
+    if (s != rb) throw GNU_gama::local::Exception("Snapshot: bad observations");
+}
+
+
+bool Snapshot::test(std::istream& inp)
+{
+  char sig[sizeof signature] {};
+  const auto pos = inp.tellg();
+  inp.read(sig, sizeof sig);
+  const bool test = inp.gcount() == sizeof sig &&
+                    std::memcmp(sig, signature, sizeof signature) == 0;
+  inp.clear();
+  inp.seekg(pos);
+
+  return test;
+}
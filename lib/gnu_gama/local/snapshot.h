@@ -0,0 +1,232 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef gama_local_Snapshot_binary_snapshot_of_local_network_h_
+#define gama_local_Snapshot_binary_snapshot_of_local_network_h_
+
+#include <cstdint>
+#include <initializer_list>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gnu_gama/local/network.h>
+#include <gnu_gama/xml/localnetwork_adjustment_results_data.h>
+
+namespace GNU_gama { namespace local {
+
+  /** \brief Binary snapshot of input data and adjustment results
+   *
+   * A snapshot stores the input data of LocalNetwork (parameters,
+   * points, clusters with covariance matrices and observations) and
+   * optionally the adjustment results as read by gama-local-deformation
+   * and compare-xyz. Reloading a snapshot avoids parsing of XML input
+   * and XML adjustment results.
+   *
+   * Data are stored column oriented, every column is a 64 bit count
+   * followed by raw array elements padded to 8 bytes, so that all
+   * columns are aligned when the file is memory mapped. Point ids and
+   * other strings are stored in a string table per section and
+   * referenced by their indexes. The format is versioned and stored in
+   * the native byte order, a snapshot from a machine of different
+   * endianness is rejected.
+   *
+   * A snapshot is read into a single buffer and its columns refer to
+   * the buffer, array elements are not copied.
+   */
+
+  class Snapshot {
+  public:
+
+    /** input data of the network, before approximate coordinates and
+     * reductions are computed */
+    void set_network(LocalNetwork& lnet);
+    /** results of the adjusted network, as written to xml output */
+    void set_results(LocalNetwork& lnet);
+
+    bool has_network() const { return has_network_; }
+    bool has_results() const { return has_results_; }
+
+    void get_network(LocalNetwork& lnet) const;
+    void get_results(GNU_gama::LocalNetworkAdjustmentResultsData& adj) const;
+
+    void write(std::ostream&) const;
+    void read (std::istream&);
+
+    /** tests the snapshot signature, stream position is not changed */
+    static bool test(std::istream&);
+
+    static const std::uint32_t version = 1;
+
+  private:
+
+    /* column owning its elements or referring to the read buffer,
+       a referring column is copied on the first change */
+
+    template <typename T>
+    class Column {
+    public:
+      using value_type = T;
+
+      Column() = default;
+      Column(std::initializer_list<T> list) : own_(list) { sync(); }
+      Column(const Column& c) : own_(c.begin(), c.end()) { sync(); }
+      Column(Column&& c) noexcept { take(c); }
+
+      Column& operator=(const Column& c)
+      {
+        if (this != &c) { own_.assign(c.begin(), c.end()); sync(); }
+        return *this;
+      }
+      Column& operator=(Column&& c) noexcept
+      {
+        if (this != &c) take(c);
+        return *this;
+      }
+      Column& operator=(std::initializer_list<T> list)
+      {
+        own_ = list;
+        sync();
+        return *this;
+      }
+
+      std::size_t size()  const { return size_; }
+      bool        empty() const { return size_ == 0; }
+      const T*    data()  const { return data_; }
+      const T*    begin() const { return data_; }
+      const T*    end()   const { return data_ + size_; }
+      const T& operator[](std::size_t i) const { return data_[i]; }
+
+      void push_back(const T& t) { own(); own_.push_back(t); sync(); }
+      template <typename Iter> void append(Iter first, Iter last)
+      {
+        own();
+        own_.insert(own_.end(), first, last);
+        sync();
+      }
+      template <typename Iter> void assign(Iter first, Iter last)
+      {
+        own_.assign(first, last);
+        sync();
+      }
+
+      /** refer to n elements of the read buffer */
+      void view(const T* t, std::size_t n)
+      {
+        own_.clear();
+        data_ = t;
+        size_ = n;
+      }
+
+    private:
+      std::vector<T> own_;
+      const T*       data_ {nullptr};
+      std::size_t    size_ {0};
+
+      void sync() { data_ = own_.data(); size_ = own_.size(); }
+      void own()
+      {
+        if (data_ != own_.data()) { own_.assign(begin(), end()); sync(); }
+      }
+      void take(Column& c)
+      {
+        const bool owned = c.data_ == c.own_.data();
+        own_  = std::move(c.own_);
+        data_ = owned ? own_.data() : c.data_;
+        size_ = c.size_;
+        c.own_.clear();
+        c.sync();
+      }
+    };
+
+    class StringTable {
+    public:
+      std::int32_t add(const std::string&);
+      std::string  get(std::int32_t) const;
+
+      Column<std::uint64_t> offsets {0};
+      Column<char>          chars;
+
+    private:
+      std::unordered_map<std::string, std::int32_t> index;
+    };
+
+    bool has_network_ {false};
+    bool has_results_ {false};
+
+    std::vector<std::uint64_t> buffer_;     // data of a read snapshot
+
+    struct {
+      StringTable strings;
+
+      Column<double>       par_double;
+      Column<std::int32_t> par_int;
+
+      Column<std::int32_t> pt_id, pt_flags;
+      Column<double>       pt_x, pt_y, pt_z;
+
+      Column<std::int32_t> cl_type, cl_size, cl_dim, cl_band,
+                           cl_station, cl_test_or, cl_extern;
+      Column<double>       cl_orientation, cl_cov;
+
+      Column<std::int32_t> ob_type, ob_from, ob_to, ob_fs,
+                           ob_active, ob_extern;
+      Column<double>       ob_value, ob_from_dh, ob_to_dh, ob_aux;
+    } net_;
+
+    struct {
+      StringTable strings;
+
+      Column<double>       par_double;
+      Column<std::int32_t> par_int;
+
+      Column<std::int32_t> pt_list, pt_id, pt_flags,
+                           pt_indx, pt_indy, pt_indz;
+      Column<double>       pt_x, pt_y, pt_z;
+
+      Column<std::int32_t> el_id;
+      Column<double>       el_major, el_minor, el_alpha;
+
+      Column<std::int32_t> or_id, or_index;
+      Column<double>       or_approx, or_adj;
+
+      Column<double>       cov;
+      Column<std::int32_t> original_index;
+
+      Column<std::int32_t> ob_tag, ob_from, ob_to, ob_left, ob_right,
+                           ob_err_obs, ob_err_adj;
+      Column<double>       ob_obs, ob_adj, ob_stdev, ob_qrr, ob_f,
+                           ob_std_residual;
+    } res_;
+
+    // the order of columns in the network and results sections
+
+    template <typename Self, typename Action>
+    static void network_columns(Self&, Action&);
+    template <typename Self, typename Action>
+    static void results_columns(Self&, Action&);
+  };
+
+}}
+
+#endif
@@ -43,8 +43,8 @@ template <typename OutStream>
 class WriteVisitor : public AllObservationsVisitor
 {
 public:
-    WriteVisitor(OutStream& out, bool print_at, double y_sign)
-      : out_(out), print_at_(print_at), y_sign_(y_sign)
+    WriteVisitor(OutStream& out, bool print_at, double y_sign, bool gons)
+      : out_(out), print_at_(print_at), y_sign_(y_sign), gons_(gons)
     {}
 
     void visit(Angle *obs) { write(*obs, out_, print_at_); }
@@ -68,7 +68,7 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " bs=\"" << obs.bs()  << '"' << " fs=\"" << obs.fs() << '"' << " val=\"";
-      if (Observation::gons)
+      if (gons_)
         out << std::setprecision(Format::gon_p()) << obs.value()*R2G;
       else
         out << GNU_gama::gon2deg(obs.value()*R2G, 2, Format::gon_p());
@@ -76,7 +76,7 @@ public:
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
           out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
         }
 
@@ -90,7 +90,7 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " to=\"" << obs.to() << '"' << " val=\"";
-      if (Observation::gons)
+      if (gons_)
         out << std::setprecision(Format::gon_p()  ) << obs.value()*R2G;
       else
         out << GNU_gama::gon2deg(obs.value()*R2G, 2, Format::gon_p());
@@ -98,7 +98,7 @@ public:
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
           out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
         }
 
@@ -202,7 +202,7 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " to=\"" << obs.to() << '"' << " val=\"";
-      if (Observation::gons)
+      if (gons_)
         out << std::setprecision(Format::gon_p()) << obs.value()*R2G;
       else
         out << GNU_gama::gon2deg(obs.value()*R2G, 2, Format::gon_p());
@@ -210,7 +210,7 @@ public:
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
           out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
         }
 
@@ -224,7 +224,7 @@ public:
         out << " from=\"" << obs.from() << '"';
 
       out << " to=\"" << obs.to() << '"' << " val=\"";
-      if (Observation::gons)
+      if (gons_)
         out << std::setprecision(Format::gon_p()  ) << obs.value()*R2G;
       else
         out << GNU_gama::gon2deg(obs.value()*R2G, 2, Format::gon_p());
@@ -232,7 +232,7 @@ public:
 
       if (obs.check_std_dev())
         {
-          double stddev = Observation::gons ? obs.stdDev() : obs.stdDev()*0.324;
+          double stddev = gons_ ? obs.stdDev() : obs.stdDev()*0.324;
           out << " stdev=\"" << std::setprecision(Format::stdev_p()) << stddev << '"';
         }
 
@@ -243,6 +243,7 @@ private:
     OutStream& out_;
     bool  print_at_;
     double  y_sign_ {1};
+    bool    gons_   {true};
 };
 
 }} // namespace GNU_gama local
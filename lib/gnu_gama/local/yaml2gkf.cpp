@@ -822,7 +822,7 @@ std::string Yaml2gkf::algorithm(std::string key, std::string val)
 {
   const std::unordered_set<std::string> algo
   {
-    "gso", "svd", "cholesky", "envelope"
+    "gso", "svd", "cholesky", "envelope", "helmert"
   };
 
   bool test = algo.find(val) != algo.end();
@@ -0,0 +1,607 @@
+/* YamlReader --- reading yaml input data into LocalNetwork
+   Copyright (C) 2026 Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   Class YamlReader is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   YamlReader is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with GNU Gama.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+#include <yaml-cpp/eventhandler.h>
+#include <gnu_gama/local/yamlreader.h>
+#include <gnu_gama/xml/gkfparser.h>
+#include <gnu_gama/xsd.h>
+
+using namespace GNU_gama::local;
+
+namespace {
+
+  using Atts = std::vector<std::pair<std::string, std::string>>;
+
+  /* Yaml subtree of a single point, observation group, defaults etc.
+   * Maps store their keys and values alternately.
+   */
+  struct Item
+  {
+    enum Type { null, scalar, map, sequence } type {null};
+    std::string       value;
+    std::vector<Item> items;
+    int               line {0};
+  };
+
+
+  /* Top level map and lists of points and observations are processed
+   * as a stream of parser events, their items are built as Item
+   * subtrees and translated to GKFparser elements when completed.
+   */
+  class Handler : public YAML::EventHandler
+  {
+  public:
+
+    explicit Handler(GKFparser& gkf) : gkf_(gkf) {}
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark& mark, YAML::anchor_t) override
+    {
+      Item item;
+      item.line = line_ = mark.line + 1;
+      add(std::move(item));
+    }
+    void OnAlias(const YAML::Mark& mark, YAML::anchor_t) override
+    {
+      line_ = mark.line + 1;
+      error("yaml aliases are not supported");
+    }
+    void OnScalar(const YAML::Mark& mark, const std::string&,
+                  YAML::anchor_t, const std::string& value) override
+    {
+      Item item;
+      item.type  = Item::scalar;
+      item.value = value;
+      item.line  = line_ = mark.line + 1;
+      add(std::move(item));
+    }
+    void OnSequenceStart(const YAML::Mark& mark, const std::string&,
+                         YAML::anchor_t, YAML::EmitterStyle::value) override
+    {
+      line_ = mark.line + 1;
+      begin(Item::sequence);
+    }
+    void OnSequenceEnd() override { end(); }
+    void OnMapStart(const YAML::Mark& mark, const std::string&,
+                    YAML::anchor_t, YAML::EmitterStyle::value) override
+    {
+      line_ = mark.line + 1;
+      begin(Item::map);
+    }
+    void OnMapEnd() override { end(); }
+
+    void finish();
+
+  private:
+
+    GKFparser& gkf_;
+    int        line_ {0};
+
+    enum Kind { root, points, observations, group, group_list };
+    struct Frame
+    {
+      Kind        kind;
+      bool        key {true};     // map frames: a key is expected
+      std::string name;           // the last key
+    };
+    std::vector<Frame> frames_;
+    std::vector<Item>  built_;    // open containers of the current item
+
+    int  count_defaults_ {0}, count_description_ {0},
+         count_points_   {0}, count_observations_ {0};
+    bool header_ {false};
+    Atts atts_[3];                // network, parameters, points-observations
+    std::string description_;
+
+    std::string group_;           // height-differences, vectors, coordinates
+    Atts        group_atts_;      // <obs> attributes
+    Item        group_obs_;
+
+    void add  (Item&& item);
+    void begin(Item::Type type);
+    void end  ();
+    void value(Item&& item);
+
+    void root_key (const Item& key);
+    void defaults (const Item& item);
+    void point    (const Item& item);
+    void obs_group();
+    void list_item(const Item& item);
+    void cov_mat  (const Item& item);
+    void header   ();
+
+    void start(const char* name, const Atts& atts, int line);
+    void stop (const char* name, int line)
+    {
+      gkf_.end_element(name, line);
+    }
+
+    std::string str(const Item& item);
+    [[noreturn]] void error(const std::string& text, int line = 0)
+    {
+      throw ParserException(text, line ? line : line_, -1);
+    }
+  };
+
+
+  void Handler::add(Item&& item)
+  {
+    if (!built_.empty())
+      {
+        built_.back().items.push_back(std::move(item));
+        return;
+      }
+
+    if (frames_.empty()) error("yaml document must be a map");
+
+    Frame& frame = frames_.back();
+    if ((frame.kind == root || frame.kind == group) && frame.key)
+      {
+        if (item.type != Item::scalar) error("bad key");
+        frame.name = item.value;
+        frame.key  = false;
+        if (frame.kind == root) root_key(item);
+        return;
+      }
+
+    value(std::move(item));
+  }
+
+
+  void Handler::begin(Item::Type type)
+  {
+    if (built_.empty())
+      {
+        if (frames_.empty())
+          {
+            if (type != Item::map) error("yaml document must be a map");
+            frames_.push_back({root});
+            return;
+          }
+
+        Frame& frame = frames_.back();
+        if ((frame.kind == root || frame.kind == group) && frame.key)
+          error("bad key");
+
+        if (type == Item::sequence && frame.kind == root)
+          {
+            if (frame.name == "points" || frame.name == "observations")
+              {
+                header();
+                frames_.push_back({frame.name == "points" ? points
+                                                          : observations});
+                return;
+              }
+          }
+        else if (type == Item::map && frame.kind == observations)
+          {
+            group_.clear();
+            group_atts_.clear();
+            group_obs_ = Item();
+            frames_.push_back({group});
+            return;
+          }
+        else if (type == Item::sequence && frame.kind == group)
+          {
+            if (frame.name == "height-differences" ||
+                frame.name == "vectors" ||
+                frame.name == "coordinates")
+              {
+                if (!group_.empty() || !group_atts_.empty() ||
+                    group_obs_.type != Item::null)
+                  error("unknown key", line_);
+
+                group_ = frame.name;
+                start(group_.c_str(), Atts(), line_);
+                frames_.push_back({group_list});
+                return;
+              }
+          }
+      }
+
+    Item item;
+    item.type = type;
+    item.line = line_;
+    built_.push_back(std::move(item));
+  }
+
+
+  void Handler::end()
+  {
+    if (!built_.empty())
+      {
+        Item item = std::move(built_.back());
+        built_.pop_back();
+        add(std::move(item));
+        return;
+      }
+
+    const Kind kind = frames_.back().kind;
+    frames_.pop_back();
+
+    switch (kind)
+      {
+      case root:
+        break;
+      case points:
+      case observations:
+        frames_.back().key = true;
+        break;
+      case group:
+        if (group_.empty())
+          obs_group();
+        else
+          group_.clear();
+        break;
+      case group_list:
+        stop(group_.c_str(), line_);
+        frames_.back().key = true;
+        break;
+      }
+  }
+
+
+  void Handler::value(Item&& item)
+  {
+    Frame& frame = frames_.back();
+
+    switch (frame.kind)
+      {
+      case root:
+        if (frame.name == "defaults")
+          {
+            defaults(item);
+          }
+        else if (frame.name == "description")
+          {
+            description_ = str(item);
+          }
+        else if (item.type != Item::null)
+          {
+            error("node '" + frame.name + "' must be a list", item.line);
+          }
+        frame.key = true;
+        break;
+
+      case points:
+        point(item);
+        break;
+
+      case observations:
+        error("observation group must be a map", item.line);
+
+      case group:
+        if (!group_.empty()) error("unknown key", item.line);
+
+        if (frame.name == "obs")
+          {
+            group_obs_ = std::move(item);
+          }
+        else if (frame.name == "from" || frame.name == "from_dh" ||
+                 frame.name == "orientation")
+          {
+            // in <obs> tag from attribute may not defined in yaml
+            const std::string val = str(item);
+            if (frame.name != "from" || !val.empty())
+              group_atts_.push_back({frame.name, val});
+          }
+        else
+          {
+            error("key not found " + frame.name, item.line);
+          }
+        frame.key = true;
+        break;
+
+      case group_list:
+        list_item(item);
+        break;
+      }
+  }
+
+
+  void Handler::root_key(const Item& key)
+  {
+    if (key.value == "defaults")
+      {
+        if (++count_defaults_ > 1)
+          error("optional node 'defaults' can be used only once");
+        if (header_)
+          error("node 'defaults' must precede 'points' and 'observations'");
+      }
+    else if (key.value == "description")
+      {
+        if (++count_description_ > 1)
+          error("optional node 'description' can be used only once");
+      }
+    else if (key.value == "points")
+      {
+        if (++count_points_ > 1)
+          error("mandatory node 'points' must be used exactly once");
+      }
+    else if (key.value == "observations")
+      {
+        if (++count_observations_ > 1)
+          error("mandatory node 'observations' must be used exactly once");
+      }
+    else
+      {
+        error("unknown node " + key.value);
+      }
+  }
+
+
+  void Handler::defaults(const Item& item)
+  {
+    // index of attributes of <network>, <parameters> and
+    // <points-observations>
+
+    static const std::unordered_map<std::string, int> attr_ind
+    {
+      {"axes-xy", 0}, {"angles", 0}, {"epoch", 0},
+
+      {"sigma-apr", 1}, {"conf-pr",  1}, {"tol-abs",   1},
+      {"sigma-act", 1}, {"algorithm",1}, {"language",  1},
+      {"encoding",  1}, {"angular",  1}, {"latitude",  1},
+      {"ellipsoid", 1}, {"cov-band", 1},
+
+      {"distance-stdev",     2}, {"direction-stdev", 2},
+      {"angle-stdev",        2}, {"zenith-angle-stdev", 2},
+      {"azimuth-stdev",      2}
+    };
+
+    if (item.type == Item::null) return;
+    if (item.type != Item::map) error("node 'defaults' must be a map", item.line);
+
+    for (std::size_t i=0; i+1<item.items.size(); i+=2)
+      {
+        const std::string key = str(item.items[i]);
+        auto iter = attr_ind.find(key);
+        if (iter == attr_ind.end())
+          error("unknown defaults' attribute " + key, item.items[i].line);
+
+        // language and encoding are options of gama-local, not parameters
+        if (key == "language" || key == "encoding") continue;
+
+        atts_[iter->second].push_back({key, str(item.items[i+1])});
+      }
+  }
+
+
+  void Handler::point(const Item& item)
+  {
+    if (item.type != Item::map) error("point must be a map", item.line);
+
+    Atts atts;
+    for (std::size_t i=0; i+1<item.items.size(); i+=2)
+      atts.push_back({str(item.items[i]), str(item.items[i+1])});
+
+    start("point", atts, item.line);
+    stop ("point", item.line);
+  }
+
+
+  void Handler::obs_group()
+  {
+    start("obs", group_atts_, line_);
+
+    if (group_obs_.type == Item::sequence)
+      for (const Item& e : group_obs_.items)
+        {
+          if (e.type != Item::map) error("observation must be a map", e.line);
+
+          std::string type;
+          Atts atts;
+          bool covmat {false};
+          for (std::size_t i=0; i+1<e.items.size(); i+=2)
+            {
+              const std::string key = str(e.items[i]);
+              if (key == "type")
+                {
+                  type = str(e.items[i+1]);
+                }
+              else if (key == "cov-mat")
+                {
+                  covmat = true;
+                  cov_mat(e.items[i+1]);
+                }
+              else
+                {
+                  atts.push_back({key, str(e.items[i+1])});
+                }
+            }
+
+          if (covmat) continue;
+          if (type.empty()) error("observation type is missing", e.line);
+
+          start(type.c_str(), atts, e.line);
+          stop (type.c_str(), e.line);
+        }
+    else if (group_obs_.type != Item::null)
+      error("node 'obs' must be a list", group_obs_.line);
+
+    stop("obs", line_);
+  }
+
+
+  void Handler::list_item(const Item& item)
+  {
+    if (item.type != Item::map || item.items.empty())
+      error("bad item of " + group_, item.line);
+
+    const std::string key = str(item.items[0]);
+    if (key == "cov-mat")
+      {
+        cov_mat(item.items[1]);
+        return;
+      }
+
+    const char* name {};
+    const Item* data {};
+    if (group_ == "coordinates")
+      {
+        name = "point";
+        data = &item;
+      }
+    else
+      {
+        name = group_ == "vectors" ? "vec" : "dh";
+        if (key != name) error("unknown key " + key, item.line);
+        data = &item.items[1];
+        if (data->type != Item::map) error("bad item of " + group_, item.line);
+      }
+
+    Atts atts;
+    for (std::size_t i=0; i+1<data->items.size(); i+=2)
+      atts.push_back({str(data->items[i]), str(data->items[i+1])});
+
+    start(name, atts, item.line);
+    stop (name, item.line);
+  }
+
+
+  void Handler::cov_mat(const Item& item)
+  {
+    if (item.type != Item::map) error("bad cov-mat", item.line);
+
+    std::string dim, band, cov;
+    for (std::size_t i=0; i+1<item.items.size(); i+=2)
+      {
+        const std::string key = str(item.items[i]);
+        const std::string val = str(item.items[i+1]);
+        if      (key == "dim")        dim  = val;
+        else if (key == "band")       band = val;
+        else if (key == "upper-part") cov  = val;
+        else error("key not found " + key, item.items[i].line);
+      }
+
+    start("cov-mat", Atts{{"dim", dim}, {"band", band}}, item.line);
+    gkf_.character_data(cov, item.line);
+    stop ("cov-mat", item.line);
+  }
+
+
+  void Handler::header()
+  {
+    if (header_) return;
+    header_ = true;
+
+    start("gama-local", Atts{{"xmlns", XSD_GAMA_LOCAL}}, line_);
+    start("network", atts_[0], line_);
+    start("parameters", atts_[1], line_);
+    stop ("parameters", line_);
+    start("points-observations", atts_[2], line_);
+  }
+
+
+  void Handler::finish()
+  {
+    if (!frames_.empty() || !built_.empty())
+      error("incomplete yaml document");
+
+    if (count_points_ != 1)
+      error("mandatory node 'points' must be used exactly once");
+    if (count_observations_ != 1)
+      error("mandatory node 'observations' must be used exactly once");
+
+    stop("points-observations", line_);
+
+    // description is wrapped into lines as in Yaml2gkf
+
+    if (!description_.empty())
+      {
+        std::istringstream istr(description_);
+        std::string word, line, text = "\n";
+        while (istr >> word)
+          {
+            if (line.length() + word.length() > 66)   // 65 + one space
+              {
+                line.pop_back();
+                text += line + "\n";
+                line.clear();
+              }
+            line += word + " ";
+          }
+        if (!line.empty())
+          {
+            line.pop_back();
+            text += line + "\n";
+          }
+
+        start("description", Atts(), line_);
+        gkf_.character_data(text, line_);
+        stop ("description", line_);
+      }
+
+    stop("network", line_);
+    stop("gama-local", line_);
+  }
+
+
+  void Handler::start(const char* name, const Atts& atts, int line)
+  {
+    std::vector<const char*> a;
+    a.reserve(2*atts.size() + 1);
+    for (const auto& nv : atts)
+      {
+        a.push_back(nv.first .c_str());
+        a.push_back(nv.second.c_str());
+      }
+    a.push_back(nullptr);
+
+    gkf_.start_element(name, a.data(), line);
+  }
+
+
+  std::string Handler::str(const Item& item)
+  {
+    if (item.type == Item::map || item.type == Item::sequence)
+      error("scalar value expected", item.line);
+
+    return item.value;
+  }
+
+}  // unnamed namespace
+
+
+void YamlReader::read(std::istream& input)
+{
+  GKFparser gkf(lnet_);
+  Handler   handler(gkf);
+
+  try
+    {
+      YAML::Parser parser(input);
+      if (!parser.HandleNextDocument(handler))
+        throw ParserException("empty yaml document", 0, -1);
+    }
+  catch (const YAML::Exception& e)
+    {
+      throw ParserException(e.msg, e.mark.line + 1, -1);
+    }
+
+  handler.finish();
+}
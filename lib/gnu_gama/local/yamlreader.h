@@ -0,0 +1,52 @@
+/* YamlReader --- reading yaml input data into LocalNetwork
+   Copyright (C) 2026 Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   Class YamlReader is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   YamlReader is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with GNU Gama.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef gama_local_YamlReader_h_
+#define gama_local_YamlReader_h_
+
+#include <istream>
+#include <gnu_gama/local/network.h>
+
+namespace GNU_gama { namespace local {
+
+/** \brief Reads yaml input data (the format of Yaml2gkf) directly
+ *  into a LocalNetwork.
+ *
+ * The document is processed by yaml-cpp parser events, only single
+ * points and observation groups are held in memory. Points, clusters
+ * and covariance matrices are passed to GKFparser as elements, there is
+ * no intermediate XML text.
+ *
+ * Top level nodes can be given in any order, but 'defaults' must
+ * precede 'points' and 'observations'. Errors are thrown as
+ * ParserException with the line number of the yaml input.
+ */
+
+class YamlReader {
+public:
+  explicit YamlReader(LocalNetwork& lnet) : lnet_(lnet) {}
+
+  void read(std::istream& input);
+
+private:
+  LocalNetwork& lnet_;
+};
+
+}}
+#endif
@@ -20,6 +20,8 @@
 */
 
 #include <list>
+#include <mutex>
+#include <vector>
 #include <cmath>
 
 #ifndef GNU_gama_obsdata_h_gnugamaobsdata_observation_data_gnu_gama_obsdata
@@ -45,7 +47,8 @@ namespace GNU_gama {
 
 
       Cluster(const ObservationData<Observation>* od)
-        : observation_data(od), act_obs(0), act_dim(0), act_nonz(0)
+        : observation_data(od), act_obs(0), act_dim(0), act_nonz(0),
+          act_chol_var(0)
         {
         }
       virtual ~Cluster();
@@ -68,6 +71,8 @@ namespace GNU_gama {
       int  activeNonz() const { return act_nonz; }
       typename Observation::CovarianceMatrix
            activeCov() const;
+      const typename Observation::CovarianceMatrix&
+           activeChol(double variance) const;
       void scaleCov(int i, double sc);
 
     private:    // no copy ctor and no assignment
@@ -76,6 +81,21 @@ namespace GNU_gama {
       void operator=(const Cluster&);
 
       int act_obs, act_dim, act_nonz;
+
+      /* Cholesky factor of active cofactors is cached together with the
+       * active covariances it was computed from. The factor is rebuilt
+       * if the a priori variance or any active covariance differs, so
+       * that direct changes of covariance_matrix are detected; changes
+       * of the active set are detected by update(). The cache is guarded
+       * by a mutex, activeChol() can be called from parallel tasks.
+       */
+      std::vector<int> act_ind;      // active indexes in covariance_matrix
+      mutable std::mutex act_mutex;
+      mutable typename Observation::CovarianceMatrix act_src, act_chol;
+      mutable double act_chol_var;   // zero if act_chol is not valid
+
+      bool active_cov_equal(const typename Observation::CovarianceMatrix&)
+        const;
     };
 
 
@@ -308,7 +328,9 @@ namespace GNU_gama {
       act_obs   = 0;
       act_dim   = 0;
       act_nonz  = 0;
-      int index = 0;
+      int index = 0, n = 1;
+      std::vector<int> ind;
+      ind.reserve(act_ind.size());
       Observation* p;
       for (typename std::list<Observation*>::iterator
              i=observation_list.begin(); i!=observation_list.end(); ++i)
@@ -320,7 +342,16 @@ namespace GNU_gama {
             {
               act_obs++;
               act_dim += p->dimension();
+              for (int d=0; d < p->dimension(); d++) ind.push_back(n + d);
             }
+          n += p->dimension();
+        }
+
+      if (ind != act_ind)
+        {
+          std::lock_guard<std::mutex> lock(act_mutex);
+          act_ind.swap(ind);
+          act_chol_var = 0;
         }
 
       if (act_dim)
@@ -348,30 +379,77 @@ namespace GNU_gama {
         active_band = 0;
 
       typename Observation::CovarianceMatrix C(N, active_band);
-      int* ind = new int[act_dim + 1];
-      int  k=1, n=1;
+      const int* ind = act_ind.data() - 1;    // indexed from 1
 
-      for (typename std::list<Observation*>::const_iterator
-             i=observation_list.begin(),
-             e=observation_list.end(); i!=e; ++i)
-        {
-          const Observation* obs = *i;
+      for (int i=1; i<=N; i++)
+        for (int j=0; j<=active_band && i+j<=N; j++)
+          C(i, i+j) = covariance_matrix(ind[i], ind[i+j]);
 
-          if (obs->active())
-            for (int d=0; d < obs->dimension(); d++)
-              {
-                ind[k++] = n + d;
-              }
+      return C;
+    }
 
-          n += obs->dimension();
-        }
+
+
+  template <typename Observation>
+    bool Cluster<Observation>::active_cov_equal
+    (const typename Observation::CovarianceMatrix& C) const
+    {
+      const int N     = activeDim();
+      int active_band = covariance_matrix.bandWidth();
+      if (N-1 < active_band) active_band = N ? N-1 : 0;
+
+      if (C.dim() != N || C.bandWidth() != active_band) return false;
+
+      const int* ind = act_ind.data() - 1;
 
       for (int i=1; i<=N; i++)
         for (int j=0; j<=active_band && i+j<=N; j++)
-          C(i, i+j) = covariance_matrix(ind[i], ind[i+j]);
+          if (C(i, i+j) != covariance_matrix(ind[i], ind[i+j])) return false;
 
-      delete[] ind;
-      return C;
+      return true;
+    }
+
+
+
+  /* Cholesky decomposition L*trans(L) of active cofactors, i.e. of
+   * active covariances divided by a priori variance. Lower triangular
+   * factor L is stored in the band matrix including its diagonal, as
+   * computed by Adj::choldec(). The returned reference is valid until
+   * active covariances change or another variance is requested.
+   */
+
+  template <typename Observation>
+    const typename Observation::CovarianceMatrix&
+       Cluster<Observation>::activeChol(double variance) const
+    {
+      std::lock_guard<std::mutex> lock(act_mutex);
+
+      if (act_chol_var == variance && active_cov_equal(act_src))
+        return act_chol;
+
+      act_chol_var = 0;
+      act_src = activeCov();
+
+      typename Observation::CovarianceMatrix& chol = act_chol;
+      chol = act_src;
+      chol /= variance;                 // covariances ==> cofactors
+      chol.cholDec();
+
+      const int N = chol.rows();
+      const int b = chol.bandWidth();
+
+      for (int m, j, i=1; i<=N; i++)
+        {
+          double d = std::sqrt(chol(i,i));
+          chol(i,i) = d;
+
+          m = i+b;  if(N < m) m = N;    // m = min(N, i+b);
+
+          for (j=i+1; j<=m; j++) chol(i,j) *= d;
+        }
+
+      act_chol_var = variance;
+      return chol;
     }
 
 
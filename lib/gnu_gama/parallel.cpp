@@ -0,0 +1,269 @@
+/*
+    GNU Gama --- Geodesy and Mapping C++ library
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gnu_gama/parallel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+  using Task = std::function<void()>;
+
+  /* Work-stealing thread pool. Each worker has its own task queue,
+   * served from the back; idle workers and waiting callers steal
+   * tasks from the front of other queues. */
+
+  class ThreadPool
+  {
+  public:
+
+    explicit ThreadPool(unsigned workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void run(std::vector<Task>& tasks);
+
+  private:
+
+    struct Queue
+    {
+      std::mutex       mutex;
+      std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread>            workers;
+
+    std::mutex               sleep_mutex;
+    std::condition_variable  wake;
+    std::atomic<std::size_t> queued {0};
+    bool                     stop   {false};
+    std::size_t              next   {0};    // round robin distribution
+
+    bool pop  (std::size_t self, Task& task);
+    void worker(std::size_t self);
+  };
+
+
+  ThreadPool::ThreadPool(unsigned n)
+  {
+    for (unsigned i=0; i<n; i++) queues.emplace_back(new Queue);
+    for (unsigned i=0; i<n; i++) workers.emplace_back(&ThreadPool::worker,
+                                                      this, i);
+  }
+
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stop = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+  }
+
+
+  // own queue first (LIFO), then stealing from the other queues (FIFO)
+
+  bool ThreadPool::pop(std::size_t self, Task& task)
+  {
+    const std::size_t N = queues.size();
+    if (self < N)
+      {
+        Queue& q = *queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty())
+          {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            --queued;
+            return true;
+          }
+      }
+
+    for (std::size_t k=1; k<=N; k++)
+      {
+        Queue& q = *queues[(self + k) % N];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty())
+          {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            --queued;
+            return true;
+          }
+      }
+
+    return false;
+  }
+
+
+  void ThreadPool::worker(std::size_t self)
+  {
+    for (;;)
+      {
+        Task task;
+        if (pop(self, task))
+          {
+            task();
+            continue;
+          }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this]() { return stop || queued > 0; });
+        if (stop) return;
+      }
+  }
+
+
+  void ThreadPool::run(std::vector<Task>& tasks)
+  {
+    struct Batch
+    {
+      std::atomic<std::size_t> left {0};
+      std::mutex               mutex;
+      std::exception_ptr       error;
+      std::size_t              error_index {0};
+    } batch;
+
+    const std::size_t N = tasks.size();
+    batch.left = N;
+
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      for (std::size_t i=0; i<N; i++)
+        {
+          Task wrapped = [&batch, &tasks, i]()
+            {
+              try
+                {
+                  tasks[i]();
+                }
+              catch (...)
+                {
+                  std::lock_guard<std::mutex> lock(batch.mutex);
+                  if (!batch.error || i < batch.error_index)
+                    {
+                      batch.error = std::current_exception();
+                      batch.error_index = i;
+                    }
+                }
+              batch.left.fetch_sub(1, std::memory_order_release);
+            };
+
+          Queue& q = *queues[next++ % queues.size()];
+          std::lock_guard<std::mutex> qlock(q.mutex);
+          q.tasks.push_back(std::move(wrapped));
+          ++queued;
+        }
+    }
+    wake.notify_all();
+
+    // the calling thread (possibly a worker in nested loops) helps
+    // until all tasks of this batch are finished
+
+    const std::size_t self = queues.size();
+    while (batch.left.load(std::memory_order_acquire))
+      {
+        Task task;
+        if (pop(self, task))
+          task();
+        else
+          std::this_thread::yield();
+      }
+
+    if (batch.error) std::rethrow_exception(batch.error);
+  }
+
+
+  std::atomic<unsigned>       thread_count {0};     // 0 ... not initialized
+  std::unique_ptr<ThreadPool> thread_pool;
+  std::mutex                  thread_pool_mutex;
+
+  unsigned hardware_threads()
+  {
+    const unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+  }
+
+}  // unnamed namespace
+
+
+namespace GNU_gama {
+
+  unsigned threads()
+  {
+    if (thread_count == 0)
+      {
+        unsigned n = 1;
+        if (const char* env = std::getenv("GNU_GAMA_THREADS"))
+          {
+            char* end = nullptr;
+            const long t = std::strtol(env, &end, 10);
+            if (end != env && *end == 0 && t >= 0)
+              n = t ? static_cast<unsigned>(t) : hardware_threads();
+          }
+        thread_count = n;
+      }
+
+    return thread_count;
+  }
+
+
+  void set_threads(unsigned n)
+  {
+    std::lock_guard<std::mutex> lock(thread_pool_mutex);
+
+    thread_count = n ? n : hardware_threads();
+    thread_pool.reset();
+  }
+
+
+  void parallel_run(std::vector<std::function<void()>>& tasks)
+  {
+    if (tasks.empty()) return;
+
+    if (threads() == 1 || tasks.size() == 1)
+      {
+        for (auto& task : tasks) task();
+        return;
+      }
+
+    ThreadPool* pool;
+    {
+      std::lock_guard<std::mutex> lock(thread_pool_mutex);
+      if (!thread_pool) thread_pool.reset(new ThreadPool(threads() - 1));
+      pool = thread_pool.get();
+    }
+
+    pool->run(tasks);
+  }
+
+}  // namespace GNU_gama
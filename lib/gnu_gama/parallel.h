@@ -0,0 +1,138 @@
+/*
+    GNU Gama --- Geodesy and Mapping C++ library
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_gama_parallel_h_GNU_gama_parallel_for_parallel_reduce
+#define GNU_gama_parallel_h_GNU_gama_parallel_for_parallel_reduce
+
+#include <functional>
+#include <vector>
+
+namespace GNU_gama {
+
+  /** \brief Number of threads used by parallel_for() and parallel_reduce().
+   *
+   * Unless set_threads() was called, the value is read from the
+   * environment variable GNU_GAMA_THREADS; the implicit value is 1
+   * (serial computation).
+   */
+  unsigned threads();
+
+  /** \brief Set the number of threads, 0 stands for all available cores.
+   *
+   * Must not be called while a parallel loop is running.
+   */
+  void set_threads(unsigned n);
+
+  /** \brief Run all tasks in the shared work-stealing thread pool.
+   *
+   * The calling thread takes part in the computation and returns when
+   * all tasks are finished. If any task throws, the exception of the
+   * task with the lowest index is rethrown.
+   */
+  void parallel_run(std::vector<std::function<void()>>& tasks);
+
+
+  /** \brief Apply body(i0, i1) on consecutive subranges [i0, i1) of
+   *  [begin, end), each of at most grain indexes.
+   *
+   * With a single thread the body is called once for the whole range,
+   * i.e. the computation is identical with a plain serial loop.
+   */
+  template <typename Index, typename Body>
+  void parallel_for(Index begin, Index end, Index grain, Body body)
+  {
+    if (end <= begin) return;
+    if (grain < 1) grain = 1;
+
+    if (threads() == 1 || end - begin <= grain)
+      {
+        body(begin, end);
+        return;
+      }
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve((end - begin)/grain + 1);
+    for (Index i0=begin; i0<end; )
+      {
+        const Index i1 = (end - i0 > grain) ? i0 + grain : end;
+        tasks.emplace_back([&body, i0, i1]() { body(i0, i1); });
+        i0 = i1;
+      }
+
+    parallel_run(tasks);
+  }
+
+
+  /** \brief Reduction of partial results body(i0, i1) over subranges
+   *  [i0, i1) of [begin, end).
+   *
+   * Subranges depend only on grain and partial results are combined
+   * from left to right, so the result does not depend on the number of
+   * threads or on task scheduling. A single thread evaluates the same
+   * subranges serially in the same order.
+   */
+  template <typename Index, typename T, typename Body, typename Combine>
+  T parallel_reduce(Index begin, Index end, Index grain, T identity,
+                    Body body, Combine combine)
+  {
+    if (end <= begin) return identity;
+    if (grain < 1) grain = 1;
+
+    const Index chunks = (end - begin + grain - 1)/grain;
+
+    if (threads() == 1 || chunks == 1)
+      {
+        T result = identity;
+        for (Index i0=begin; i0<end; )
+          {
+            const Index i1 = (end - i0 > grain) ? i0 + grain : end;
+            result = combine(result, body(i0, i1));
+            i0 = i1;
+          }
+
+        return result;
+      }
+
+    struct Partial { T value; };         // avoids std::vector<bool>
+    std::vector<Partial> partial(chunks, Partial{identity});
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunks);
+    for (Index k=0; k<chunks; k++)
+      {
+        const Index i0 = begin + k*grain;
+        const Index i1 = (end - i0 > grain) ? i0 + grain : end;
+        tasks.emplace_back([&body, &partial, k, i0, i1]()
+                           {
+                             partial[k].value = body(i0, i1);
+                           });
+      }
+
+    parallel_run(tasks);
+
+    T result = identity;
+    for (const Partial& p : partial) result = combine(result, p.value);
+
+    return result;
+  }
+
+}  // namespace GNU_gama
+
+#endif
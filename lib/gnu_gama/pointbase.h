@@ -19,8 +19,11 @@
     Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <cstddef>
+#include <deque>
 #include <map>
 #include <iterator>
+#include <vector>
 
 
 #ifndef GNU_gama_point_data_h_gnugamapointbase_gnu_gama_pointbase
@@ -30,17 +33,35 @@
 namespace GNU_gama {
 
 
+  /** \brief Point database
+   *
+   * Points are stored by value in a block list (std::deque never moves
+   * its elements when new points are added) and point names are mapped
+   * to indices of points in the storage. Index of a point does not
+   * change until the point is erased, observations can refer to points
+   * by index instead of repeated name lookups. Iterators traverse
+   * points ordered by names.
+   */
+
   template <typename Point>
     class PointBase
     {
     private:
 
-      typedef  std::map<typename Point::Name, Point*>  Points;
+      typedef  std::map<typename Point::Name, std::size_t>  Points;
+      typedef  std::deque<Point>                            Storage;
+
       Points   points;
+      Storage  storage;
+      std::vector<std::size_t> free_slots;
       typename Point::Common* common;
 
+      std::size_t new_slot();
+
     public:
 
+      static const std::size_t npos = std::size_t(-1);
+
       PointBase() : common(0) {}
       PointBase(const PointBase& cod);
       ~PointBase();
@@ -53,6 +74,12 @@ namespace GNU_gama {
       Point*       find(const typename Point::Name&);
       const Point* find(const typename Point::Name&) const;
 
+      Point* add(const typename Point::Name&);
+
+      std::size_t  index(const typename Point::Name&) const;
+      Point*       at(std::size_t i)       { return &storage[i]; }
+      const Point* at(std::size_t i) const { return &storage[i]; }
+
       void erase(const typename Point::Name&);
       void erase();
 
@@ -61,7 +88,8 @@ namespace GNU_gama {
         {
         public:
 
-          const_iterator(const typename Points::const_iterator& p) : pit(p)
+          const_iterator(const typename Points::const_iterator& p,
+                         const Storage* s) : pit(p), store(s)
             {
             }
           bool operator==(const const_iterator& x) const
@@ -79,22 +107,23 @@ namespace GNU_gama {
             }
           const_iterator operator++(int)
             {
-              const_iterator tmp(pit);
+              const_iterator tmp(pit, store);
               ++pit;
               return tmp;
             }
           const Point* operator*() const
             {
-              return (*pit).second;
+              return &(*store)[(*pit).second];
             }
 
         private:
           typename Points::const_iterator pit;
+          const Storage* store;
 
         };
 
-      const_iterator  begin() const { return points.begin(); }
-      const_iterator  end  () const { return points.end  (); }
+      const_iterator  begin() const { return {points.begin(), &storage}; }
+      const_iterator  end  () const { return {points.end  (), &storage}; }
 
 
       class iterator
@@ -102,12 +131,13 @@ namespace GNU_gama {
         {
         public:
 
-          iterator(const typename Points::iterator& p) : pit(p)
+          iterator(const typename Points::iterator& p, Storage* s)
+            : pit(p), store(s)
             {
             }
           operator const_iterator() const
             {
-              return const_iterator(pit);
+              return const_iterator(pit, store);
             }
           bool operator==(const iterator& x) const
             {
@@ -124,22 +154,23 @@ namespace GNU_gama {
             }
           iterator operator++(int)
             {
-              iterator tmp(pit);
+              iterator tmp(pit, store);
               ++pit;
               return tmp;
             }
           Point* operator*() const
             {
-              return (*pit).second;
+              return &(*store)[(*pit).second];
             }
 
         private:
           typename Points::iterator pit;
+          Storage* store;
 
         };
 
-      iterator  begin() { return points.begin(); }
-      iterator  end  () { return points.end  (); }
+      iterator  begin() { return {points.begin(), &storage}; }
+      iterator  end  () { return {points.end  (), &storage}; }
 
       typename Point::Common* common_data() const { return common; }
       void set_common_data(typename Point::Common*);
@@ -155,12 +186,10 @@ namespace GNU_gama {
 
   template <typename Point>
     PointBase<Point>::PointBase(const PointBase& cpd)
+      : points(cpd.points), storage(cpd.storage),
+        free_slots(cpd.free_slots), common(cpd.common)
     {
-      common = cpd.common;
-      for (const_iterator p=cpd.begin(), e=cpd.end(); p!=e; ++p)
-        {
-          put( **p );
-        }
+      set_common_data(common);
     }
 
 
@@ -170,11 +199,10 @@ namespace GNU_gama {
       if (this != &cpd)
         {
           erase();
-          common = cpd.common;
-          for (const_iterator p=cpd.begin(), e=cpd.end(); p!=e; ++p)
-            {
-              put( **p );
-            }
+          points     = cpd.points;
+          storage    = cpd.storage;
+          free_slots = cpd.free_slots;
+          set_common_data(cpd.common);
         }
 
       return *this;
@@ -182,43 +210,57 @@ namespace GNU_gama {
 
 
   template <typename Point>
-    void PointBase<Point>::put(const Point& point)
+    std::size_t PointBase<Point>::new_slot()
     {
-      Point* ptr = find(point.name);
-
-      if (ptr)
+      if (!free_slots.empty())
         {
-          *ptr = point;
+          std::size_t i = free_slots.back();
+          free_slots.pop_back();
+          return i;
         }
-      else
+
+      storage.emplace_back();
+      return storage.size() - 1;
+    }
+
+
+  template <typename Point>
+    Point* PointBase<Point>::add(const typename Point::Name& name)
+    {
+      Point* ptr = find(name);
+
+      if (ptr == 0)
         {
-          ptr = new Point(point);
-          points[ptr->name] = ptr;
+          std::size_t i = new_slot();
+          ptr = &storage[i];
+          ptr->name = name;
+          points[name] = i;
         }
 
       ptr->common = common;
+      return ptr;
     }
 
 
   template <typename Point>
-    void PointBase<Point>::put(Point*& point_ptr)
+    void PointBase<Point>::put(const Point& point)
     {
-      typename Points::iterator t = points.find(point_ptr->name);
+      Point* ptr = add(point.name);
+      *ptr = point;
+      ptr->common = common;
+    }
 
-      if (t != points.end())
-        {
-          Point* ptr = (*t).second;
 
-          if (ptr != point_ptr)
-            {
-              *ptr = *point_ptr;
-              delete  point_ptr;
-              point_ptr = ptr;
-            }
-        }
-      else
+  template <typename Point>
+    void PointBase<Point>::put(Point*& point_ptr)
+    {
+      Point* ptr = add(point_ptr->name);
+
+      if (ptr != point_ptr)
         {
-          points[point_ptr->name] = point_ptr;
+          *ptr = *point_ptr;
+          delete  point_ptr;
+          point_ptr = ptr;
         }
 
       point_ptr->common = common;
@@ -231,7 +273,7 @@ namespace GNU_gama {
       typename Points::iterator t = points.find(name);
       if (t != points.end())
         {
-          return (*t).second;
+          return &storage[(*t).second];
         }
 
       return 0;
@@ -244,20 +286,34 @@ namespace GNU_gama {
       typename Points::const_iterator t = points.find(name);
       if (t != points.end())
         {
-          return (*t).second;
+          return &storage[(*t).second];
         }
 
       return 0;
     }
 
 
+  template <typename Point>
+    std::size_t PointBase<Point>::index(const typename Point::Name& name) const
+    {
+      typename Points::const_iterator t = points.find(name);
+      if (t != points.end())
+        {
+          return (*t).second;
+        }
+
+      return npos;
+    }
+
+
   template <typename Point>
     void PointBase<Point>::erase(const typename Point::Name& name)
     {
       typename Points::iterator t = points.find(name);
       if (t != points.end())
         {
-          delete (*t).second;
+          storage[(*t).second] = Point();
+          free_slots.push_back((*t).second);
           points.erase(t);
         }
     }
@@ -266,15 +322,9 @@ namespace GNU_gama {
   template <typename Point>
     void PointBase<Point>::erase()
     {
-      typename Points::iterator t = points.begin();
-      typename Points::iterator e = points.end();
-      while (t != e)
-        {
-          delete (*t).second;
-          ++t;
-        }
-
-      points.erase(points.begin(), points.end());
+      points.clear();
+      storage.clear();
+      free_slots.clear();
     }
 
 
@@ -287,7 +337,7 @@ namespace GNU_gama {
       typename Points::iterator e = points.end();
       while (t != e)
         {
-          (*t).second->common = common;
+          storage[(*t).second].common = common;
           ++t;
         }
 
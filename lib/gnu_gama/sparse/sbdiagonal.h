@@ -26,6 +26,7 @@
 #include <cstring>
 #include <algorithm>
 #include <cmath>
+#include <gnu_gama/parallel.h>
 
 namespace GNU_gama {
 
@@ -36,7 +37,7 @@ namespace GNU_gama {
 
     Index   blocks_;       // number of diagonal blocks
     Float*  nonz_;         // all nonzero elements
-    Index   ncnt_;         // number of all nonzeroes
+    std::size_t ncnt_;     // number of all nonzeroes
     Index   size_;
     Index*  dim_;
     Index*  width_;
@@ -53,7 +54,7 @@ namespace GNU_gama {
       delete[] nonz_;
     }
 
-    void init(Index blcks, Index floats)
+    void init(Index blcks, std::size_t floats)
     {
       dim_    = new Index [blcks+1];  // 1 based indexes
       width_  = new Index [blcks+1];
@@ -76,7 +77,7 @@ namespace GNU_gama {
       begin_ = 0;
     }
 
-    BlockDiagonal(Index blcks, Index floats)
+    BlockDiagonal(Index blcks, std::size_t floats)
     {
       init(blcks, floats);
     }
@@ -86,7 +87,7 @@ namespace GNU_gama {
       clear();
     }
 
-    void reset(Index blcks, Index floats)
+    void reset(Index blcks, std::size_t floats)
     {
       clear();
       init (blcks, floats);
@@ -94,7 +95,7 @@ namespace GNU_gama {
 
     Index  blocks()        const { return blocks_;   }
     Index  dim()           const { return size_;     }
-    Index  nonzeroes()     const { return ncnt_;     }
+    std::size_t nonzeroes() const { return ncnt_;    }
     Index  dim   (Index i) const { return dim_  [i]; }
     Index  width (Index i) const { return width_[i]; }
 
@@ -108,7 +109,7 @@ namespace GNU_gama {
       return replicate(blocks_, ncnt_);
     }
 
-    BlockDiagonal* replicate(Index new_blocks, Index new_floats) const
+    BlockDiagonal* replicate(Index new_blocks, std::size_t new_floats) const
     {
       BlockDiagonal* r = new BlockDiagonal(new_blocks, new_floats);
 
@@ -122,7 +123,8 @@ namespace GNU_gama {
 
     void add_block(Index bdim, Index bwidth, const Float* mem)
     {
-      Index N = bdim*(bwidth+1) - (bwidth)*(bwidth+1)/2;
+      const std::size_t d = bdim, w = bwidth;
+      const std::size_t N = d*(w+1) - w*(w+1)/2;
 
       blocks_++;
       size_ += bdim;
@@ -138,37 +140,49 @@ namespace GNU_gama {
 
     int cholDec(Float tol = 1e-14)
     {
-      Float* B;
-      Float* p;
-      Index  N, W, row, k, l, n;
-      Float  q, pivot;
+      // diagonal blocks are independent and can be decomposed in
+      // parallel, the first block which is not positive-definite is
+      // returned
+
+      return parallel_reduce(Index(1), blocks_+1, Index(16), Index(0),
+                             [this, tol](Index first, Index last)
+                             {
+                               for (Index block=first; block<last; block++)
+                                 if (!cholDec(block, tol)) return block;
+                               return Index(0);
+                             },
+                             [](Index a, Index b) { return a ? a : b; });
+    }
 
-      for (Index block=1; block<=blocks_; block++)
-      {
-        B = begin(block);
-        N = dim  (block);
-        W = width(block);
+  private:
 
-        for (row=1; row<=N; row++)
-          {
-            if ((pivot = *B) < tol)
-              return block;                  // not positive-definite
-
-            k = std::min(W, N-row);          // number of of-diagonal elements
-            p = B+k;                         // next row address -1
-            for (n=1; n<=k; n++)
-              {
-                q = B[n]/pivot;
-                for (l=n; l<=k; l++) p[l] -= q*B[l];
-                p += std::min(W, N-row-n);
-              }
-            *B++ = pivot = std::sqrt(pivot); // scaling pivot row
-            for (; k; k--) *B++ /= pivot;
-          }
+    bool cholDec(Index block, Float tol)
+    {
+      Float* B = begin(block);
+      Index  N = dim  (block);
+      Index  W = width(block);
+      Index  k, l, n;
+      Float  q, pivot;
+      Float* p;
 
-      }   // block ...
+      for (Index row=1; row<=N; row++)
+        {
+          if ((pivot = *B) < tol)
+            return false;                    // not positive-definite
+
+          k = std::min(W, N-row);            // number of of-diagonal elements
+          p = B+k;                           // next row address -1
+          for (n=1; n<=k; n++)
+            {
+              q = B[n]/pivot;
+              for (l=n; l<=k; l++) p[l] -= q*B[l];
+              p += std::min(W, N-row-n);
+            }
+          *B++ = pivot = std::sqrt(pivot);   // scaling pivot row
+          for (; k; k--) *B++ /= pivot;
+        }
 
-      return 0;
+      return true;
     }
 
   };
@@ -185,7 +199,7 @@ namespace GNU_gama {
     ~UpperBlockDiagonal()   { delete[] row;               }
 
     Index dim()       const { return blockd->dim();       }
-    Index nonzeroes() const { return blockd->nonzeroes(); }
+    std::size_t nonzeroes() const { return blockd->nonzeroes(); }
 
     const Float* begin(Index i) const { return row[ i ];  }
     const Float* end  (Index i) const { return row[i+1];  }
@@ -23,7 +23,11 @@
 #define GNU_gama_gama_local_Sparse_General_Matrix_General_Matrix_
 
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <new>
+#include <gnu_gama/exception.h>
 
 
 namespace GNU_gama {
@@ -34,25 +38,65 @@ template <typename Float=double, typename Index=int>
 
   class SparseMatrix {
 
-    // sparse general matrix is a set of unordered sparse rows
+    // sparse general matrix is a set of unordered sparse rows; row
+    // offsets are 64-bit, column indexes are of type Index
+
+    using Offset = std::size_t;
 
     Index   rows_, cols_;
 
     Float*  nonz;   // non-zero elements
     Index*  cind;   // column indexes of nonzero elements
-    Index*  rptr;   // indexes to the beginning of the i-th row
+    Offset* rptr;   // offsets to the beginning of the i-th row
 
-    Index*  rptr1;
-    Index   rcnt_, rnxt_, ncnt_;
+    Offset* rptr1;
+    Index   rcnt_, rnxt_;
+    Offset  ncnt_;
+    Offset  nmax_;  // number of allocated nonzero elements
 
     SparseMatrix  (const SparseMatrix&);
     void operator=(const SparseMatrix&);
 
+    /* nonzero elements and column indexes are allocated by malloc so
+     * that shrink_to_fit() can release the unused reserved memory
+     * with realloc, without copying */
+
+    template <typename T> static T* alloc(Offset n)
+    {
+      if (n > std::numeric_limits<Offset>::max()/sizeof(T))
+        throw std::bad_alloc();
+
+      T* p = static_cast<T*>(std::malloc((n > 0 ? n : 1)*sizeof(T)));
+      if (p == 0) throw std::bad_alloc();
+      return p;
+    }
+
+    /* dimensions must be nonnegative and row pointers rows+2 (or
+     * cols+4 of the transposed matrix) must be in the range of Index */
+
+    static void check(Index rows, Index cols)
+    {
+      const Index max = std::numeric_limits<Index>::max();
+      bool negative = false;
+      if constexpr (std::numeric_limits<Index>::is_signed)
+        negative = rows < 0 || cols < 0;
+      if (negative || rows > max - 4 || cols > max - 4)
+        throw GNU_gama::Exception::string("SparseMatrix : dimension "
+                                          "exceeds the index range");
+    }
+
+    template <typename T> static void shrink(T*& p, Offset n)
+    {
+      if (n == 0) return;
+      if (T* q = static_cast<T*>(std::realloc(p, n*sizeof(T)))) p = q;
+    }
+
     SparseMatrix  (const SparseMatrix* sm)
     {
-      nonz = new Float[sm->ncnt_];
-      cind = new Index[sm->ncnt_];
-      rptr = new Index[sm->cols_ + 4];
+      check(sm->rows_, sm->cols_);
+      nonz = alloc<Float>(sm->ncnt_);
+      cind = alloc<Index>(sm->ncnt_);
+      rptr = new Offset[sm->cols_ + 4];
 
       rptr1  = rptr + 1;
       rows_  = sm->cols_;
@@ -60,23 +104,27 @@ template <typename Float=double, typename Index=int>
       rcnt_  = sm->cols_;
       rnxt_  = rcnt_ + 1;
       ncnt_  = sm->ncnt_;
+      nmax_  = sm->ncnt_;
     }
 
     public:
 
-    using size_type = Index;
+    using size_type   = Index;
+    using offset_type = Offset;
 
     SparseMatrix()
     {
       nonz = 0;
-      cind = rptr = 0;
+      cind = 0;
+      rptr = 0;
     }
 
-    SparseMatrix(Index floats, Index rows, Index cols)
+    SparseMatrix(Offset floats, Index rows, Index cols)
     {
-      nonz = new Float[floats];
-      cind = new Index[floats];
-      rptr = new Index[rows+2];
+      check(rows, cols);
+      nonz = alloc<Float>(floats);
+      cind = alloc<Index>(floats);
+      rptr = new Offset[rows+2];
 
       rptr1  = rptr + 1;
       rows_  = rows;
@@ -84,35 +132,41 @@ template <typename Float=double, typename Index=int>
       rcnt_  = 0;
       rnxt_  = 1;
       ncnt_  = 0;
+      nmax_  = floats;
     }
 
     ~SparseMatrix()
     {
-      delete[]  nonz;
-      delete[]  cind;
+      std::free(nonz);
+      std::free(cind);
       delete[]  rptr;
     }
 
     Index rows()      const { return rows_; }
     Index columns()   const { return cols_; }
-    Index nonzeroes() const { return ncnt_; }
+    Offset nonzeroes() const { return ncnt_; }
 
     Float* begin (Index i) const { return nonz + rptr [i]; }
     Float* end   (Index i) const { return nonz + rptr1[i]; }
     Index* ibegin(Index i) const { return cind + rptr [i]; }
     Index* iend  (Index i) const { return cind + rptr1[i]; }
 
-    Index  size  (Index i) const { return rptr1[i]-rptr[i]; }
+    Index  size  (Index i) const { return Index(rptr1[i]-rptr[i]); }
 
-    void reset(Index floats, Index rows, Index cols)
+    void reset(Offset floats, Index rows, Index cols)
     {
-      delete[]  nonz;
-      delete[]  cind;
+      check(rows, cols);
+
+      std::free(nonz);
+      std::free(cind);
       delete[]  rptr;
+      nonz = 0;
+      cind = 0;
+      rptr = 0;
 
-      nonz = new Float[floats];
-      cind = new Index[floats];
-      rptr = new Index[rows+2];
+      nonz = alloc<Float>(floats);
+      cind = alloc<Index>(floats);
+      rptr = new Offset[rows+2];
 
       rptr1  = rptr + 1;
       rows_  = rows;
@@ -120,6 +174,7 @@ template <typename Float=double, typename Index=int>
       rcnt_  = 0;
       rnxt_  = 1;
       ncnt_  = 0;
+      nmax_  = floats;
     }
 
 
@@ -128,7 +183,7 @@ template <typename Float=double, typename Index=int>
       return replicate(ncnt_, rows_, cols_);
     }
 
-    SparseMatrix* replicate(Index new_n, Index new_r, Index new_c) const
+    SparseMatrix* replicate(Offset new_n, Index new_r, Index new_c) const
     {
       SparseMatrix* r = new SparseMatrix(new_n, new_r, new_c);
 
@@ -138,7 +193,7 @@ template <typename Float=double, typename Index=int>
       r->rnxt_ = rnxt_;
       r->ncnt_ = ncnt_;
       using namespace std;
-      memcpy(r->rptr, rptr, (rcnt_+2)*sizeof(Index) );
+      memcpy(r->rptr, rptr, (rcnt_+2)*sizeof(Offset));
       memcpy(r->nonz, nonz,  ncnt_   *sizeof(Float) );
       memcpy(r->cind, cind,  ncnt_   *sizeof(Index) );
 
@@ -151,16 +206,17 @@ template <typename Float=double, typename Index=int>
 
       const Index  trows_ = t->rows_;
       Index*       tcind  = t->cind;
-      Index*       trptr  = t->rptr;
+      Offset*      trptr  = t->rptr;
       Float*       tnonz  = t->nonz;
 
-      Index  i, j, k, r, irb, ire;
+      Index  i, k, r;
+      Offset j, irb, ire;
 
       /* count non-zeroes in all columns and form new transposed row
        * pointer lists in trptr[k], k=3, 4, ... (ie. shifted by 2) */
 
       for (i=0; i<trows_+2; i++)  trptr[i] = 0;
-      for (i=0; i<ncnt_;    i++)  trptr[cind[i]+2]++;
+      for (j=0; j<ncnt_;    j++)  trptr[cind[j]+2]++;
       for (i=3; i<trows_+2; i++)  trptr[i] += trptr[i-1];
 
       /* now we go over each matrix row and copy non-zero elements
@@ -203,6 +259,42 @@ template <typename Float=double, typename Index=int>
       rptr[rnxt_]++;
     }
 
+    /* release memory reserved for nonzero elements beyond nonzeroes();
+     * the matrix filled by rows is then stored in exact size without
+     * any copy */
+
+    void shrink_to_fit()
+    {
+      shrink(nonz, ncnt_);
+      shrink(cind, ncnt_);
+      if (ncnt_) nmax_ = ncnt_;
+    }
+
+    /* number of columns, if not known when the matrix was allocated */
+
+    void set_columns(Index cols) { cols_ = cols; }
+
+    /* fill-in of rows with known sizes in arbitrary order (rows can be
+     * filled in parallel); row_size[i] is the number of nonzero elements
+     * in the i-th row, i = 1, ..., rows(), and their sum must not exceed
+     * the number of allocated floats */
+
+    void set_row_sizes(const Index* row_size)
+    {
+      rptr[1] = 0;
+      for (Index i=1; i<=rows_; i++)
+        {
+          if (Offset(row_size[i]) > nmax_ - rptr[i])
+            throw GNU_gama::Exception::string("SparseMatrix : row sizes "
+                                              "exceed allocated elements");
+          rptr[i+1] = rptr[i] + row_size[i];
+        }
+
+      rcnt_ = rows_;
+      rnxt_ = rows_ + 1;
+      ncnt_ = rptr[rnxt_];
+    }
+
     bool check() const
     {
       bool ok_ = true;
@@ -24,7 +24,9 @@
 
 #include <gnu_gama/sparse/smatrix.h>
 #include <gnu_gama/sparse/intlist.h>
+#include <gnu_gama/exception.h>
 #include <algorithm>
+#include <limits>
 #include <set>
 
 namespace GNU_gama {
@@ -95,6 +97,10 @@ namespace GNU_gama {
                 }
       }
 
+      if (edges.size() > std::size_t(std::numeric_limits<Index>::max()))
+        throw GNU_gama::Exception::string("SparseMatrixGraph : number of "
+                                          "edges exceeds the index range");
+
       this->adjncy.reset(edges.size());
 
       typename std::set<std::pair<Index, Index> >::const_iterator
@@ -0,0 +1,195 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <gnu_gama/streamwriter.h>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+
+using GNU_gama::StreamWriter;
+
+namespace {
+
+  // the longest fixed format of a double is 309 integer digits, sign,
+  // decimal point and precision digits
+  const int max_precision = 160;
+  const int max_length    = 512;
+
+}
+
+
+StreamWriter::StreamWriter(std::ostream& out, std::size_t size)
+  : out_(out), buffer_(std::max<std::size_t>(size, max_length)),
+    flags_(out.flags() & std::ios_base::floatfield),
+    precision_(static_cast<int>(out.precision())),
+    width_(static_cast<int>(out.width(0)))
+{
+}
+
+
+StreamWriter::~StreamWriter()
+{
+  flush();
+}
+
+
+void StreamWriter::flush()
+{
+  if (size_ == 0) return;
+
+  out_.write(buffer_.data(), static_cast<std::streamsize>(size_));
+  size_ = 0;
+}
+
+
+void StreamWriter::write(const char* s, std::size_t n)
+{
+  if (size_ + n > buffer_.size())
+    {
+      flush();
+      if (n > buffer_.size())
+        {
+          out_.write(s, static_cast<std::streamsize>(n));
+          return;
+        }
+    }
+
+  std::memcpy(buffer_.data() + size_, s, n);
+  size_ += n;
+}
+
+
+void StreamWriter::write_padded(const char* s, std::size_t n)
+{
+  if (width_ > 0)
+    {
+      const std::size_t w = static_cast<std::size_t>(width_);
+      width_ = 0;
+
+      for (std::size_t i=n; i<w; i++) write(" ", 1);
+    }
+
+  write(s, n);
+}
+
+
+StreamWriter& StreamWriter::operator << (std::string_view s)
+{
+  write_padded(s.data(), s.size());
+  return *this;
+}
+
+
+StreamWriter& StreamWriter::operator << (char c)
+{
+  write_padded(&c, 1);
+  return *this;
+}
+
+
+template <typename T> StreamWriter& StreamWriter::write_integer(T n)
+{
+  char str[32];
+  auto [end, ec] = std::to_chars(str, str + sizeof(str), n);
+  write_padded(str, end - str);
+  return *this;
+}
+
+StreamWriter& StreamWriter::operator << (int n)
+{
+  return write_integer(n);
+}
+
+StreamWriter& StreamWriter::operator << (long n)
+{
+  return write_integer(n);
+}
+
+StreamWriter& StreamWriter::operator << (long long n)
+{
+  return write_integer(n);
+}
+
+StreamWriter& StreamWriter::operator << (unsigned long n)
+{
+  return write_integer(n);
+}
+
+
+StreamWriter& StreamWriter::operator << (double x)
+{
+  if (precision_ < 0 || precision_ > max_precision)
+    {
+      // not needed in gama outputs, formatted as by the stream
+
+      std::ostringstream ostr;
+      ostr.flags(flags_);
+      ostr.precision(precision_);
+      ostr << x;
+      return *this << ostr.str();
+    }
+
+  std::chars_format format = std::chars_format::general;
+  if (flags_ == std::ios_base::fixed)
+    format = std::chars_format::fixed;
+  else if (flags_ == std::ios_base::scientific)
+    format = std::chars_format::scientific;
+
+  char str[max_length];
+  auto [end, ec] = std::to_chars(str, str + max_length, x, format, precision_);
+  write_padded(str, end - str);
+
+  return *this;
+}
+
+
+std::ios_base::fmtflags StreamWriter::flags(std::ios_base::fmtflags f)
+{
+  std::ios_base::fmtflags old = flags_;
+  flags_ = f & std::ios_base::floatfield;
+  return old;
+}
+
+
+std::ios_base::fmtflags StreamWriter::setf(std::ios_base::fmtflags t,
+                                           std::ios_base::fmtflags v)
+{
+  std::ios_base::fmtflags old = flags_;
+  flags_ = ((flags_ & ~v) | (t & v)) & std::ios_base::floatfield;
+  return old;
+}
+
+
+int StreamWriter::precision(int p)
+{
+  int old = precision_;
+  precision_ = p;
+  return old;
+}
+
+
+int StreamWriter::width(int w)
+{
+  int old = width_;
+  width_ = w;
+  return old;
+}
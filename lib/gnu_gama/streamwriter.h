@@ -0,0 +1,97 @@
+/*
+    GNU Gama -- adjustment of geodetic networks
+    Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+    This file is part of the GNU Gama C++ library.
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef GNU_gama_streamwriter_h_buffered_stream_writer_streamwriterh
+#define GNU_gama_streamwriter_h_buffered_stream_writer_streamwriterh
+
+namespace GNU_gama {
+
+  /** \brief Buffered writer of large text outputs
+   *
+   * Text is collected in a fixed buffer which is passed to the output
+   * stream buffer in whole blocks, numbers are formatted by
+   * std::to_chars. Formatting state (floatfield, precision and width)
+   * is initialized from the output stream and has the same meaning as
+   * for std::ostream, the output is byte compatible with the output
+   * written to the stream directly.
+   *
+   * The buffer is flushed when it is full, by flush() and in the
+   * destructor.
+   */
+
+  class StreamWriter {
+  public:
+
+    explicit StreamWriter(std::ostream& out, std::size_t size = 1 << 16);
+    ~StreamWriter();
+
+    StreamWriter(const StreamWriter&) = delete;
+    StreamWriter& operator=(const StreamWriter&) = delete;
+
+    StreamWriter& operator << (std::string_view s);
+    StreamWriter& operator << (const char* s)
+    {
+      return *this << std::string_view(s);
+    }
+    StreamWriter& operator << (const std::string& s)
+    {
+      return *this << std::string_view(s);
+    }
+    StreamWriter& operator << (char c);
+    StreamWriter& operator << (int n);
+    StreamWriter& operator << (long n);
+    StreamWriter& operator << (long long n);
+    StreamWriter& operator << (unsigned long n);
+    StreamWriter& operator << (double x);
+
+    std::ios_base::fmtflags flags() const { return flags_; }
+    std::ios_base::fmtflags flags(std::ios_base::fmtflags f);
+    std::ios_base::fmtflags setf (std::ios_base::fmtflags t,
+                                  std::ios_base::fmtflags v);
+    int precision() const { return precision_; }
+    int precision(int p);
+    int width(int w);
+
+    void flush();
+
+  private:
+
+    std::ostream&           out_;
+    std::vector<char>       buffer_;
+    std::size_t             size_ {0};
+    std::ios_base::fmtflags flags_;
+    int                     precision_;
+    int                     width_;
+
+    void write(const char* s, std::size_t n);
+    void write_padded(const char* s, std::size_t n);
+    template <typename T> StreamWriter& write_integer(T n);
+  };
+
+}
+
+#endif
@@ -100,6 +100,39 @@ namespace GNU_gama {
         }
     }
 
+    /* Element events from readers of other input formats (YAML). The
+     * handlers are called directly without expat and errors are thrown
+     * with the given line number of the input.
+     */
+
+    void start_element(const char* name, const char** atts, int line)
+    {
+      startElement(name, atts);
+      test_state(line);
+    }
+    void end_element(const char* name, int line)
+    {
+      endElement(name);
+      test_state(line);
+    }
+    void character_data(const std::string& s, int line)
+    {
+      characterDataHandler(s.c_str(), static_cast<int>(s.length()));
+      test_state(line);
+    }
+
+  private:
+
+    void test_state(int line)
+    {
+      if (state == 0)     /*  state_error must be 0  */
+        {
+          errCode = -1;
+          errLineNumber = line;
+          throw ParserException(errString, errLineNumber, errCode);
+        }
+    }
+
   };
 
 
@@ -6,6 +6,7 @@
 #include "comparexyz.h"
 #include <gnu_gama/version.h>
 #include <gnu_gama/xml/localnetwork_adjustment_results.h>  // parser gama-local
+#include <gnu_gama/local/snapshot.h>                       // gama-local snapshot
 #include <gnu_gama/xml/dataparser.h>                       // parser gama-g3
 
 using namespace std;
@@ -26,12 +27,16 @@ void CompareXYZ::fetch_files(std::string file_1, std::string file_2)
 
 void CompareXYZ::fetch_file(string file_name, std::map<std::string, AdjXYZ>& adjmap)
 {
-  ifstream inp(file_name);
+  ifstream inp(file_name, ios_base::binary);
   std::string str_file((std::istreambuf_iterator<char>(inp)),
                        std::istreambuf_iterator<char>());
 
-  bool format_local = (str_file.find("<gama-local-adjustment") != std::string::npos);
-  bool format_g3 = (str_file.find("<g3-adjustment-results>") != std::string::npos);
+  istringstream istr(str_file);
+  bool format_snapshot = GNU_gama::local::Snapshot::test(istr);
+  bool format_local = format_snapshot ||
+    (str_file.find("<gama-local-adjustment") != std::string::npos);
+  bool format_g3 = !format_snapshot &&
+    (str_file.find("<g3-adjustment-results>") != std::string::npos);
 
   if (!format_local && !format_g3)
   {
@@ -43,8 +48,16 @@ void CompareXYZ::fetch_file(string file_name, std::map<std::string, AdjXYZ>& adj
     cout << "# gama-local: " << file_name << "\n";
     using GNU_gama::LocalNetworkAdjustmentResults;
     unique_ptr<LocalNetworkAdjustmentResults> adjres( new LocalNetworkAdjustmentResults );
-    istringstream istr(str_file);
-    adjres->read_xml(istr);
+    if (format_snapshot)
+    {
+      GNU_gama::local::Snapshot snapshot;
+      snapshot.read(istr);
+      snapshot.get_results(*adjres);
+    }
+    else
+    {
+      adjres->read_xml(istr);
+    }
 
     for (const auto& point : adjres->adjusted_points)
     {
@@ -297,13 +297,8 @@ int Utf8Decode(int& u, unsigned char *buf){
 
 char* utf8_cp1250(char *buf){
   static int tab[256];
-  // static int itab=cp1250_unicode((int*)tab);  ... rewritten to avoid warning
-  static bool init_tab = true;
-  if (init_tab)
-    {
-      cp1250_unicode((int*)tab);
-      init_tab = false;
-    }
+  // initialization of local statics is thread safe
+  [[maybe_unused]] static const int itab = cp1250_unicode((int*)tab);
   unsigned int u;
   char *p,*q;
   p=q=buf;
@@ -323,13 +318,8 @@ char* utf8_cp1250(char *buf){
 
 char* utf8_iso_8859_2(char *buf){
   static int tab[256];
-  // static int itab=iso_8859_2_unicode((int*)tab);  ... avoid warning
-  static bool init_tab = true;
-  if (init_tab)
-    {
-      iso_8859_2_unicode((int*)tab);
-      init_tab = false;
-    }
+  // initialization of local statics is thread safe
+  [[maybe_unused]] static const int itab = iso_8859_2_unicode((int*)tab);
   unsigned int u;
   char *p,*q;
   p=q=buf;
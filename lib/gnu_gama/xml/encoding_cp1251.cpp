@@ -74,12 +74,8 @@ int cp1251_unicode(int* tab)
 char* utf8_cp1251(char *buf)
 {
   static int tab[256];
-  static bool init_tab = true;
-  if (init_tab)
-    {
-      cp1251_unicode((int*)tab);
-      init_tab = false;
-    }
+  // initialization of local statics is thread safe
+  [[maybe_unused]] static const int itab = cp1251_unicode((int*)tab);
   unsigned int u;
   char *p,*q;
   p=q=buf;
@@ -34,6 +34,7 @@
 #include <algorithm>
 #include <sstream>
 #include <gnu_gama/xml/localnetworkxml.h>
+#include <gnu_gama/streamwriter.h>
 #include <gnu_gama/xml/str2xml.h>
 #include <gnu_gama/statan.h>
 #include <gnu_gama/gon2deg.h>
@@ -68,15 +69,11 @@ namespace
   int make_check_precision(int) { return 16; }
 }
 
-/** \brief Writes observations XML representation to stream.
- *
- * \todo Remove secondary output stream.
- */
+/** \brief Writes observations XML representation to stream. */
 class WriteXMLVisitor : public GNU_gama::local::AllObservationsVisitor
 {
 private:
-    std::ostream& out;
-    std::ostream* ostr;
+    GNU_gama::StreamWriter& out;
     std::string tag;
     const int linear;
     const int angular;
@@ -84,9 +81,9 @@ private:
     int i;
     const double y_sign;
 public:
-    WriteXMLVisitor(std::ostream& outStream, int linearOutputPrecision, int angularOutputPrecision,
+    WriteXMLVisitor(GNU_gama::StreamWriter& outStream, int linearOutputPrecision, int angularOutputPrecision,
                     const GNU_gama::local::Vec& residuals, double ySign)
-        : out(outStream), ostr(&outStream),
+        : out(outStream),
           linear(linearOutputPrecision), angular(angularOutputPrecision),
           v(residuals), y_sign(ySign)
     {
@@ -97,22 +94,19 @@ public:
     /** \brief Sets index of observation which will be used in the next visit. */
     void setObservationIndex(int index) { i = index; }
 
-    /** If secondary output stream is not specified output stream given in constructor is used. */
-    void setSecondaryOutStream(std::ostream& outStream) { ostr = &outStream; }
-
     void visit(Distance* obs)
     {
       out << "<" << (tag="distance");// << ">";;
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_from_to(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" << m << "</adj>";
     }
     void visit(Direction* obs)
     {
@@ -120,15 +114,15 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(angular);
+      tag_from_to(obs);
+
+      out.precision(angular);
       double m = R2G*(obs->value());
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/10000;
       if (m < 0) m += 400;
       if (m >= 400) m -= 400;
-      *ostr << " <adj>" <<  m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" <<  m << "</adj>";
     }
     void visit(Angle* obs)
     {
@@ -136,17 +130,17 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(angular);
+      out << " <from>"  << obs->from().str() << "</from>"
+          << " <left>"  << obs->bs().str()   << "</left>"
+          << " <right>" << obs->fs().str()   << "</right>\n";
+
+      out.precision(angular);
       double m = R2G*(obs->value());
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/10000;
       if (m < 0) m += 400;
       if (m >= 400) m -= 400;
-      *ostr << "<adj>" << m << "</adj>";
-
-      out << " <from>"  << obs->from() << "</from>"
-          << " <left>"  << obs->bs()   << "</left>"
-          << " <right>" << obs->fs()   << "</right>\n";
+      out << "<adj>" << m << "</adj>";
     }
     void visit(H_Diff* obs)
     {
@@ -154,13 +148,13 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_from_to(obs);
+
+      out.precision(linear);
       double m =obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" << m << "</adj>";
     }
     void visit(S_Distance* obs)
     {
@@ -168,13 +162,13 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_from_to(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" << m << "</adj>";
     }
     void visit(Z_Angle* obs)
     {
@@ -182,13 +176,13 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(angular);
+      tag_from_to(obs);
+
+      out.precision(angular);
       double m = R2G*(obs->value());
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/10000;
-      *ostr << "<adj>" << m << "</adj>";
-
-      tag_from_to(obs);
+      out << "<adj>" << m << "</adj>";
     }
     void visit(X* obs)
     {
@@ -197,13 +191,13 @@ public:
       string s = c->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_id(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << "<adj>" << m << "</adj>";
-
-      tag_id(obs);
+      out << "<adj>" << m << "</adj>";
     }
     void visit(Y* obs)
     {
@@ -212,13 +206,13 @@ public:
       string s = c->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_id(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << y_sign*m << "</obs>";
+      out << "   <obs>" << y_sign*m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << y_sign*m << "</adj>";
-
-      tag_id(obs);
+      out << " <adj>" << y_sign*m << "</adj>";
     }
     void visit(Z* obs)
     {
@@ -227,13 +221,13 @@ public:
       string s = c->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_id(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << m << "</adj>";
-
-      tag_id(obs);
+      out << " <adj>" << m << "</adj>";
     }
     void visit(Xdiff* obs)
     {
@@ -241,13 +235,13 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_from_to(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" << m << "</adj>";
     }
     void visit(Ydiff* obs)
     {
@@ -255,13 +249,13 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_from_to(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << y_sign*m << "</obs>";
+      out << "   <obs>" << y_sign*m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << y_sign*m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" << y_sign*m << "</adj>";
     }
     void visit(Zdiff* obs)
     {
@@ -269,13 +263,13 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(linear);
+      tag_from_to(obs);
+
+      out.precision(linear);
       double m = obs->value();
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/1000;
-      *ostr << " <adj>" << m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" << m << "</adj>";
     }
     void visit(Azimuth* obs)
     {
@@ -283,33 +277,35 @@ public:
       string s = obs->get_extern();
       if (!s.empty()) out << " extern=\"" << s << "\"";
       out << ">";
-      ostr->precision(angular);
+      tag_from_to(obs);
+
+      out.precision(angular);
       double m = R2G*(obs->value());
-      *ostr << " <obs>" << m << "</obs>";
+      out << "   <obs>" << m << "</obs>";
       m += v(i)/10000;
       if (m < 0) m += 400;
       if (m >= 400) m -= 400;
-      *ostr << " <adj>" <<  m << "</adj>";
-
-      tag_from_to(obs);
+      out << " <adj>" <<  m << "</adj>";
     }
 
     void tag_id(const GNU_gama::local::Observation* obs)
     {
-        out << " <id>" << obs->from() << "</id>\n";
+        out << " <id>" << obs->from().str() << "</id>\n";
     }
 
     void tag_from_to(const GNU_gama::local::Observation* obs)
     {
-        out << " <from>" << obs->from() << "</from>"
-            << " <to>"   << obs->to()   << "</to>\n";
+        out << " <from>" << obs->from().str() << "</from>"
+            << " <to>"   << obs->to().str()   << "</to>\n";
     }
 
 };
 
 
-void LocalNetworkXML::write(std::ostream& out) const
+void LocalNetworkXML::write(std::ostream& stream) const
 {
+  GNU_gama::StreamWriter out(stream);
+
   out << "<?xml version=\"1.0\"?>\n"
       << "<gama-local-adjustment "
       << "xmlns=\"" << XSD_GAMA_LOCAL_ADJUSTMENT << "\">\n";
@@ -323,7 +319,9 @@ void LocalNetworkXML::write(std::ostream& out) const
       out << "\n<network-general-parameters\n";
 
       out << "   gama-local-version=\""   << GNU_gama::version()  << "\"\n";
-      out << "   gama-local-algorithm=\"" << netinfo->algorithm() << "\"\n";
+      out << "   gama-local-algorithm=\""
+          << (netinfo->has_prior() ? "sequential" : netinfo->algorithm())
+          << "\"\n";
       out << "   gama-local-compiler=\""  << GNU_gama::compiler() << "\"\n";
 
       out << "   axes-xy=\"";
@@ -385,7 +383,7 @@ void LocalNetworkXML::write(std::ostream& out) const
   out << "\n</gama-local-adjustment>\n";
 }
 
-void LocalNetworkXML::coordinates_summary(std::ostream& out) const
+void LocalNetworkXML::coordinates_summary(GNU_gama::StreamWriter& out) const
 {
   out << "\n<coordinates-summary>\n";
 
@@ -437,7 +435,7 @@ void LocalNetworkXML::coordinates_summary(std::ostream& out) const
 }
 
 
-void LocalNetworkXML::observations_summary(std::ostream& out) const
+void LocalNetworkXML::observations_summary(GNU_gama::StreamWriter& out) const
 {
   out << "\n<observations-summary>\n";
 
@@ -499,20 +497,20 @@ void LocalNetworkXML::observations_summary(std::ostream& out) const
 
 
 template <typename T>
-void LocalNetworkXML::tagnl(std::ostream& out, const char* t, T n) const
+void LocalNetworkXML::tagnl(GNU_gama::StreamWriter& out, const char* t, T n) const
 {
   out << "   <" << t << ">" << n << "</" << t << ">\n";;
 }
 
 
 template <typename T>
-void LocalNetworkXML::tagsp(std::ostream& out, const char* t, T n) const
+void LocalNetworkXML::tagsp(GNU_gama::StreamWriter& out, const char* t, T n) const
 {
   out << "<" << t << ">" << n << "</" << t << "> ";
 }
 
 
-void LocalNetworkXML::equations_summary(std::ostream& out) const
+void LocalNetworkXML::equations_summary(GNU_gama::StreamWriter& out) const
 {
   out << "\n<project-equations>\n";
 
@@ -542,7 +540,7 @@ void LocalNetworkXML::equations_summary(std::ostream& out) const
 }
 
 
-void LocalNetworkXML::std_dev_summary(std::ostream& out) const
+void LocalNetworkXML::std_dev_summary(GNU_gama::StreamWriter& out) const
 {
     out << "\n<standard-deviation>\n";
 
@@ -578,7 +576,7 @@ void LocalNetworkXML::std_dev_summary(std::ostream& out) const
       }
     else
       {
-        out << endl;
+        out << "\n";
         out << "   <!-- degrees of freedom is zero -->\n";
         out << "   <!-- the standard deviation test is not applicable -->\n";
         tagnl(out, "ratio", 0);
@@ -595,7 +593,7 @@ void LocalNetworkXML::std_dev_summary(std::ostream& out) const
 }
 
 
-void LocalNetworkXML::coordinates(std::ostream& out) const
+void LocalNetworkXML::coordinates(GNU_gama::StreamWriter& out) const
 {
   const double y_sign = netinfo->y_sign();
 
@@ -620,7 +618,7 @@ void LocalNetworkXML::coordinates(std::ostream& out) const
       bool bz  = p.active_z () && p.index_z() == 0;
       if (!bxy && !bz) continue;
       out << "   <point> ";
-      tagsp(out, "id", (*i).first);
+      tagsp(out, "id", (*i).first.str());
       if (bxy)
         {
           const double x = p.x();
@@ -650,7 +648,7 @@ void LocalNetworkXML::coordinates(std::ostream& out) const
       bool bz  = p.active_z () && p.index_z() != 0;
       if (!bxy && !bz) continue;
       out << "   <point> ";
-      tagsp(out, "id", (*i).first);
+      tagsp(out, "id", (*i).first.str());
       if (bxy)
         {
           const char* cx = "x";
@@ -694,7 +692,7 @@ void LocalNetworkXML::coordinates(std::ostream& out) const
       bool bz  = p.active_z () && p.index_z() != 0;
       if (!bxy && !bz) continue;
       out << "   <point> ";
-      tagsp(out, "id", (*i).first);
+      tagsp(out, "id", (*i).first.str());
       if (bxy)
         {
           const char* cx = "x";
@@ -788,7 +786,7 @@ void LocalNetworkXML::coordinates(std::ostream& out) const
 }
 
 
-void  LocalNetworkXML::std_error_ellipses(std::ostream& out) const
+void  LocalNetworkXML::std_error_ellipses(GNU_gama::StreamWriter& out) const
 {
   std::ios_base::fmtflags f( out.flags() );
   out.setf(ios_base::scientific, ios_base::floatfield);
@@ -806,7 +804,7 @@ void  LocalNetworkXML::std_error_ellipses(std::ostream& out) const
       netinfo->std_error_ellipse(ID, major, minor, alpha);
 
       out << "<ellipse>";
-      out << " <id>" << ID << "</id>";
+      out << " <id>" << ID.str() << "</id>";
       out << " <major>" << major << "</major>";
       out << " <minor>" << minor << "</minor>";
       out << " <alpha>" << alpha << "</alpha>";
@@ -819,7 +817,7 @@ void  LocalNetworkXML::std_error_ellipses(std::ostream& out) const
 }
 
 
-void  LocalNetworkXML::orientation_shifts(std::ostream& out,
+void  LocalNetworkXML::orientation_shifts(GNU_gama::StreamWriter& out,
                                           std::vector<int>& ind,
                                           int& dim) const
 {
@@ -869,7 +867,7 @@ void  LocalNetworkXML::orientation_shifts(std::ostream& out,
 }
 
 
-void LocalNetworkXML::observations(std::ostream& out) const
+void LocalNetworkXML::observations(GNU_gama::StreamWriter& out) const
 {
   out << "\n<observations>\n\n";
 
@@ -879,7 +877,7 @@ void LocalNetworkXML::observations(std::ostream& out) const
    const double   y_sign = netinfo->y_sign();
    const GNU_gama::local::Vec& v = netinfo->residuals();
    const int      pocmer = netinfo->observations_count();
-   const double   scale  = netinfo->gons() ? 1.0 : 0.324;
+   const double   scale  = 1.0;      // angular results are always in gons
    const double   kki    = netinfo->conf_int_coef();
 
    const int linear  =  make_check_precision(6);    // output precision
@@ -893,18 +891,11 @@ void LocalNetworkXML::observations(std::ostream& out) const
      {
        Observation* pm = netinfo->ptr_obs(i);
 
-       ostringstream ostr;
-       ostr.setf(ios_base::fixed, ios_base::floatfield);
-
-       writeVisitor.setSecondaryOutStream(ostr);
+       out.setf(ios_base::fixed, ios_base::floatfield);
        writeVisitor.setObservationIndex(i);
 
        pm->accept(&writeVisitor);
 
-       out << "  " << ostr.str();
-       //out << "\n";
-
-       out.setf(ios_base::fixed, ios_base::floatfield);
        out.precision(3);
        out.width(7);
 
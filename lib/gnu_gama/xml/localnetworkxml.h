@@ -25,6 +25,7 @@
 #include <gnu_gama/local/gamadata.h>
 #include <gnu_gama/local/network.h>
 #include <gnu_gama/local/cluster.h>
+#include <gnu_gama/streamwriter.h>
 #include <string>
 
 
@@ -41,17 +42,17 @@ namespace GNU_gama
 
     GNU_gama::local::LocalNetwork* netinfo;
 
-    void coordinates_summary (std::ostream&) const;
-    void observations_summary(std::ostream&) const;
-    void equations_summary   (std::ostream&) const;
-    void coordinates         (std::ostream&) const;
-    void observations        (std::ostream&) const;
-
-    void std_error_ellipses(std::ostream&)  const;
-    void orientation_shifts(std::ostream&, std::vector<int>&, int&) const;
-    void std_dev_summary(std::ostream&) const;
-    template <typename T> void tagnl(std::ostream&, const char*, T) const;
-    template <typename T> void tagsp(std::ostream&, const char*, T) const;
+    void coordinates_summary (StreamWriter&) const;
+    void observations_summary(StreamWriter&) const;
+    void equations_summary   (StreamWriter&) const;
+    void coordinates         (StreamWriter&) const;
+    void observations        (StreamWriter&) const;
+
+    void std_error_ellipses(StreamWriter&)  const;
+    void orientation_shifts(StreamWriter&, std::vector<int>&, int&) const;
+    void std_dev_summary(StreamWriter&) const;
+    template <typename T> void tagnl(StreamWriter&, const char*, T) const;
+    template <typename T> void tagsp(StreamWriter&, const char*, T) const;
   };
 }
 
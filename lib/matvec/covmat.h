@@ -69,8 +69,8 @@ namespace GNU_gama {   /** \brief Covariance Matrix (symmetric band matrix) */
     void   reset    (Index d, Index b) override;
     Index  dim      () const { return this->row_; }
     Index  bandWidth() const { return band_; }
-    Float  operator ()(Index, Index) const override;
-    Float& operator ()(Index, Index) override;
+    Float  operator ()(Index, Index) const final;
+    Float& operator ()(Index, Index) final;
     void   cholDec  () override;
     void   solve    (Vec<Float, Index, Exc>&) const override;
 
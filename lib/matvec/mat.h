@@ -61,15 +61,24 @@ namespace GNU_gama {
       }
     }
 
-    Float& operator()(Index r, Index c) override {
+    Float& operator()(Index r, Index c) final {
       Float *m = this->begin();
       return m[--r*this->cols() + --c];
     }
-    Float  operator()(Index r, Index c) const override {
+    Float  operator()(Index r, Index c) const final {
       const Float *m = this->begin();
       return m[--r*this->cols() + --c];
     }
 
+    MatView<Float, Index> view() {
+      return MatView<Float, Index>(this->begin(), this->rows(), this->cols(),
+                                   this->cols(), 1);
+    }
+    MatView<const Float, Index> view() const {
+      return MatView<const Float, Index>(this->begin(), this->rows(),
+                                         this->cols(), this->cols(), 1);
+    }
+
     Mat operator*(Float f) const {
       Mat t(this->rows(), this->cols()); this->mul(f, t); return t;
     }
@@ -93,6 +102,12 @@ namespace GNU_gama {
     void transpose() override { *this = trans(*this); }
     void invert(Float tol=std::numeric_limits<Float>::epsilon()*1000);
 
+    protected:
+
+    bool dense_strides(Index& rs, Index& cs) const override {
+      rs = this->cols(); cs = 1; return true;
+    }
+
     private:
 
     Float* pentry {nullptr};  // not initialized in constructor !!!
@@ -120,6 +135,16 @@ namespace GNU_gama {
 
       Mat<Float, Index, Exc> C(A.rows(), B.cols());
       typename Mat<Float, Index, Exc>::iterator c = C.begin();
+      MatView<const Float, Index> a, b;
+      if (A.dense_view(a) && B.dense_view(b))
+        {
+          for (Index i=1; i<=C.rows(); i++)
+            for (Index j=1; j<=C.cols(); j++)
+              *c++ = dot(a.row(i), b.col(j));
+
+          return C;
+        }
+
       Float s;
       for (Index i=1; i<=C.rows(); i++)
         for (Index j=1; j<=C.cols(); j++)
@@ -144,6 +169,17 @@ namespace GNU_gama {
                   "Mat operator+(const MatBase &A, const MatBase &B)");
 
       Mat<Float, Index, Exc> C(A.rows(), A.cols());
+      MatView<const Float, Index> a, b;
+      if (A.dense_view(a) && B.dense_view(b))
+        {
+          typename Mat<Float, Index, Exc>::iterator c = C.begin();
+          for (Index i=1; i<=A.rows(); i++)
+            for (Index j=1; j<=A.cols(); j++)
+              *c++ = a(i,j) + b(i,j);
+
+          return C;
+        }
+
       for (Index i=1; i<=A.rows(); i++)
         for (Index j=1; j<=A.cols(); j++)
           C(i,j) = A(i,j) + B(i,j);
@@ -162,6 +198,17 @@ namespace GNU_gama {
                   "Mat operator-(const MatBase &A,const MatBase &B)");
 
       Mat<Float, Index, Exc> C(A.rows(), A.cols());
+      MatView<const Float, Index> a, b;
+      if (A.dense_view(a) && B.dense_view(b))
+        {
+          typename Mat<Float, Index, Exc>::iterator c = C.begin();
+          for (Index i=1; i<=A.rows(); i++)
+            for (Index j=1; j<=A.cols(); j++)
+              *c++ = a(i,j) - b(i,j);
+
+          return C;
+        }
+
       for (Index i=1; i<=A.rows(); i++)
         for (Index j=1; j<=A.cols(); j++)
           C(i,j) = A(i,j) - B(i,j);
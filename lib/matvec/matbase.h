@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <matvec/matvecbase.h>
+#include <matvec/matview.h>
 
 
 namespace GNU_gama {   /** \brief Base matrix class */
@@ -59,6 +60,23 @@ namespace GNU_gama {   /** \brief Base matrix class */
     virtual Float& operator()(Index r, Index c) = 0;
     virtual Float  operator()(Index r, Index c) const = 0;
 
+    /** Non-virtual view of dense matrices (Mat and TransMat), returns
+     * false if elements are not stored as a full rectangular array */
+    bool dense_view(MatView<const Float, Index>& v) const
+    {
+      Index rs, cs;
+      if (!dense_strides(rs, cs)) return false;
+      v = MatView<const Float, Index>(this->begin(), row_, col_, rs, cs);
+      return true;
+    }
+    bool dense_view(MatView<Float, Index>& v)
+    {
+      Index rs, cs;
+      if (!dense_strides(rs, cs)) return false;
+      v = MatView<Float, Index>(this->begin(), row_, col_, rs, cs);
+      return true;
+    }
+
     void reset() { row_ = col_ = 0; this->resize(0); }
     virtual void reset(Index r, Index c) {
       if (r != row_ || c != col_) {
@@ -90,9 +108,19 @@ namespace GNU_gama {   /** \brief Base matrix class */
       if (inp >> r >> c)
         {
           reset(r, c);
-          for (Index i=1; i<=r; i++)
-            for (Index j=1; j<=c; j++)
-              inp >> operator()(i,j);
+          MatView<Float, Index> v;
+          if (dense_view(v))
+            {
+              for (Index i=1; i<=r; i++)
+                for (Index j=1; j<=c; j++)
+                  inp >> v(i,j);
+            }
+          else
+            {
+              for (Index i=1; i<=r; i++)
+                for (Index j=1; j<=c; j++)
+                  inp >> operator()(i,j);
+            }
         }
       return inp;
     }
@@ -104,17 +132,28 @@ namespace GNU_gama {   /** \brief Base matrix class */
       out << rows() << " ";
       out.width(fw);
       out << cols() << "\n\n";
+      MatView<const Float, Index> v;
+      const bool dense = dense_view(v);
       for (Index i=1; i<=rows(); i++)
         {
           for (Index j=1; j<=cols(); j++) {
             out.width(fw);
-            out << operator()(i,j) << " ";
+            out << (dense ? v(i,j) : operator()(i,j)) << " ";
           }
           out << '\n';
         }
       return out;
     }
 
+  protected:
+
+    /** row and column strides of dense storage */
+    virtual bool dense_strides(Index& /*row_stride*/,
+                               Index& /*col_stride*/) const
+    {
+      return false;
+    }
+
   };
 
 
@@ -0,0 +1,130 @@
+/*
+  C++ Matrix/Vector templates (GNU Gama / matvec)
+  Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ Matrix/Vector template library.
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_gama_gMatVec_MatView_h
+#define GNU_gama_gMatVec_MatView_h
+
+#include <type_traits>
+
+namespace GNU_gama {
+
+  /** \brief Strided vector view
+   *
+   * Non-owning view of vector elements stored in memory of a matvec
+   * object with a constant stride. Elements are indexed from 1 as in
+   * matvec classes, but the access is not virtual and can be inlined
+   * in inner loops. A view of const elements is VecView<const Float>.
+   */
+
+  template <typename Float=double, typename Index=int>
+  class VecView {
+  public:
+
+    VecView(Float* p, Index n, Index stride=1)
+      : p_(p), n_(n), stride_(stride) {}
+
+    Index dim()    const { return n_; }
+    Index stride() const { return stride_; }
+
+    Float& operator()(Index i) const { return p_[(i-1)*stride_]; }
+
+  private:
+
+    Float* p_;
+    Index  n_;
+    Index  stride_;
+  };
+
+
+  /** \brief Strided matrix view
+   *
+   * Non-owning view of a dense matrix with row and column strides. A
+   * row major Mat has strides (cols, 1) and TransMat (1, rows), the
+   * transposed view only swaps the strides.
+   *
+   * \sa MatBase::dense_view(), Mat::view(), TransMat::view()
+   */
+
+  template <typename Float=double, typename Index=int>
+  class MatView {
+  public:
+
+    MatView() : p_(nullptr), r_(0), c_(0), rs_(0), cs_(0) {}
+    MatView(Float* p, Index r, Index c, Index row_stride, Index col_stride)
+      : p_(p), r_(r), c_(c),
+        rs_(row_stride), cs_(col_stride) {}
+
+    Index rows() const { return r_; }
+    Index cols() const { return c_; }
+
+    Float& operator()(Index r, Index c) const
+    {
+      return p_[(r-1)*rs_ + (c-1)*cs_];
+    }
+
+    VecView<Float, Index> row(Index r) const
+    {
+      return VecView<Float, Index>(&operator()(r,1), c_, cs_);
+    }
+    VecView<Float, Index> col(Index c) const
+    {
+      return VecView<Float, Index>(&operator()(1,c), r_, rs_);
+    }
+
+    MatView trans() const
+    {
+      return MatView(&operator()(1,1), c_, r_, cs_, rs_);
+    }
+
+  private:
+
+    Float* p_;
+    Index  r_, c_;
+    Index  rs_, cs_;
+  };
+
+
+  /** \brief Dot product of two vector views of the same dimension */
+
+  template <typename F1, typename F2, typename Index>
+  inline std::remove_const_t<F1>
+  dot(const VecView<F1, Index>& a, const VecView<F2, Index>& b)
+  {
+    std::remove_const_t<F1> s {};
+    const Index n  = a.dim();
+    const Index sa = a.stride(), sb = b.stride();
+    const F1* pa = n ? &a(1) : nullptr;
+    const F2* pb = n ? &b(1) : nullptr;
+
+    if (sa == 1 && sb == 1)
+      {
+        for (Index i=0; i<n; i++) s += pa[i]*pb[i];
+      }
+    else
+      {
+        for (Index i=0; i<n; i++) s += pa[i*sa]*pb[i*sb];
+      }
+
+    return s;
+  }
+
+}   // namespace GNU_gama
+
+#endif
@@ -24,6 +24,8 @@
 #define GNU_gama_gMatVec_MatSVD_h
 
 #include <cmath>
+#include <functional>
+#include <vector>
 #include <matvec/matvec.h>
 
 
@@ -56,6 +58,10 @@ namespace GNU_gama {
 
       -------------------------------------------------------------------------
 
+      2026-10-19  blocked Householder bidiagonalization of matrices with
+                  more than 128 columns (LAPACK dgebrd), rotations of
+                  QR iterations applied to four rows at a time
+
       2025-02-16  removed all volatile attributes, set(CMAKE_CXX_STANDARD 20)
 
       2011-04-17  (AC) suppressed g++ optimization (volatile variables)
@@ -137,6 +143,14 @@ namespace GNU_gama {
 
     void solve(const Vec<Float, Index, Exc>& rhs, Vec<Float, Index, Exc>& x);
 
+    /* Optional parallel loop used in the decomposition; it must call
+     * f(i0, i1) for disjoint subranges covering [begin, end). The
+     * result does not depend on the subranges. */
+    using ParallelFor =
+      std::function<void(Index begin, Index end, Index grain,
+                         const std::function<void(Index, Index)>& f)>;
+    void set_parallel(ParallelFor p) { parallel_ = std::move(p); }
+
     SVD(const SVD&) = delete;
     SVD& operator=(const SVD&) = delete;
     SVD(const SVD&&) = delete;
@@ -168,6 +182,14 @@ namespace GNU_gama {
     Float** V;
     void reset_UWV();
 
+    Index reduce_blocks(Float* rv1, Float& s1);
+
+    struct Rotation { Index a, b; Float c, s; };
+    ParallelFor parallel_;
+    void loop(Index begin, Index end, Index grain,
+              const std::function<void(Index, Index)>& f);
+    void rotate(Float** R, Index rows, const std::vector<Rotation>& rot);
+
   };      /* class SVD */
 
 
@@ -249,8 +271,26 @@ namespace GNU_gama {
     Vec<Float, Index, Exc> rv1_(n);
     Float* rv1 = rv1_.begin() - 1;
 
-    /* Householder reduction to bidiagonal form */
-    for (i=1; i<=n; i++) {
+    /* Householder reflections and their accumulations are applied to
+     * independent groups of columns (or rows), Givens rotations of the
+     * QR iterations are collected and applied to U and V by rows. The
+     * order of floating point operations for each element of U and V
+     * is the same as in the original column oriented algorithm. */
+
+    Vec<Float, Index, Exc> sj_(n > m ? n : m);
+    Float* sj = sj_.begin() - 1;      // column dot products
+
+    std::vector<Rotation> rot_U, rot_V;
+
+    /* Householder reduction to bidiagonal form, leading columns of
+     * large matrices are reduced in blocks */
+    const Index nblocked = reduce_blocks(rv1, s1);
+    if (nblocked)
+      {
+        scale = ONE;
+        g = rv1[nblocked+1];
+      }
+    for (i=nblocked+1; i<=n; i++) {
       L = i+1;
       rv1[i] = scale*g ;
       g = s = scale = ZERO ;
@@ -267,12 +307,21 @@ namespace GNU_gama {
           U[i][i] = f - g;
           if (i != n)
             {
-              for (j=L; j<=n; j++) {
-                s = ZERO;
-                for (k=i; k<=m; k++) s += U[k][i] * U[k][j];
-                f = s/h;
-                for (k=i; k<=m; k++) U[k][j] += f*U[k][i];
-              }
+              loop(L, n+1, 32, [&, i, h](Index j0, Index j1)
+                {
+                  for (Index j=j0; j<j1; j++) sj[j] = ZERO;
+                  for (Index k=i; k<=m; k++) {
+                    const Float  uki = U[k][i];
+                    const Float* uk  = U[k];
+                    for (Index j=j0; j<j1; j++) sj[j] += uki * uk[j];
+                  }
+                  for (Index j=j0; j<j1; j++) sj[j] /= h;
+                  for (Index k=i; k<=m; k++) {
+                    const Float uki = U[k][i];
+                    Float*      uk  = U[k];
+                    for (Index j=j0; j<j1; j++) uk[j] += sj[j]*uki;
+                  }
+                });
             }
           for ( k = i ; k <= m ; k++ ) U[k][i] *= scale ;
         }
@@ -293,11 +342,14 @@ namespace GNU_gama {
           for (k=L; k<=n; k++) rv1[k] = U[i][k] / h;
           if (i != m)
             {
-              for (j=L; j<=m; j++) {
-                s = ZERO;
-                for (k=L; k<=n; k++) s += U[j][k] * U[i][k];
-                for ( k = L ; k <= n ; k++ ) U[j][k] += s * rv1[k];
-              }
+              loop(L, m+1, 32, [&, i, L](Index j0, Index j1)
+                {
+                  for (Index j=j0; j<j1; j++) {
+                    Float s = ZERO;
+                    for (Index k=L; k<=n; k++) s += U[j][k] * U[i][k];
+                    for (Index k=L; k<=n; k++) U[j][k] += s * rv1[k];
+                  }
+                });
             }
           for (k=L; k<=n; k++) U[i][k] *= scale;
         }
@@ -312,11 +364,20 @@ namespace GNU_gama {
         if (g) {
           for (j=L; j<=n; j++) // double division avoids possible underflow
             V[j][i] = (U[i][j] / U[i][L]) / g;
-          for (j=L; j<=n; j++) {
-            s = ZERO;
-            for (k=L; k<=n; k++) s += U[i][k] * V[k][j];
-            for (k=L; k<=n; k++) V[k][j] += s*V[k][i];
-          }
+          loop(L, n+1, 32, [&, i, L](Index j0, Index j1)
+            {
+              for (Index j=j0; j<j1; j++) sj[j] = ZERO;
+              for (Index k=L; k<=n; k++) {
+                const Float  uik = U[i][k];
+                const Float* vk  = V[k];
+                for (Index j=j0; j<j1; j++) sj[j] += uik * vk[j];
+              }
+              for (Index k=L; k<=n; k++) {
+                const Float vki = V[k][i];
+                Float*      vk  = V[k];
+                for (Index j=j0; j<j1; j++) vk[j] += sj[j]*vki;
+              }
+            });
         }
         for (j=L; j<=n; j++) V[i][j] = V[j][i] = ZERO;
       }
@@ -338,12 +399,21 @@ namespace GNU_gama {
         {
           if (i != mn)
             {
-              for (j=L; j<=n; j++) {
-                s=ZERO;
-                for (k=L; k<=m; k++) s += U[k][i] * U[k][j];
-                f = (s / U[i][i]) / g;
-                for (k=i; k<=m; k++) U[k][j] += f * U[k][i];
-              }
+              loop(L, n+1, 32, [&, i, L, g](Index j0, Index j1)
+                {
+                  for (Index j=j0; j<j1; j++) sj[j] = ZERO;
+                  for (Index k=L; k<=m; k++) {
+                    const Float  uki = U[k][i];
+                    const Float* uk  = U[k];
+                    for (Index j=j0; j<j1; j++) sj[j] += uki * uk[j];
+                  }
+                  for (Index j=j0; j<j1; j++) sj[j] = (sj[j] / U[i][i]) / g;
+                  for (Index k=i; k<=m; k++) {
+                    const Float uki = U[k][i];
+                    Float*      uk  = U[k];
+                    for (Index j=j0; j<j1; j++) uk[j] += sj[j] * uki;
+                  }
+                });
             }
           for (j=i; j<=m; j++) U[j][i] /= g;
         }
@@ -380,25 +450,21 @@ namespace GNU_gama {
             /* cancellation of rv1[L], if L greater then 1 */
             c = ZERO;
             s = ONE;
+            rot_U.clear();
             for (i=L; i<=k; i++)
               {
                 f = s * rv1[i];
                 rv1[i] = c * rv1[i];
                 s2 = s1 + ABS(f);
-                if (s1 == s2) goto test_for_convergence;
+                if (s1 == s2) break;
                 g = W[i];
                 h = PYTHAG(f,g);
                 W[i] = h;
                 c =  g / h;
                 s = -f / h;
-                for (j=1; j<=m; j++)
-                  {
-                    y = U[j][L1];
-                    z = U[j][i];
-                    U[j][L1] =  y*c + z*s;
-                    U[j][i]  = -y*s + z*c;
-                  }
+                rot_U.push_back({L1, i, c, s});
               }
+            rotate(U, m, rot_U);
 
           test_for_convergence:
 
@@ -431,6 +497,8 @@ namespace GNU_gama {
 
             /* next QR transformation */
             c = s = ONE;
+            rot_U.clear();
+            rot_V.clear();
             for (i1=L; i1<=k1; i1++) {
               i = i1 + 1;
               g = rv1[i];
@@ -445,12 +513,7 @@ namespace GNU_gama {
               g = -x*s + g*c;
               h = y*s;
               y = y*c;
-              for (j=1; j<=n; j++) {
-                x = V[j][i1];
-                z = V[j][i];
-                V[j][i1] =  x*c + z*s;
-                V[j][i]  = -x*s + z*c;
-              }
+              rot_V.push_back({i1, i, c, s});
               z = PYTHAG(f,h);
               W[i1] = z;
 
@@ -461,13 +524,10 @@ namespace GNU_gama {
               }
               f =  c*g + s*y;
               x = -s*g + c*y;
-              for (j=1; j<=m; j++) {
-                y = U[j][i1];
-                z = U[j][i];
-                U[j][i1] =  y*c + z*s;
-                U[j][i]  = -y*s + z*c;
-              }
+              rot_U.push_back({i1, i, c, s});
             }
+            rotate(V, n, rot_V);
+            rotate(U, m, rot_U);
             rv1[L] = ZERO;
             rv1[k] = f;
             W[k] = x;
@@ -486,6 +546,228 @@ namespace GNU_gama {
   }      /* void SVD<Float, Index, Exc>::svd() */
 
 
+  /* Blocked Householder bidiagonalization of leading columns (LAPACK
+   * dgebrd/dlabrd). Reflections of a panel of nb columns and rows are
+   * computed with the panel updates kept in matrices X and Y, the
+   * trailing matrix is then updated once by A -= V*Y' + X*U', where V
+   * and U are Householder vectors of the panel. Vectors are stored in
+   * the same form as in the unblocked reduction, which continues with
+   * the remaining columns (the return value is the number of reduced
+   * columns, W and rv1 hold diagonal and superdiagonal). Small
+   * matrices are not blocked, their decomposition is unchanged. */
+
+  template <typename Float, typename Index, typename Exc>
+  Index SVD<Float, Index, Exc>::reduce_blocks(Float* rv1, Float& s1)
+  {
+    const Index nb = 32;            // block size
+    const Index nx = 128;           // columns reduced without blocking
+
+    if (m < n || n <= nx) return 0;
+
+    const Float ZERO = 0;
+    std::vector<Float> X_(std::size_t(m)*nb), Y_(std::size_t(n)*nb);
+    auto X = [&](Index r, Index t) -> Float& { return X_[(r-1)*nb + t-1]; };
+    auto Y = [&](Index c, Index t) -> Float& { return Y_[(t-1)*n + c-1]; };
+
+    std::vector<Float> sj(n+1), a(nb+1), b(nb+1);
+
+    // Householder vector x of length len with stride: x = I - tau*v*v'
+    // applied to x gives (beta, 0, ..., 0), v is stored in x
+
+    auto house = [&](Float* x, Index len, Index stride,
+                     Float& beta, Float& tau)
+      {
+        Float scale = ZERO, s = ZERO;
+        beta = tau = ZERO;
+        for (Index k=0; k<len; k++) scale += ABS(x[k*stride]);
+        if (scale == ZERO) return;
+
+        for (Index k=0; k<len; k++) {
+          const Float t = (x[k*stride] /= scale);
+          s += t*t;
+        }
+        const Float f = x[0];
+        Float g = std::sqrt(s); if (f >= ZERO) g = -g;
+        const Float h = f*g - s;
+        x[0] = f - g;
+        for (Index k=0; k<len; k++) x[k*stride] *= scale;
+
+        beta = scale*g;
+        tau  = -1/(h*scale*scale);
+      };
+
+    rv1[1] = ZERO;
+    Index p = 1;
+    for (; p <= n - nx; p += nb)
+      {
+        for (Index t=1; t<=nb; t++)
+          {
+            const Index i = p + t - 1;
+            const Index L = i + 1;
+
+            // column i updated by the previous reflections of the panel
+
+            for (Index k=i; k<=m; k++) {
+              Float s = ZERO;
+              for (Index q=1; q<t; q++)
+                s += U[k][p+q-1]*Y(i,q) + X(k,q)*U[p+q-1][i];
+              U[k][i] -= s;
+            }
+
+            Float tau;
+            house(&U[i][i], m-i+1, n, W[i], tau);
+
+            // Y(:,t) = tau*(A'*v - Y*(V'*v) - U*(X'*v))
+
+            for (Index q=1; q<t; q++) {
+              Float sa = ZERO, sb = ZERO;
+              for (Index k=i; k<=m; k++) {
+                sa += U[k][p+q-1]*U[k][i];
+                sb += X(k,q)*U[k][i];
+              }
+              a[q] = sa;
+              b[q] = sb;
+            }
+
+            loop(L, n+1, 32, [&, i, t, tau](Index j0, Index j1)
+              {
+                for (Index j=j0; j<j1; j++) sj[j] = ZERO;
+                for (Index k=i; k<=m; k++) {
+                  const Float  vk = U[k][i];
+                  const Float* uk = U[k];
+                  for (Index j=j0; j<j1; j++) sj[j] += uk[j]*vk;
+                }
+                for (Index j=j0; j<j1; j++) {
+                  Float s = sj[j];
+                  for (Index q=1; q<t; q++)
+                    s -= Y(j,q)*a[q] + U[p+q-1][j]*b[q];
+                  Y(j,t) = tau*s;
+                }
+              });
+
+            // row i updated by the reflections of the panel
+
+            for (Index j=L; j<=n; j++) {
+              Float s = ZERO;
+              for (Index q=1; q<=t; q++) s += Y(j,q)*U[i][p+q-1];
+              for (Index q=1; q<t;  q++) s += X(i,q)*U[p+q-1][j];
+              U[i][j] -= s;
+            }
+
+            house(&U[i][L], n-L+1, 1, rv1[L], tau);
+
+            // X(:,t) = tau*(A*u - V*(Y'*u) - X*(U'*u))
+
+            for (Index q=1; q<=t; q++) {
+              Float sa = ZERO, sb = ZERO;
+              for (Index j=L; j<=n; j++) {
+                sa += Y(j,q)*U[i][j];
+                if (q < t) sb += U[p+q-1][j]*U[i][j];
+              }
+              a[q] = sa;
+              b[q] = sb;
+            }
+
+            loop(L, m+1, 32, [&, i, t, tau](Index r0, Index r1)
+              {
+                for (Index r=r0; r<r1; r++) {
+                  Float s = ZERO;
+                  for (Index j=i+1; j<=n; j++) s += U[r][j]*U[i][j];
+                  for (Index q=1; q<=t; q++) s -= U[r][p+q-1]*a[q];
+                  for (Index q=1; q<t;  q++) s -= X(r,q)*b[q];
+                  X(r,t) = tau*s;
+                }
+              });
+
+            const Float r = ABS(W[i]) + ABS(rv1[i]); if (r > s1) s1 = r;
+          }
+
+        // trailing matrix A -= V*Y' + X*U'
+
+        const Index e = p + nb;
+        loop(e, m+1, 16, [&, e](Index r0, Index r1)
+          {
+            for (Index r=r0; r<r1; r++) {
+              Float* ur = U[r];
+              for (Index q=1; q<=nb; q++) {
+                const Float  v  = ur[p+q-1];
+                const Float  x  = X(r,q);
+                const Float* yq = &Y(1,q) - 1;
+                const Float* uq = U[p+q-1];
+                for (Index j=e; j<=n; j++) ur[j] -= v*yq[j] + x*uq[j];
+              }
+            }
+          });
+      }
+
+    return p - 1;
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void SVD<Float, Index, Exc>::loop(Index begin, Index end, Index grain,
+                                    const std::function<void(Index, Index)>& f)
+  {
+    if (begin >= end) return;
+
+    if (parallel_)
+      parallel_(begin, end, grain, f);
+    else
+      f(begin, end);
+  }
+
+
+  template <typename Float, typename Index, typename Exc>
+  void SVD<Float, Index, Exc>::rotate(Float** R, Index rows,
+                                      const std::vector<Rotation>& rot)
+  {
+    // apply plane rotations to columns (a, b) of all rows of R
+
+    if (rot.empty()) return;
+
+    // consecutive rotations of a row depend on each other, four rows
+    // are rotated together to hide the latency
+
+    loop(1, rows+1, 64, [R, &rot](Index r0, Index r1)
+      {
+        Index r = r0;
+        for (; r+3<r1; r+=4)
+          {
+            Float* row0 = R[r];
+            Float* row1 = R[r+1];
+            Float* row2 = R[r+2];
+            Float* row3 = R[r+3];
+            for (const Rotation& t : rot)
+              {
+                const Float y0 = row0[t.a], z0 = row0[t.b];
+                const Float y1 = row1[t.a], z1 = row1[t.b];
+                const Float y2 = row2[t.a], z2 = row2[t.b];
+                const Float y3 = row3[t.a], z3 = row3[t.b];
+                row0[t.a] =  y0*t.c + z0*t.s;
+                row0[t.b] = -y0*t.s + z0*t.c;
+                row1[t.a] =  y1*t.c + z1*t.s;
+                row1[t.b] = -y1*t.s + z1*t.c;
+                row2[t.a] =  y2*t.c + z2*t.s;
+                row2[t.b] = -y2*t.s + z2*t.c;
+                row3[t.a] =  y3*t.c + z3*t.s;
+                row3[t.b] = -y3*t.s + z3*t.c;
+              }
+          }
+        for (; r<r1; r++)
+          {
+            Float* row = R[r];
+            for (const Rotation& t : rot)
+              {
+                const Float y = row[t.a];
+                const Float z = row[t.b];
+                row[t.a] =  y*t.c + z*t.s;
+                row[t.b] = -y*t.s + z*t.c;
+              }
+          }
+      });
+  }
+
+
   template <typename Float, typename Index, typename Exc>
   SVD<Float, Index, Exc>&
   SVD<Float, Index, Exc>::reset(const Mat<Float, Index, Exc>& A)
@@ -630,13 +912,13 @@ namespace GNU_gama {
 
 
   template <typename Float, typename Index, typename Exc>
-  void SVD<Float, Index, Exc>::min_x(Index n, Index list[])
+  void SVD<Float, Index, Exc>::min_x(Index nlist, Index list[])
   {
     minx = subset;
     if (list_min != 0) delete[] list_min;
-    n_min = n;
+    n_min = nlist;
     list_min = new Index[n_min];
-    for (Index i = 0; i < n; i++)
+    for (Index i = 0; i < nlist; i++)
       list_min[i] = list[i];
 
     if (decomposed && defect != 0) {
@@ -648,7 +930,7 @@ namespace GNU_gama {
         V[i] = V[i-1] + n;
       min_subset_x();
     }
-  }      /* void SVD<Float, Index, Exc>::min_x(Index n, Index list[]) */
+  }      /* void SVD<Float, Index, Exc>::min_x(Index nlist, Index list[]) */
 
 
   template <typename Float, typename Index, typename Exc>
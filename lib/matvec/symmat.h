@@ -60,12 +60,12 @@ namespace GNU_gama {   /** \brief Symmetrix matrix */
     void cholDec();
     void solve(Vec<Float, Index, Exc> &rhs) const;
 
-    Float  operator()(Index i, Index j) const
+    Float  operator()(Index i, Index j) const final
     {
       const Float *p = this->begin();
       return i>=j ? p[i*(i-1)/2+j-1] : p[j*(j-1)/2+i-1];
     }
-    Float& operator()(Index i, Index j)
+    Float& operator()(Index i, Index j) final
     {
       Float *p = this->begin();
       return i>=j ? p[i*(i-1)/2+j-1] : p[j*(j-1)/2+i-1];
@@ -44,17 +44,28 @@ namespace GNU_gama {   /** \brief Transpose matrix */
     {
     }
 
-    Float& operator()(Index r, Index c) override
+    Float& operator()(Index r, Index c) final
     {
       Float *m = this->begin();
       return m[--c*this->rows() + --r];
     }
-    Float  operator()(Index r, Index c) const override
+    Float  operator()(Index r, Index c) const final
     {
       const Float *m = this->begin();
       return m[--c*this->rows() + --r];
     }
 
+    MatView<Float, Index> view()
+    {
+      return MatView<Float, Index>(this->begin(), this->rows(), this->cols(),
+                                   1, this->rows());
+    }
+    MatView<const Float, Index> view() const
+    {
+      return MatView<const Float, Index>(this->begin(), this->rows(),
+                                         this->cols(), 1, this->rows());
+    }
+
     void reset(Index r, Index c) override
     {
       if (r != this->row_ || c != this->col_) {
@@ -87,6 +98,13 @@ namespace GNU_gama {   /** \brief Transpose matrix */
       return T;
     }
 
+  protected:
+
+    bool dense_strides(Index& rs, Index& cs) const override
+    {
+      rs = 1; cs = this->rows(); return true;
+    }
+
   };
 
 
@@ -214,37 +232,6 @@ namespace GNU_gama {   /** \brief Transpose matrix */
   }
 
 
-  template <typename Float, typename Index, typename Exc>
-  Vec<Float, Index, Exc>
-  operator*(const TransMat<Float, Index, Exc> &A,
-            const Vec<Float, Index, Exc> &b)
-  {
-    if (A.cols() != b.dim())
-      throw Exc(Exception::BadRank,
-                "Vec operator*(const TransMat&, const Vec&)");
-
-    Vec<Float, Index, Exc> t(A.rows());
-    typename Vec<Float, Index, Exc>::iterator ti = t.begin();
-    typename Vec<Float, Index, Exc>::const_iterator bb = b.begin();
-    typename Vec<Float, Index, Exc>::const_iterator bi;
-    typename TransMat<Float, Index, Exc>::const_iterator ab = A.begin();
-    typename TransMat<Float, Index, Exc>::const_iterator ai;
-    Float s;
-    for (Index i=1; i<=A.rows(); i++)
-      {
-        s = 0;
-        bi = bb;
-        ai = ab;
-        for (Index j=1; j<=A.cols(); j++, ai += A.rows())
-          s += *ai * *bi++;
-        *ti++ = s;
-        ab++;
-      }
-
-    return t;
-  }
-
-
   template <typename Float, typename Index, typename Exc>
   TransVec<Float, Index, Exc>
   operator*(const Vec<Float, Index, Exc> &b,
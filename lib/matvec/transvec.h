@@ -77,6 +77,15 @@ operator*(TransVec<Float, Index, Exc> a, Vec<Float, Index, Exc> b)
   }
 
 
+template <typename Float, typename Index, typename Exc, typename E,
+          std::enable_if_t<VecExpression<E>, int> = 0>
+inline Float
+operator*(const TransVec<Float, Index, Exc>& a, const E& e)
+  {
+    return a.dot(Vec<Float, Index, Exc>(e));
+  }
+
+
 template <typename Float, typename Index, typename Exc>
 std::ostream&
 operator<<(std::ostream& out, const Vec<Float, Index, Exc>& v)
@@ -101,6 +110,16 @@ operator<<(std::ostream& out, const Vec<Float, Index, Exc>& v)
   }
 
 
+template <typename E, std::enable_if_t<VecExpression<E>, int> = 0>
+inline std::ostream&
+operator<<(std::ostream& out, const E& e)
+  {
+    using V = Vec<typename E::value_type, typename E::index_type,
+                  typename E::exception_type>;
+    return out << V(e);
+  }
+
+
 template <typename Float, typename Index, typename Exc>
 std::ostream&
 operator<<(std::ostream& out, const TransVec<Float, Index, Exc>& v)
@@ -141,6 +160,16 @@ trans(const TransVec<Float, Index, Exc>& v)
 }
 
 
+template <typename E, std::enable_if_t<VecExpression<E>, int> = 0>
+inline auto
+trans(const E& e)
+{
+  using V = Vec<typename E::value_type, typename E::index_type,
+                typename E::exception_type>;
+  return trans(V(e));
+}
+
+
 template <typename Float, typename Index, typename Exc>
 TransVec<Float, Index, Exc>
 operator*(const TransVec<Float, Index, Exc> &b, const MatBase<Float,
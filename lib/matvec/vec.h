@@ -25,6 +25,7 @@
 #include <cmath>
 #include <initializer_list>
 #include <matvec/vecbase.h>
+#include <matvec/vecexpr.h>
 
 namespace GNU_gama {   /** \brief Vector */
 
@@ -40,6 +41,9 @@ namespace GNU_gama {   /** \brief Vector */
     // typedef typename VecBase<Float, Index, Exc>::const_iterator const_iterator;
     using iterator = typename VecBase<Float, Index, Exc>::iterator;
     using const_iterator = typename VecBase<Float, Index, Exc>::const_iterator;
+    using value_type     = Float;
+    using index_type     = Index;
+    using exception_type = Exc;
 
     Vec() = default;
     Vec(Index nsz) : VecBase<Float, Index, Exc>(nsz) {}
@@ -55,14 +59,30 @@ namespace GNU_gama {   /** \brief Vector */
         *f++ = p;
     }
 
-    Vec operator*(Float f) const {
-      Vec t(this->dim()); this->mul(f, t); return t;
-    }
-    Vec operator+(const Vec &x) const {
-      Vec t(this->dim()); this->add(x, t); return t;
+    /** Evaluation of a vector expression, see vecexpr.h */
+    template <typename E, std::enable_if_t<VecExpression<E>, int> = 0>
+    Vec(const E& e) : VecBase<Float, Index, Exc>(e.dim())
+    {
+      Float* p = this->begin();
+      for (Index i=1, n=e.dim(); i<=n; i++) *p++ = e(i);
     }
-    Vec operator-(const Vec &x) const {
-      Vec t(this->dim()); this->sub(x, t); return t;
+
+    template <typename E, std::enable_if_t<VecExpression<E>, int> = 0>
+    Vec& operator=(const E& e)
+    {
+      // expressions with nonlocal access (matrix-vector product) may
+      // refer to this vector and are evaluated into a temporary
+
+      if (E::elementwise && this->dim() == e.dim())
+        {
+          Float* p = this->begin();
+          for (Index i=1, n=e.dim(); i<=n; i++) *p++ = e(i);
+        }
+      else
+        {
+          *this = Vec(e);
+        }
+      return *this;
     }
 
     Vec& operator*=(Float f)      { this->mul(f, *this); return *this; }
@@ -70,63 +90,6 @@ namespace GNU_gama {   /** \brief Vector */
     Vec& operator-=(const Vec &x) { this->sub(x, *this); return *this; }
   };
 
-
-  template <typename Float, typename Index, typename Exc>
-  inline Vec<Float, Index, Exc>
-  operator*(Float f, const Vec<Float, Index, Exc>& V)
-  {
-    return V*f;
-  }
-
-
-  template <typename Float, typename Index, typename Exc>
-  Vec<Float, Index, Exc>
-  operator*(const MatBase<Float, Index, Exc> &A,
-            const Vec<Float, Index, Exc> &b)
-  {
-    if (A.cols() != b.dim())
-      throw Exc(Exception::BadRank,
-                "Vec operator*(const MatBase&, const Vec&)");
-
-    Vec<Float, Index, Exc> t(A.rows());
-    Float s;
-    for (Index i=1; i<=A.rows(); i++)
-      {
-        s = 0;
-        for (Index j=1; j<=A.cols(); j++)
-          s += A(i,j)*b(j);
-        t(i) = s;
-      }
-
-    return t;
-  }
-
-
-  template <typename Float, typename Index, typename Exc>
-  Vec<Float, Index, Exc>
-  operator*(const Mat<Float, Index, Exc> &A, const Vec<Float, Index, Exc> &b)
-  {
-    if (A.cols() != b.dim())
-      throw Exc(Exception::BadRank, "Vec operator*(const Mat&, const Vec&)");
-
-    Vec<Float, Index, Exc> t(A.rows());
-    typename Vec<Float, Index, Exc>::iterator ti = t.begin();
-    typename Vec<Float, Index, Exc>::const_iterator bb = b.begin();
-    typename Vec<Float, Index, Exc>::const_iterator bi;
-    typename Vec<Float, Index, Exc>::const_iterator ai = A.begin();
-    Float s;
-    for (Index i=1; i<=A.rows(); i++)
-      {
-        s = 0;
-        bi = bb;
-        for (Index j=1; j<=A.cols(); j++)
-          s += *ai++ * *bi++;
-        *ti++ = s;
-      }
-
-    return t;
-  }
-
 }   // namespace GNU_gama
 
 #endif
@@ -0,0 +1,350 @@
+/*
+  C++ Matrix/Vector templates (GNU Gama / matvec)
+  Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+  This file is part of the GNU Gama C++ Matrix/Vector template library.
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GNU Gama.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GNU_gama_gMatVec_VecExpr_h
+#define GNU_gama_gMatVec_VecExpr_h
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <matvec/inderr.h>
+#include <matvec/matview.h>
+
+namespace GNU_gama {
+
+  /* Expression templates for Vec arithmetic
+   *
+   * Operators +, - and multiplication by a scalar or by a matrix
+   * return lightweight expression objects, the resulting vector is
+   * evaluated element by element in a single loop when the expression
+   * is assigned to Vec or used to construct it. Elements are computed
+   * with the same floating point operations in the same order as by
+   * the former eager operators.
+   *
+   * Named (lvalue) vectors are referenced by expressions, temporary
+   * vectors and subexpressions are held by value, so an expression
+   * never refers to a destroyed temporary. Matrix-vector product needs
+   * all elements of its vector operand, the vector is evaluated once
+   * when the product is created.
+   */
+
+  template <typename Float, typename Index, typename Exc> class Vec;
+  template <typename Float, typename Index, typename Exc> class MatBase;
+
+
+  template <typename T> struct is_vec : std::false_type {};
+  template <typename Float, typename Index, typename Exc>
+  struct is_vec<Vec<Float, Index, Exc>> : std::true_type {};
+
+  template <typename T> struct is_vec_expr : std::false_type {};
+
+  template <typename Float, typename Index, typename Exc>
+  std::true_type  is_matbase_test(const MatBase<Float, Index, Exc>*);
+  std::false_type is_matbase_test(...);
+
+
+  // remove_cvref_t is not available in C++17
+
+  template <typename T>
+  using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+  /** Vec expression (not a Vec object) */
+  template <typename T>
+  constexpr bool VecExpression = is_vec_expr<remove_cvref_t<T>>::value;
+
+  /** Vec or Vec expression */
+  template <typename T>
+  constexpr bool VecOperand = VecExpression<T> || is_vec<remove_cvref_t<T>>::value;
+
+  /** any matrix derived from MatBase */
+  template <typename T>
+  constexpr bool MatOperand = decltype(is_matbase_test(
+                                std::declval<remove_cvref_t<T>*>()))::value;
+
+
+  // lvalue vectors and matrices are held by reference, temporaries
+  // and expressions by value
+
+  template <typename T>
+  using expr_operand_t = std::conditional_t<
+    std::is_lvalue_reference_v<T> && !VecExpression<T>,
+    const remove_cvref_t<T>&,
+    remove_cvref_t<T>>;
+
+  // vector operand of matrix-vector product, expressions are evaluated
+
+  template <typename T>
+  using matvec_operand_t = std::conditional_t<
+    VecExpression<T>,
+    Vec<typename remove_cvref_t<T>::value_type,
+        typename remove_cvref_t<T>::index_type,
+        typename remove_cvref_t<T>::exception_type>,
+    expr_operand_t<T>>;
+
+  // element i of the result depends only on elements i of operands
+
+  template <typename T>
+  constexpr bool elementwise_v = []
+  {
+    if constexpr (VecExpression<T>)
+      return remove_cvref_t<T>::elementwise;
+    else
+      return true;
+  }();
+
+
+  /** \brief Common interface of vector expressions
+   *
+   * Norms and the dot product are computed in a single pass over the
+   * expression without evaluating it into a vector.
+   */
+
+  template <typename Derived>
+  class VecExprBase {
+  public:
+
+    auto eval() const
+    {
+      using D = Derived;
+      return Vec<typename D::value_type, typename D::index_type,
+                 typename D::exception_type>(self());
+    }
+
+    template <typename V>
+    auto dot(const V& v) const
+    {
+      const Derived& e = self();
+      if (e.dim() != v.dim())
+        throw typename Derived::exception_type
+          (Exception::BadRank, "Float VecBase::dot(const VecBase&) const");
+
+      typename Derived::value_type sum = 0;
+      for (typename Derived::index_type i=1; i<=e.dim(); i++)
+        sum += e(i)*v(i);
+      return sum;
+    }
+
+    auto norm_L1() const
+    {
+      const Derived& e = self();
+      typename Derived::value_type sum = 0, x;
+      for (typename Derived::index_type i=1; i<=e.dim(); i++)
+        {
+          x = e(i);
+          sum += x >= 0 ? x : -x;
+        }
+      return sum;
+    }
+
+    auto norm_L2() const
+    {
+      const Derived& e = self();
+      typename Derived::value_type sum = 0, x;
+      for (typename Derived::index_type i=1; i<=e.dim(); i++)
+        {
+          x = e(i);
+          sum += x*x;
+        }
+      return std::sqrt(sum);
+    }
+
+    auto norm_Linf() const
+    {
+      const Derived& e = self();
+      typename Derived::value_type norm = 0, x;
+      for (typename Derived::index_type i=1; i<=e.dim(); i++)
+        {
+          x = e(i);
+          if (x < 0) x = -x;
+          if (x > norm) norm = x;
+        }
+      return norm;
+    }
+
+  private:
+
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+  };
+
+
+  struct VecExprAdd
+  {
+    static constexpr const char* name =
+      "MatVecBase::add(const MatVecBase&, MatVecBase&)";
+
+    template <typename Float>
+    static Float apply(Float a, Float b) { return a + b; }
+  };
+
+  struct VecExprSub
+  {
+    static constexpr const char* name =
+      "MatVecBase::sub(const MatVecBase&, MatVecBase&)";
+
+    template <typename Float>
+    static Float apply(Float a, Float b) { return a - b; }
+  };
+
+
+  /** \brief Sum or difference of two vector expressions */
+
+  template <typename L, typename R, typename Op>
+  class VecBinaryExpr : public VecExprBase<VecBinaryExpr<L, R, Op>> {
+  public:
+
+    using value_type     = typename remove_cvref_t<L>::value_type;
+    using index_type     = typename remove_cvref_t<L>::index_type;
+    using exception_type = typename remove_cvref_t<L>::exception_type;
+
+    static constexpr bool elementwise = elementwise_v<L> && elementwise_v<R>;
+
+    template <typename A, typename B>
+    VecBinaryExpr(A&& a, B&& b)
+      : l_(std::forward<A>(a)), r_(std::forward<B>(b))
+    {
+      if (l_.dim() != r_.dim())
+        throw exception_type(Exception::BadRank, Op::name);
+    }
+
+    index_type dim() const { return l_.dim(); }
+    value_type operator()(index_type i) const { return Op::apply(l_(i), r_(i)); }
+
+  private:
+
+    L l_;
+    R r_;
+  };
+
+
+  /** \brief Vector expression multiplied by a scalar */
+
+  template <typename L>
+  class VecScaleExpr : public VecExprBase<VecScaleExpr<L>> {
+  public:
+
+    using value_type     = typename remove_cvref_t<L>::value_type;
+    using index_type     = typename remove_cvref_t<L>::index_type;
+    using exception_type = typename remove_cvref_t<L>::exception_type;
+
+    static constexpr bool elementwise = elementwise_v<L>;
+
+    template <typename A>
+    VecScaleExpr(A&& a, value_type f) : l_(std::forward<A>(a)), f_(f) {}
+
+    index_type dim() const { return l_.dim(); }
+    value_type operator()(index_type i) const { return l_(i)*f_; }
+
+  private:
+
+    L          l_;
+    value_type f_;
+  };
+
+
+  /** \brief Product of a matrix and a vector */
+
+  template <typename M, typename X>
+  class MatVecExpr : public VecExprBase<MatVecExpr<M, X>> {
+  public:
+
+    using value_type     = typename remove_cvref_t<X>::value_type;
+    using index_type     = typename remove_cvref_t<X>::index_type;
+    using exception_type = typename remove_cvref_t<X>::exception_type;
+
+    static constexpr bool elementwise = false;
+
+    template <typename A, typename B>
+    MatVecExpr(A&& a, B&& b) : m_(std::forward<A>(a)), x_(std::forward<B>(b))
+    {
+      if (m_.cols() != x_.dim())
+        throw exception_type(Exception::BadRank,
+                             "Vec operator*(const MatBase&, const Vec&)");
+    }
+
+    index_type dim() const { return m_.rows(); }
+    value_type operator()(index_type i) const
+    {
+      MatView<const value_type, index_type> a;
+      if (m_.dense_view(a))
+        {
+          return dot(a.row(i), VecView<const value_type, index_type>
+                                 (x_.begin(), x_.dim()));
+        }
+
+      value_type s = 0;
+      for (index_type j=1; j<=m_.cols(); j++)
+        s += m_(i,j)*x_(j);
+      return s;
+    }
+
+  private:
+
+    M m_;
+    X x_;
+  };
+
+
+  template <typename L, typename R, typename Op>
+  struct is_vec_expr<VecBinaryExpr<L, R, Op>> : std::true_type {};
+  template <typename L>
+  struct is_vec_expr<VecScaleExpr<L>> : std::true_type {};
+  template <typename M, typename X>
+  struct is_vec_expr<MatVecExpr<M, X>> : std::true_type {};
+
+
+  template <typename A, typename B,
+            std::enable_if_t<VecOperand<A> && VecOperand<B>, int> = 0>
+  inline auto operator+(A&& a, B&& b)
+  {
+    return VecBinaryExpr<expr_operand_t<A&&>, expr_operand_t<B&&>, VecExprAdd>
+      (std::forward<A>(a), std::forward<B>(b));
+  }
+
+  template <typename A, typename B,
+            std::enable_if_t<VecOperand<A> && VecOperand<B>, int> = 0>
+  inline auto operator-(A&& a, B&& b)
+  {
+    return VecBinaryExpr<expr_operand_t<A&&>, expr_operand_t<B&&>, VecExprSub>
+      (std::forward<A>(a), std::forward<B>(b));
+  }
+
+  template <typename A, std::enable_if_t<VecOperand<A>, int> = 0>
+  inline auto operator*(A&& a, typename remove_cvref_t<A>::value_type f)
+  {
+    return VecScaleExpr<expr_operand_t<A&&>>(std::forward<A>(a), f);
+  }
+
+  template <typename A, std::enable_if_t<VecOperand<A>, int> = 0>
+  inline auto operator*(typename remove_cvref_t<A>::value_type f, A&& a)
+  {
+    return VecScaleExpr<expr_operand_t<A&&>>(std::forward<A>(a), f);
+  }
+
+  template <typename M, typename X,
+            std::enable_if_t<MatOperand<M> && VecOperand<X>, int> = 0>
+  inline auto operator*(M&& m, X&& x)
+  {
+    return MatVecExpr<expr_operand_t<M&&>, matvec_operand_t<X&&>>
+      (std::forward<M>(m), std::forward<X>(x));
+  }
+
+}   // namespace GNU_gama
+
+#endif
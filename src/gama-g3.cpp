@@ -23,6 +23,8 @@
 #include <gnu_gama/xml/dataparser.h>
 #include <gnu_gama/g3/g3_model.h>
 #include <gnu_gama/version.h>
+#include <gnu_gama/parallel.h>
+#include <cstdlib>
 
 namespace
 {
@@ -30,6 +32,7 @@ namespace
   const char* arg_output    = nullptr;
   const char* arg_algorithm = nullptr;
   const char* arg_projeq    = nullptr;
+  bool        arg_mixed     = false;
 
   GNU_gama::Adj::algorithm algorithm;
 
@@ -44,7 +47,14 @@ namespace
       " input      xml data file name\n"
       " output     optional output data file name\n\n"
 
-      " --algorithm  envelope | gso | svd | cholesky\n"
+      " --algorithm  envelope | gso | svd | cholesky | cgls | helmert\n"
+      " --threads    number of threads (0 for all cores)\n"
+      " --mixed-precision\n"
+      "            envelope factorized in single precision with iterative\n"
+      "            refinement, summary is written to standard error;\n"
+      "            covariances in the output are computed from normal\n"
+      "            equations factorized in double precision, memory and\n"
+      "            time are saved only in the adjustment itself\n"
 
       " --project-equations file"
       "     optional output of project equations in XML\n"
@@ -93,11 +103,31 @@ namespace
             else if (arg == "gso"     ) algorithm = GNU_gama::Adj::gso;
             else if (arg == "svd"     ) algorithm = GNU_gama::Adj::svd;
             else if (arg == "cholesky") algorithm = GNU_gama::Adj::cholesky;
+            else if (arg == "cgls"    ) algorithm = GNU_gama::Adj::cgls;
+            else if (arg == "helmert" ) algorithm = GNU_gama::Adj::helmert;
             else
               ok = false;
 
             continue;
           }
+        if (a == "-threads")
+          {
+            char* end = nullptr;
+            long  t   = -1;
+            if (++i < argc) t = std::strtol(argv[i], &end, 10);
+
+            if (t >= 0 && end != argv[i] && *end == 0)
+              GNU_gama::set_threads(static_cast<unsigned>(t));
+            else
+              ok = false;
+
+            continue;
+          }
+        if (a == "-mixed-precision")
+          {
+            arg_mixed = true;
+            continue;
+          }
         if (a == "-project-equations")
           {
             if (++i < argc)
@@ -188,6 +218,7 @@ int main_g3()
   if (model == nullptr) return error("error on reading XML input data");
 
   if (arg_algorithm) model->set_algorithm(algorithm);
+  if (arg_mixed)     model->set_mixed_precision(true);
 
   model->update_linearization();
 
@@ -215,6 +246,20 @@ int main_g3()
       model->write_xml_adjustment_results(std::cout);
     }
 
+  if (arg_mixed)
+    {
+      const GNU_gama::Adj* adj = model->adjustment();
+      std::cerr << "mixed precision : " << adj->refinement_steps()
+                << " refinement steps, relative residual norm "
+                << adj->refinement_residual();
+      if (adj->refinement_fallback())
+        std::cerr << ", refinement stalled, solved in double precision";
+      else if (!adj->normal_equations_released())
+        std::cerr << ", double precision normal equations "
+                     "formed for covariances";
+      std::cerr << "\n";
+    }
+
   delete model;
   return 0;
 }
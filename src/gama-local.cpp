@@ -18,15 +18,32 @@
    along with this program; if not, write to the Free Software Foundation,
    Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
 
+#ifdef   HAVE_CONFIG_H
+#include <config.h>
+#endif
+
 #ifdef   GNU_GAMA_LOCAL_SQLITE_READER
 #include <gnu_gama/local/sqlitereader.h>
 #endif
 
+#ifdef   GNU_GAMA_LOCAL_YAML_READER
+#include <gnu_gama/local/yamlreader.h>
+#endif
+
 #include <gnu_gama/outstream.h>
 
+#include <chrono>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <gnu_gama/version.h>
 #include <gnu_gama/intfloat.h>
+#include <gnu_gama/parallel.h>
 #include <gnu_gama/xml_expat.h>
 #include <gnu_gama/xml/localnetworkoctave.h>
 #include <gnu_gama/xml/localnetworkxml.h>
@@ -39,6 +56,10 @@
 #include <gnu_gama/local/acord/acordstatistics.h>
 #include <gnu_gama/local/svg.h>
 #include <gnu_gama/local/html.h>
+#include <gnu_gama/local/snapshot.h>
+#include <gnu_gama/local/sequential.h>
+#include <gnu_gama/local/design_analysis.h>
+#include <gnu_gama/xml/localnetwork_adjustment_results.h>
 
 #include <gnu_gama/local/results/text/approximate_coordinates.h>
 #include <gnu_gama/local/results/text/reduced_observations.h>
@@ -80,9 +101,15 @@ int help()
             "  --readonly-configuration name  [options]\n"
 #endif
 
+#ifdef   GNU_GAMA_LOCAL_YAML_READER
+    "       gama-local  --input-yaml input.yaml  [options]\n"
+#endif
+    "       gama-local  --input-snapshot network.snapshot  [options]\n"
+    "       gama-local  --batch jobs.txt  [--threads n]  [--language xx]\n"
+
     "\nOptions:\n\n"
 
-    "--algorithm  gso | svd | cholesky | envelope\n"
+    "--algorithm  gso | svd | cholesky | envelope | helmert\n"
     "--language   " << GNU_gama::local::active_language_help << "\n"
     "--encoding   utf-8 | iso-8859-2 | iso-8859-2-flat | cp-1250 | cp-1251\n"
     "--angular    400 | 360\n"
@@ -99,7 +126,22 @@ int help()
     "--iterations maximum number of iterations allowed in the linearized\n"
     "             least squares algorithm (implicit value is 5)\n"
     "--export     updated input data based on adjustment results\n"
+    "--snapshot   binary snapshot of input data and adjustment results\n"
+    "--threads    number of threads used in parallel computations\n"
+    "             (implicit value is 1 or $GNU_GAMA_THREADS, 0 for all cores)\n"
     "--verbose    [yes | no]\n"
+    "--datum      list of adjusted points (separated by commas) defining\n"
+    "             datum of a free network, results are S-transformed\n"
+    "--prior      xml adjustment results of the previous epoch used as\n"
+    "             prior information in sequential adjustment\n"
+    "--design     network design analysis, observations ranked by effects\n"
+    "             of their removal or repetition on precision of coordinates\n"
+    "--design-criterion  trace | max  (implicit value is trace)\n"
+    "--batch      list of jobs (\"-\" for standard input), each line contains\n"
+    "             input and options of one adjustment or an input and XML\n"
+    "             output pair; jobs are adjusted concurrently by --threads\n"
+    "             workers and a line with job number, exit status, time [ms]\n"
+    "             and the job is written to standard output for each job\n"
     "--version\n"
     "--dumpversion\n"
     "--help\n\n";
@@ -113,22 +155,56 @@ int help()
 
   return 0;
 }
-}  // unnamed namespace
 
+bool set_language(const char* lang)
+{
+  using namespace GNU_gama::local;
 
-GNU_gama::local::XMLerror xmlerr;
+  if      (!strcmp("en", lang)) set_gama_language(en);
+  else if (!strcmp("ca", lang)) set_gama_language(ca);
+  else if (!strcmp("cs", lang)) set_gama_language(cz);
+  else if (!strcmp("cz", lang)) set_gama_language(cz);
+  else if (!strcmp("du", lang)) set_gama_language(du);
+  else if (!strcmp("es", lang)) set_gama_language(es);
+  else if (!strcmp("fr", lang)) set_gama_language(fr);
+  else if (!strcmp("fi", lang)) set_gama_language(fi);
+  else if (!strcmp("hu", lang)) set_gama_language(hu);
+  else if (!strcmp("ru", lang)) set_gama_language(ru);
+  else if (!strcmp("ua", lang)) set_gama_language(ua);
+  else if (!strcmp("zh", lang)) set_gama_language(zh);
+  else return false;
+
+  return true;
+}
 
-int main(int argc, char **argv)
-  try {
 
-    if (argc == 1) return help();
+/* Adjustment of a single network. Messages are written to msg and
+ * error messages to err (standard output and standard error in a
+ * single run). A batch job cannot change the language or the number
+ * of threads, which are common for all jobs, and cannot use standard
+ * input and output; invalid arguments of a batch job are reported in
+ * err instead of the help text. */
+
+int adjust(int argc, char **argv, GNU_gama::local::XMLerror& xmlerr,
+           std::ostream& msg, std::ostream& err, bool batch_job)
+  try {
 
     using namespace std;
     using namespace GNU_gama::local;
 
+    auto usage = [batch_job, &err]()
+      {
+        if (!batch_job) return help();
+
+        err << "\n****** invalid arguments of the batch job\n\n";
+        return 1;
+      };
+
     const char* c;
     const char* argv_1 = nullptr;           // xml input or sqlite db name
     const char* argv_input_xml = nullptr;
+    const char* argv_input_yaml = nullptr;
+    const char* argv_input_snapshot = nullptr;
     const char* argv_algo = nullptr;
     const char* argv_lang = nullptr;
     const char* argv_enc  = nullptr;
@@ -144,26 +220,17 @@ int main(int argc, char **argv)
     const char* argv_covband = nullptr;
     const char* argv_iterations = nullptr;
     const char* argv_export_xml = nullptr;
+    const char* argv_snapshot = nullptr;
+    const char* argv_threads = nullptr;
+    const char* argv_prior = nullptr;
+    const char* argv_datum = nullptr;
+    const char* argv_design = nullptr;
+    const char* argv_design_criterion = nullptr;
     bool verbose_output { false };
 
-    // handle --verbose, --help and --version as special cases
-    if (argc == 2 && strcmp(argv[1], "-") && strlen(argv[1]) > 2)
-      {
-        c = argv[1];
-        if(*c == '-') c++;
-        if(*c == '-') c++;
-
-        if (!strcmp(c, "help"))    return help();
-        if (!strcmp(c, "verbose")) return help();
-        if (!strcmp(c, "version")) return
-            GNU_gama::version("gama-local", "Ales Cepek et al.");
-        if (!strcmp(c, "dumpversion"))
-          {
-            cout << GNU_gama::version() << endl;
-            return 0;
-          }
-      }
-    else if (argc == 3 && strcmp(argv[1], "-") && strlen(argv[1]) > 2)
+    // handle --verbose as a special case, see main() for --help and
+    // --version
+    if (argc == 3 && strcmp(argv[1], "-") && strlen(argv[1]) > 2)
       {
         c = argv[1];
         if(*c == '-') c++;
@@ -172,7 +239,7 @@ int main(int argc, char **argv)
         if (!strcmp(c, "verbose"))
           {
             c = argv[2];   // no and yes cannot be names of input files
-            if (!strcmp(c, "no") || !strcmp(c, "yes")) return help();
+            if (!strcmp(c, "no") || !strcmp(c, "yes")) return usage();
           }
       }
 
@@ -223,7 +290,7 @@ int main(int argc, char **argv)
               argv_1 = c;
               continue;
             }
-            return help();
+            return usage();
           }
 
         // ****  options  ****
@@ -234,6 +301,9 @@ int main(int argc, char **argv)
         c = argv[++i];               // value
 
         if      (!strcmp("input-xml",   name)) argv_input_xml = c;
+#ifdef GNU_GAMA_LOCAL_YAML_READER
+        else if (!strcmp("input-yaml",  name)) argv_input_yaml = c;
+#endif
         else if (!strcmp("algorithm",   name)) argv_algo = c;
         else if (!strcmp("language",    name)) argv_lang = c;
         else if (!strcmp("encoding",    name)) argv_enc  = c;
@@ -249,6 +319,13 @@ int main(int argc, char **argv)
         else if (!strcmp("cov-band",    name)) argv_covband = c;
         else if (!strcmp("iterations",  name)) argv_iterations = c;
         else if (!strcmp("export",      name)) argv_export_xml = c;
+        else if (!strcmp("snapshot",    name)) argv_snapshot = c;
+        else if (!strcmp("input-snapshot", name)) argv_input_snapshot = c;
+        else if (!strcmp("threads",     name)) argv_threads = c;
+        else if (!strcmp("prior",       name)) argv_prior = c;
+        else if (!strcmp("datum",       name)) argv_datum = c;
+        else if (!strcmp("design",      name)) argv_design = c;
+        else if (!strcmp("design-criterion", name)) argv_design_criterion = c;
         else if (!strcmp("verbose",     name))
           {
             std::string argverb(c ? c : "");
@@ -263,39 +340,74 @@ int main(int argc, char **argv)
               }
           }
         else
-          return help();
+          return usage();
       }
 
     // implicit output
-    if (!argv_txtout && !argv_htmlout && !argv_xmlout) argv_xmlout = "-";
+    const bool implicit_output = !argv_txtout && !argv_htmlout && !argv_xmlout;
+    if (implicit_output) argv_xmlout = "-";
 
     if (argv_xmlout) xmlerr.setXmlOutput(argv_xmlout);
 
     if (argv_input_xml)
       {
-        if (argv_1) return help(); // input already defined
+        if (argv_1) return usage(); // input already defined
 
         argv_1 = argv_input_xml;
       }
 
-    if (!argv_lang)
-      set_gama_language(en);
-    else
+    if (argv_input_yaml)
+      {
+        if (argv_1) return usage(); // input already defined
+
+        argv_1 = argv_input_yaml;
+      }
+
+    if (argv_input_snapshot)
+      {
+        if (argv_1) return usage(); // input already defined
+
+        argv_1 = argv_input_snapshot;
+      }
+
+#ifdef GNU_GAMA_LOCAL_SQLITE_READER
+    if (!argv_1 && !argv_sqlitedb) return usage();
+#else
+    if (!argv_1) return usage();
+#endif
+
+    if (batch_job)
+      {
+        // standard input and output are reserved for the batch
+
+        if (implicit_output)
+          {
+            err << "\n****** no output file (--xml, --text or --html) "
+                   "of the batch job\n\n";
+            return 1;
+          }
+
+        for (const char* f : {argv_1, argv_txtout, argv_htmlout, argv_xmlout,
+                              argv_octaveout, argv_svgout, argv_obsout,
+                              argv_export_xml, argv_snapshot, argv_design})
+          if (f && !strcmp(f, "-"))
+            {
+              err << "\n****** standard input and output cannot be used "
+                     "in the batch job\n\n";
+              return 1;
+            }
+
+        // language is set for all jobs
+
+        if (argv_lang)
+          {
+            err << "\n****** --language is common for all batch jobs\n\n";
+            return 1;
+          }
+      }
+    else if (!set_language(argv_lang ? argv_lang : "en"))
       {
-        if      (!strcmp("en", argv_lang)) set_gama_language(en);
-        else if (!strcmp("ca", argv_lang)) set_gama_language(ca);
-        else if (!strcmp("cs", argv_lang)) set_gama_language(cz);
-        else if (!strcmp("cz", argv_lang)) set_gama_language(cz);
-        else if (!strcmp("du", argv_lang)) set_gama_language(du);
-        else if (!strcmp("du", argv_lang)) set_gama_language(du);
-        else if (!strcmp("es", argv_lang)) set_gama_language(es);
-        else if (!strcmp("fr", argv_lang)) set_gama_language(fr);
-        else if (!strcmp("fi", argv_lang)) set_gama_language(fi);
-        else if (!strcmp("hu", argv_lang)) set_gama_language(hu);
-        else if (!strcmp("ru", argv_lang)) set_gama_language(ru);
-        else if (!strcmp("ua", argv_lang)) set_gama_language(ua);
-        else if (!strcmp("zh", argv_lang)) set_gama_language(zh);
-        else return help();
+        return usage();
       }
 
     ostream* output = nullptr;
@@ -331,7 +443,7 @@ int main(int argc, char **argv)
         else if (!strcmp("cp-1251", argv_enc))
           cout.set_encoding(OutStream::cp_1251);
         else
-          return help();
+          return usage();
       }
 
     if (argv_algo)
@@ -340,10 +452,12 @@ int main(int argc, char **argv)
         if (algorithm != "gso"      &&
             algorithm != "svd"      &&
             algorithm != "cholesky" &&
-            algorithm != "envelope" ) return help();
+            algorithm != "envelope" &&
+            algorithm != "helmert"  ) return usage();
       }
 
-    LocalNetwork* IS = new LocalNetwork;
+    std::unique_ptr<LocalNetwork> network(new LocalNetwork);
+    LocalNetwork* IS = network.get();
     if (verbose_output) IS->set_verbose();
 
 #ifdef GNU_GAMA_LOCAL_SQLITE_READER
@@ -359,7 +473,7 @@ int main(int argc, char **argv)
           }
         catch(const GNU_gama::Exception::sqlitexc& exc)
           {
-            std::cerr << exc.what() << "\n";
+            err << exc.what() << "\n";
             return 1;
           }
         catch(...)
@@ -375,30 +489,49 @@ int main(int argc, char **argv)
         if (argv_1 == std::string("-"))
             inxml.reset(&std::cin, [](std::istream*){}); // is the deleter necessary?
         else
-            inxml.reset( new std::ifstream(argv_1) );
+            inxml.reset( new std::ifstream(argv_1, argv_input_snapshot
+                                           ? ios_base::in | ios_base::binary
+                                           : ios_base::in) );
 
-        GKFparser gkf(*IS);
         try
           {
-            char c;
-            int  n, finish = 0;
-            string  line;
-            do
+            if (argv_input_snapshot)
+              {
+                GNU_gama::local::Snapshot snapshot;
+                snapshot.read(*inxml);
+                snapshot.get_network(*IS);
+              }
+            else
+#ifdef GNU_GAMA_LOCAL_YAML_READER
+            if (argv_input_yaml)
               {
-                line.clear();
-                n = 0;
-                while (inxml->get(c))
+                YamlReader yaml(*IS);
+                yaml.read(*inxml);
+              }
+            else
+#endif
+              {
+                GKFparser gkf(*IS);
+                char c;
+                int  n, finish = 0;
+                string  line;
+                do
                   {
-                    line += c;
-                    n++;
-                    if (c == '\n') break;
+                    line.clear();
+                    n = 0;
+                    while (inxml->get(c))
+                      {
+                        line += c;
+                        n++;
+                        if (c == '\n') break;
+                      }
+
+                    if (inxml->eof() || !inxml->good()) finish = 1;
+
+                    gkf.xml_parse(line.c_str(), n, finish);
                   }
-
-                if (inxml->eof() || !inxml->good()) finish = 1;
-
-                gkf.xml_parse(line.c_str(), n, finish);
+                while (!finish);
               }
-            while (!finish);
           }
         catch (const GNU_gama::local::ParserException& v) {
           if (xmlerr.isValid())
@@ -417,8 +550,8 @@ int main(int argc, char **argv)
               return xmlerr.write_xml("gamaLocalParserError");
             }
 
-          cerr << "\n" << T_GaMa_exception_2a << "\n\n"
-               << T_GaMa_exception_2b << v.line << " : " << v.what() << endl;
+          err << "\n" << T_GaMa_exception_2a << "\n\n"
+              << T_GaMa_exception_2b << v.line << " : " << v.what() << endl;
           return 3;
         }
         catch (const GNU_gama::local::Exception& v) {
@@ -429,13 +562,13 @@ int main(int argc, char **argv)
               return xmlerr.write_xml("gamaLocalException");
             }
 
-          cerr << "\n" <<T_GaMa_exception_2a << "\n"
-               << "\n***** " << v.what() << "\n\n";
+          err << "\n" <<T_GaMa_exception_2a << "\n"
+              << "\n***** " << v.what() << "\n\n";
           return 2;
         }
         catch (...)
           {
-            cerr << "\n" << T_GaMa_exception_2a << "\n\n";
+            err << "\n" << T_GaMa_exception_2a << "\n\n";
             throw;
           }
       }
@@ -447,6 +580,23 @@ int main(int argc, char **argv)
 
     if (!IS->has_algorithm()) IS->set_algorithm();
 
+    if (argv_prior)
+      {
+        if (!strcmp(argv_prior, "-")) return usage();
+
+        // snapshots do not store prior information
+        if (argv_snapshot || argv_input_snapshot) return usage();
+
+        std::ifstream file(argv_prior);
+        if (!file)
+          throw GNU_gama::local::Exception(std::string("Prior: cannot open file ")
+                                           + argv_prior);
+
+        GNU_gama::LocalNetworkAdjustmentResults previous;
+        previous.read_xml(file);
+        IS->set_prior(GNU_gama::local::EpochPrior(previous));
+      }
+
     if (argv_angular)
       {
         if (!strcmp("400", argv_angular))
@@ -454,16 +604,16 @@ int main(int argc, char **argv)
         else if (!strcmp("360", argv_angular))
           IS->set_degrees();
         else
-          return help();
+          return usage();
       }
 
     if (argv_covband)
       {
         std::istringstream istr(argv_covband);
         int band = -1;
-        if (!(istr >> band) || band < -1) return help();
+        if (!(istr >> band) || band < -1) return usage();
         char c;
-        if (istr >> c) return help();
+        if (istr >> c) return usage();
 
         IS->set_adj_covband(band);
       }
@@ -472,20 +622,33 @@ int main(int argc, char **argv)
       {
         std::istringstream istr(argv_iterations);
         int iter = IS->max_linearization_iterations();
-        if (!(istr >> iter) || iter < 0) return help();
+        if (!(istr >> iter) || iter < 0) return usage();
         char c;
-        if (istr >> c) return help();
+        if (istr >> c) return usage();
 
         IS->set_max_linearization_iterations(iter);
       }
 
+    if (argv_threads)
+      {
+        if (batch_job) return usage();
+
+        std::istringstream istr(argv_threads);
+        int threads = 1;
+        if (!(istr >> threads) || threads < 0) return usage();
+        char c;
+        if (istr >> c) return usage();
+
+        GNU_gama::set_threads(threads);
+      }
+
     if (argv_latitude)
       {
         double latitude;
         if (!GNU_gama::deg2gon(argv_latitude, latitude))
           {
             if (!GNU_gama::IsFloat(string(argv_latitude)))
-              return help();
+              return usage();
 
             latitude = atof(argv_latitude);
           }
@@ -499,16 +662,46 @@ int main(int argc, char **argv)
         using namespace GNU_gama;
 
         gama_ellipsoid gama_el = ellipsoid(argv_ellipsoid);
-        if  (gama_el == ellipsoid_unknown) return help();
+        if  (gama_el == ellipsoid_unknown) return usage();
 
         IS->set_ellipsoid(argv_ellipsoid);
       }
 
+    std::vector<GNU_gama::local::PointID> datum;
+    if (argv_datum)
+      {
+        // snapshots do not store the changed datum
+        if (argv_snapshot || argv_input_snapshot) return usage();
+
+        std::istringstream istr(argv_datum);
+        std::string id;
+        while (std::getline(istr, id, ','))
+          if (!id.empty()) datum.push_back(id);
+
+        if (datum.empty()) return usage();
+      }
+
+    auto design_criterion = GNU_gama::local::DesignAnalysis::Trace;
+    if (argv_design_criterion)
+      {
+        if (!argv_design) return usage();
+
+        std::string crit(argv_design_criterion);
+        if      (crit == "trace") ;
+        else if (crit == "max")
+          design_criterion = GNU_gama::local::DesignAnalysis::Max;
+        else
+          return usage();
+      }
+
+    GNU_gama::local::Snapshot snapshot;
+    if (argv_snapshot) snapshot.set_network(*IS);
+
 
     {
       cout << T_GaMa_Adjustment_of_geodetic_network << "        "
            << T_GaMa_version << GNU_gama::version()
-           << "-" << IS->algorithm()
+           << "-" << (IS->has_prior() ? "sequential" : IS->algorithm())
            << " / " << GNU_gama::compiler() << "\n"
            << underline(T_GaMa_Adjustment_of_geodetic_network, '*') << "\n"
            << "http://www.gnu.org/software/gama/\n\n";
@@ -568,7 +761,7 @@ int main(int argc, char **argv)
             return xmlerr.write_xml("gamaLocalException");
           }
 
-        cerr << e.what() << endl;
+        err << e.what() << endl;
         return 1;
       }
     catch(...)
@@ -580,7 +773,7 @@ int main(int argc, char **argv)
             return xmlerr.write_xml("gamaLocalApproximateCoordinates");
           }
 
-        cerr << "Gama / Acord: approximate coordinates failed\n\n";
+        err << "Gama / Acord: approximate coordinates failed\n\n";
         return 1;
       }
 
@@ -622,6 +815,9 @@ int main(int argc, char **argv)
             // update dh reductions and approximate coordinates if needed
             bool refined = IS->refine_adjustment();
 
+            // S-transformation to the datum given by the listed points
+            if (argv_datum) IS->set_datum(datum);
+
             if (refined)
               {
                 cout << T_GaMa_Approximate_coordinates_replaced << "\n"
@@ -643,95 +839,113 @@ int main(int argc, char **argv)
             ResidualsObservations(IS, cout);
           }
 
-        if (argv_svgout)
+        // output files are written concurrently, standard output
+        // is written immediately in the order of the options
+
+        IS->results();
+        std::vector<std::function<void()>> tasks;
+
+        auto output = [&tasks](const char* name,
+                               std::function<void(std::ostream&)> write)
           {
-            GamaLocalSVG svg(IS);
-            if (!strcmp(argv_svgout, "-"))
+            if (!strcmp(name, "-"))
               {
-                svg.draw(std::cout);
+                write(std::cout);
               }
             else
               {
-                ofstream file(argv_svgout);
-                svg.draw(file);
+                tasks.push_back([name, write]()
+                                {
+                                  ofstream file(name);
+                                  write(file);
+                                });
               }
+          };
+
+        if (argv_svgout)
+          {
+            output(argv_svgout, [IS](std::ostream& out)
+                   {
+                     GamaLocalSVG svg(IS);
+                     svg.draw(out);
+                   });
           }
 
         if (argv_obsout)
           {
-            ofstream opr(argv_obsout);
-            IS->project_equations(opr);
+            output(argv_obsout, [IS](std::ostream& out)
+                   {
+                     IS->project_equations(out);
+                   });
           }
 
         if (argv_htmlout)
           {
-            GNU_gama::local::GamaLocalHTML html(IS);
-            html.exec();
-
-            if (!strcmp(argv_htmlout, "-"))
-              {
-                html.html(std::cout);
-              }
-            else
-              {
-                ofstream file(argv_htmlout);
-                html.html(file);
-              }
+            output(argv_htmlout, [IS](std::ostream& out)
+                   {
+                     GNU_gama::local::GamaLocalHTML html(IS);
+                     html.exec();
+                     html.html(out);
+                   });
           }
 
         if (argv_xmlout)
           {
-            IS->set_gons();
-
-            GNU_gama::LocalNetworkXML xml(IS);
-
-            if (!strcmp(argv_xmlout, "-"))
-              {
-                xml.write(std::cout);
-              }
-            else
-              {
-                ofstream file(argv_xmlout);
-                xml.write(file);
-              }
+            output(argv_xmlout, [IS](std::ostream& out)
+                   {
+                     GNU_gama::LocalNetworkXML xml(IS);
+                     xml.write(out);
+                   });
           }
 
         if (argv_octaveout)
           {
-            IS->set_gons();
-
-            GNU_gama::LocalNetworkOctave octave(IS);
-
-            if (!strcmp(argv_octaveout, "-"))
-              {
-                octave.write(std::cout);
-              }
-            else
-              {
-                ofstream file(argv_octaveout);
-                octave.write(file);
-              }
+            output(argv_octaveout, [IS](std::ostream& out)
+                   {
+                     GNU_gama::LocalNetworkOctave octave(IS);
+                     octave.write(out);
+                   });
           }
 
         if (network_can_be_adjusted && argv_export_xml)
           {
-            std::string ver = "<!-- created by gama-local "
-                + GNU_gama::version() + " -->\n";
-            std::string xml = IS->export_xml(ver);
+            output(argv_export_xml, [IS](std::ostream& out)
+                   {
+                     std::string ver = "<!-- created by gama-local "
+                       + GNU_gama::version() + " -->\n";
+                     IS->export_xml(out, ver);
+                   });
+          }
+
+        // candidates are evaluated before the concurrent output tasks
+
+        std::unique_ptr<GNU_gama::local::DesignAnalysis> design;
+        if (network_can_be_adjusted && argv_design)
+          {
+            design.reset(new GNU_gama::local::DesignAnalysis(IS,
+                                                             design_criterion));
+            design->analyse();
+
+            const GNU_gama::local::DesignAnalysis* da = design.get();
+            output(argv_design, [da](std::ostream& out)
+                   {
+                     da->write_txt(out);
+                   });
+          }
 
-            if (!strcmp(argv_export_xml, "-"))
-              {
-                std::cout << xml;
-              }
-            else
-              {
-                ofstream file(argv_export_xml);
-                file << xml;
-              }
+        if (network_can_be_adjusted && argv_snapshot)
+          {
+            tasks.push_back([IS, &snapshot, argv_snapshot]()
+                            {
+                              snapshot.set_results(*IS);
+                              ofstream file(argv_snapshot, ios_base::binary);
+                              snapshot.write(file);
+                            });
           }
+
+        GNU_gama::parallel_run(tasks);
       }
 
-    delete IS;
     return 0;
 
   }
@@ -744,7 +958,7 @@ int main(int argc, char **argv)
           return xmlerr.write_xml("gamaLocalSqlite");
         }
 
-      std::cout << "\n" << "****** " << gamalite.what() << "\n\n";
+      msg << "\n" << "****** " << gamalite.what() << "\n\n";
       return 1;
     }
 #endif
@@ -759,8 +973,8 @@ int main(int argc, char **argv)
           return xmlerr.write_xml("gamaLocalAdjustment");
         }
 
-      std::cout << "\n" << T_GaMa_solution_ended_with_error << "\n\n"
-                << "****** " << choldec.str << "\n\n";
+      msg << "\n" << T_GaMa_solution_ended_with_error << "\n\n"
+          << "****** " << choldec.str << "\n\n";
       return 1;
     }
   catch (const GNU_gama::local::Exception& V)
@@ -774,8 +988,8 @@ int main(int argc, char **argv)
           return xmlerr.write_xml("gamaLocalException");
         }
 
-      std::cout << "\n" << T_GaMa_solution_ended_with_error << "\n\n"
-                << "****** " << V.what() << "\n\n";
+      msg << "\n" << T_GaMa_solution_ended_with_error << "\n\n"
+          << "****** " << V.what() << "\n\n";
       return 1;
     }
   catch (std::exception& stde) {
@@ -785,7 +999,8 @@ int main(int argc, char **argv)
         return xmlerr.write_xml("gamaLocalStdException");
       }
 
-    std::cout << "\n" << stde.what() << "\n\n";
+    msg << "\n" << stde.what() << "\n\n";
+    return 1;
   }
   catch(...) {
     using namespace GNU_gama::local;
@@ -795,6 +1010,166 @@ int main(int argc, char **argv)
         return xmlerr.write_xml("gamaLocalUnknownException");
       }
 
-    std::cout << "\n" << T_GaMa_internal_program_error << "\n\n";
+    msg << "\n" << T_GaMa_internal_program_error << "\n\n";
     return 1;
   }
+
+
+/* Batch mode: each line of the job list contains the input and options
+ * of one adjustment, as they would be given on the command line, or an
+ * input and XML output file pair. Empty lines and lines starting with #
+ * are ignored. Jobs are read as they arrive, so that a long-lived
+ * process can be fed from a pipe, and adjusted concurrently by a pool
+ * of workers, each job in its own LocalNetwork object. When a job is
+ * finished, its number, exit status, time in milliseconds and the job
+ * line are written to standard output. */
+
+int batch(int argc, char **argv)
+{
+  using namespace std;
+
+  const char* argv_jobs = argv[2];
+  const char* argv_threads = nullptr;
+  const char* argv_lang = nullptr;
+
+  for (int i=3; i<argc; i++)
+    {
+      const char* c = argv[i];
+      if (*c == '-') c++;
+      if (*c == '-') c++;
+      if (i+1 == argc) return help();
+
+      if      (!strcmp("threads",  c)) argv_threads = argv[++i];
+      else if (!strcmp("language", c)) argv_lang = argv[++i];
+      else
+        return help();
+    }
+
+  unsigned workers = GNU_gama::threads();
+  if (argv_threads)
+    {
+      std::istringstream istr(argv_threads);
+      int threads = 1;
+      if (!(istr >> threads) || threads < 0) return help();
+      char c;
+      if (istr >> c) return help();
+
+      workers = threads ? threads : std::thread::hardware_concurrency();
+      if (workers == 0) workers = 1;
+    }
+
+  if (!set_language(argv_lang ? argv_lang : "en")) return help();
+
+  // jobs run in parallel, computations within a job are serial
+
+  GNU_gama::set_threads(1);
+
+  std::shared_ptr<std::istream> jobs {};
+  if (!strcmp(argv_jobs, "-"))
+    jobs.reset(&std::cin, [](std::istream*){});
+  else
+    jobs.reset(new std::ifstream(argv_jobs));
+
+  if (!*jobs)
+    {
+      cerr << "gama-local: cannot open job list " << argv_jobs << "\n";
+      return 1;
+    }
+
+  std::mutex input_mutex, output_mutex;
+  int count = 0, failed = 0;
+
+  auto worker = [&]()
+    {
+      for (;;)
+        {
+          string line;
+          int job;
+          {
+            std::lock_guard<std::mutex> lock(input_mutex);
+            do
+              {
+                if (!std::getline(*jobs, line)) return;
+              }
+            while (line.find_first_not_of(" \t\r") == string::npos ||
+                   line[line.find_first_not_of(" \t\r")] == '#');
+            job = ++count;
+          }
+
+          vector<string> args {"gama-local"};
+          {
+            std::istringstream istr(line);
+            string arg;
+            while (istr >> arg) args.push_back(arg);
+          }
+          if (args.size() == 3 && args[2][0] != '-')
+            {
+              args.insert(args.begin()+2, "--xml");  // input output pair
+            }
+
+          vector<char*> job_argv;
+          for (string& a : args) job_argv.push_back(a.data());
+          job_argv.push_back(nullptr);
+
+          GNU_gama::local::XMLerror xmlerr;
+          std::ostringstream msg;
+
+          const auto start = std::chrono::steady_clock::now();
+          int status = adjust(int(args.size()), job_argv.data(),
+                              xmlerr, msg, msg, true);
+          if (!xmlerr.getCategory().empty()) status = 1;  // error in XML
+          const std::chrono::duration<double, std::milli> time =
+            std::chrono::steady_clock::now() - start;
+
+          std::lock_guard<std::mutex> lock(output_mutex);
+          if (status) failed++;
+          cout << job << " " << status << " "
+               << fixed << setprecision(3) << time.count() << " "
+               << line << endl;
+          if (!msg.str().empty()) cerr << "job " << job << msg.str();
+        }
+    };
+
+  vector<std::thread> pool;
+  for (unsigned i=1; i<workers; i++) pool.emplace_back(worker);
+  worker();
+  for (std::thread& t : pool) t.join();
+
+  return failed ? 1 : 0;
+}
+
+}  // unnamed namespace
+
+
+int main(int argc, char **argv)
+{
+  using namespace std;
+
+  if (argc == 1) return help();
+
+  // handle --help, --version and --batch as special cases
+  if (argc == 2 && strcmp(argv[1], "-") && strlen(argv[1]) > 2)
+    {
+      const char* c = argv[1];
+      if(*c == '-') c++;
+      if(*c == '-') c++;
+
+      if (!strcmp(c, "help"))    return help();
+      if (!strcmp(c, "verbose")) return help();
+      if (!strcmp(c, "version")) return
+          GNU_gama::version("gama-local", "Ales Cepek et al.");
+      if (!strcmp(c, "dumpversion"))
+        {
+          cout << GNU_gama::version() << endl;
+          return 0;
+        }
+    }
+
+  if (argc >= 3 && (!strcmp(argv[1], "--batch") || !strcmp(argv[1], "-batch")))
+    {
+      return batch(argc, argv);
+    }
+
+  GNU_gama::local::XMLerror xmlerr;
+  return adjust(argc, argv, xmlerr, std::cout, std::cerr, false);
+}
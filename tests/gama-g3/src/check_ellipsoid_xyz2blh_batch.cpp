@@ -0,0 +1,86 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gnu_gama/ellipsoid.h>
+#include <gnu_gama/ellipsoids.h>
+
+using namespace std;
+using namespace GNU_gama;
+
+double PI = 3.14159265358979323846; // pi_v in <numbers> cince c++20
+inline double int2rad(int a) { return double(a)/180.0*PI; }
+
+// batch transformations compared to the scalar Bowring's method
+
+int main()
+{
+  cout << "batch XYZ <--> BLH compared to scalar transformations" << endl;
+
+  const double rad2ss = 180*3600/PI;
+  const double tol_bl = 1e-7;   // arc seconds
+  const double tol_h  = 1e-6;   // meters
+
+  vector<gama_ellipsoid> ellipsoids
+  {
+    ellipsoid_wgs60, ellipsoid_wgs66, ellipsoid_wgs72, ellipsoid_wgs84
+  };
+
+  vector<double> B, L, H;
+  for (int b=-90; b<=90; b++)
+    for (int l=-180; l<=180; l += 10)
+      for (int h=-1000; h<=100000; h += (h < 7000 ? 100 : 31000))
+        {
+          B.push_back(int2rad(b));
+          L.push_back(int2rad(l));
+          H.push_back(double(h));
+        }
+  const size_t N = B.size();
+
+  int errors = 0;
+  for (auto e = ellipsoids.begin(); e!=ellipsoids.end(); e++)
+    {
+      Ellipsoid ellipsoid(*e);
+
+      vector<double> X(N), Y(N), Z(N);
+      ellipsoid.blh2xyz(N, B.data(), L.data(), H.data(),
+                        X.data(), Y.data(), Z.data());
+
+      vector<double> b(N), l(N), h(N);
+      ellipsoid.xyz2blh(N, X.data(), Y.data(), Z.data(),
+                        b.data(), l.data(), h.data());
+
+      double maxdb = 0, maxdl = 0, maxdh = 0;
+      for (size_t i=0; i<N; i++)
+        {
+          double x, y, z;
+          ellipsoid.blh2xyz(B[i], L[i], H[i], x, y, z);
+          if (x != X[i] || y != Y[i] || z != Z[i])
+            {
+              cout << "blh2xyz batch differs "
+                   << B[i] << " " << L[i] << " " << H[i] << endl;
+              return 1;
+            }
+
+          double bb, ll, hh;
+          ellipsoid.xyz2blh(x, y, z, bb, ll, hh);
+
+          double dl = abs(ll - l[i]);
+          if (dl > PI) dl = abs(dl - 2*PI);
+          if (abs(abs(bb) - PI/2) < 1e-12) dl = 0;   // undefined on poles
+
+          maxdb = max(maxdb, abs(bb - b[i])*rad2ss);
+          maxdl = max(maxdl, dl*rad2ss);
+          maxdh = max(maxdh, abs(hh - h[i]));
+        }
+
+      cout << "\n******* " << GNU_gama::gama_ellipsoid_caption[*e] << "\n\n"
+           << "points " << N << "   max |db| |dl| [ss] |dh| [m]  "
+           << maxdb << "  " << maxdl << "  " << maxdh << endl;
+
+      if (maxdb > tol_bl || maxdl > tol_bl || maxdh > tol_h) errors++;
+    }
+
+  return errors;
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gnu_gama/adj/adj.h>
+#include <gnu_gama/adj/adj_input_data.h>
+
+using namespace std;
+using namespace GNU_gama;
+
+// Mixed precision envelope solution compared to double precision.
+// Double precision normal equations must not be formed until weight
+// coefficients are requested, the mixed precision mode saves memory
+// and time only in the adjustment itself.
+
+namespace
+{
+  // levelling line with cross links, the first height is observed
+  // directly and the system is regular
+
+  AdjInputData* levelling(int N)
+  {
+    vector<int> from, to;
+    for (int i=2; i<=N; i++) { from.push_back(i-1); to.push_back(i); }
+    for (int i=6; i<=N; i += 3) { from.push_back(i-5); to.push_back(i); }
+    const int M = int(from.size()) + 1;
+
+    SparseMatrix<>* A = new SparseMatrix<>(2*M, M, N);
+    Vec<> rhs(M);
+
+    A->new_row();
+    A->add_element(1.0, 1);
+    rhs(1) = 0.001;
+    for (int k=0; k<M-1; k++)
+      {
+        A->new_row();
+        A->add_element(-1.0, from[k]);
+        A->add_element( 1.0, to[k]);
+        rhs(k+2) = 0.001*std::sin(double(k)) + 0.0002*(k % 7);
+      }
+
+    vector<double> sd(M, 1.0);
+    BlockDiagonal<>* cov = new BlockDiagonal<>(1, M);
+    cov->add_block(M, 0, sd.data());
+
+    AdjInputData* data = new AdjInputData;
+    data->set_mat(A);
+    data->set_cov(cov);
+    data->set_rhs(rhs);
+
+    return data;
+  }
+}
+
+int main()
+{
+  cout << "mixed precision envelope solution compared to double precision"
+       << endl;
+
+  const int N = 300;
+  const double tol = 1e-10;
+  int errors = 0;
+
+  Adj dbl, mixed;
+  dbl.set(levelling(N));
+  mixed.set(levelling(N));
+  dbl.set_algorithm(Adj::envelope);
+  mixed.set_algorithm(Adj::envelope);
+  mixed.set_mixed_precision(true);
+
+  const Vec<>& xd = dbl.x();
+  const Vec<>& xm = mixed.x();
+
+  double xmax = 0, dx = 0;
+  for (int i=1; i<=N; i++)
+    {
+      xmax = max(xmax, abs(xd(i)));
+      dx   = max(dx, abs(xm(i) - xd(i)));
+    }
+
+  cout << "\nrefinement steps " << mixed.refinement_steps()
+       << "   relative residual norm " << mixed.refinement_residual()
+       << "\nmax |dx| / max |x|  " << dx/xmax << endl;
+
+  if (mixed.refinement_steps() == 0 || mixed.refinement_fallback())
+    {
+      cout << "refinement not used" << endl;
+      errors++;
+    }
+  if (dx > tol*xmax) errors++;
+  if (!mixed.normal_equations_released())
+    {
+      cout << "normal equations formed without weight coefficients" << endl;
+      errors++;
+    }
+
+  double dq = 0, qmax = 0;
+  for (int i=1; i<=N; i += 37)
+    {
+      qmax = max(qmax, abs(dbl.q_xx(i,i)));
+      dq   = max(dq, abs(mixed.q_xx(i,i) - dbl.q_xx(i,i)));
+      dq   = max(dq, abs(mixed.q_bb(i,i) - dbl.q_bb(i,i)));
+    }
+
+  cout << "max |dq| / max |q|  " << dq/qmax << endl;
+
+  if (dq > tol*qmax) errors++;
+  if (mixed.normal_equations_released())
+    {
+      cout << "weight coefficients without normal equations" << endl;
+      errors++;
+    }
+
+  return errors;
+}
@@ -52,6 +52,7 @@ int main(int argc, char* argv[])
   algname.push_back(" gso ");   algorithm.push_back(getNet(alg_gso,  argv[3]));
   algname.push_back(" chol");   algorithm.push_back(getNet(alg_chol, argv[3]));
   algname.push_back(" env ");   algorithm.push_back(getNet(alg_env,  argv[3]));
+  algname.push_back(" helm");   algorithm.push_back(getNet(alg_helm, argv[3]));
 
   condnum = algorithm[0]->cond();
 
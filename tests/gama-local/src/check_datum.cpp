@@ -0,0 +1,135 @@
+/* GNU Gama -- testing S-transformation of adjusted free networks
+   Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "check_xyz.h"
+
+using GNU_gama::local::LocalNetwork;
+using GNU_gama::local::PointID;
+
+namespace {
+
+  // new datum: all adjusted points but the first constrained one
+
+  std::vector<PointID> datum(LocalNetwork* lnet)
+  {
+    std::vector<PointID> points;
+    bool skipped = false;
+    for (const auto& p : lnet->PD)
+      {
+        const GNU_gama::local::LocalPoint& b = p.second;
+        if (!b.free_xy() && !b.free_z()) continue;
+        if (!skipped && (b.constrained_xy() || b.constrained_z()))
+          {
+            skipped = true;
+            continue;
+          }
+        points.push_back(p.first);
+      }
+
+    return points;
+  }
+
+  double qxxMaxDiff(LocalNetwork* lnet1, LocalNetwork* lnet2)
+  {
+    const int N = lnet1->unknowns_count();
+
+    double scale = 0;
+    for (int i=1; i<=N; i++) scale = std::max(scale, lnet1->qxx(i,i));
+    if (scale == 0) scale = 1;
+
+    double maxdiff = 0;
+    for (int i=1; i<=N; i++)
+      for (int j=i; j<=N; j++)
+        {
+          double d = lnet1->qxx(i,j) - lnet2->qxx(i,j);
+          maxdiff = std::max(maxdiff, std::abs(d)/scale);
+        }
+
+    return maxdiff;
+  }
+
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) return 1;
+
+  std::string netconfig = std::string(argv[1]);
+  std::string netfile   = std::string(argv[2]);
+
+  std::ifstream inp(netfile);
+  if (!inp)
+    {
+      std::cout << "   ####  ERROR ON OPENING FILE " << argv[2] << "\n";
+      return 1;
+    }
+
+  const char* algname[] = {" svd ", " gso ", " chol", " env ", " helm"};
+  bool failed = false;
+
+  for (int alg : {alg_svd, alg_gso, alg_chol, alg_env, alg_helm})
+    {
+      // S-transformation of the adjusted network compared with
+      // the adjustment of equations with the new regularization
+
+      LocalNetwork* trans = getNet(alg, argv[2]);
+      LocalNetwork* adjst = getNet(alg, argv[2]);
+      const std::vector<PointID> points = datum(trans);
+
+      trans->set_datum(points);
+      adjst->set_datum(points);
+      adjst->update_points();
+
+      double xyzdiff = xyzMaxDiff(trans, adjst);
+      double qxxdiff = qxxMaxDiff(trans, adjst);
+      bool ok = std::abs(xyzdiff) < 1e-5 && qxxdiff < 1e-8;
+
+      std::cout << "max.diff"
+                << std::scientific << std::setprecision(3) << std::setw(11)
+                << xyzdiff << " [m]  qxx"
+                << std::setw(10) << qxxdiff << "  defect "
+                << trans->null_space()
+                << (trans->s_transformed() ? "  S " : "    ")
+                << algname[alg] << "  " << netconfig;
+
+      delete trans;
+      delete adjst;
+
+      if (ok)
+        {
+          std::cout << "\n";
+        }
+      else
+        {
+          failed = true;
+          std::cout << "  !!!\n";
+        }
+    }
+
+  if (failed) return 1;
+}
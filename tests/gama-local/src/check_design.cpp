@@ -0,0 +1,222 @@
+/* GNU Gama -- testing network design analysis by rank-one updates
+   Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <gnu_gama/local/design_analysis.h>
+#include "check_xyz.h"
+
+using GNU_gama::local::LocalNetwork;
+using GNU_gama::local::DesignAnalysis;
+using GNU_gama::local::Observation;
+
+namespace {
+
+  // Rank-one updates are compared with the adjustment of the network
+  // with the observation removed or repeated. Approximate coordinates
+  // are not changed, both solutions have the same design matrix.
+  // Criteria are compared relatively with tolerance 1e-4, removals can
+  // make a network ill-conditioned (bug/krasovsky-1926) and errors of
+  // cholesky and gso cofactors are amplified by the factor 1/(1 - q).
+
+  struct Precision
+  {
+    double trace, max, redundancy;
+  };
+
+  Precision adjusted(LocalNetwork* lnet, double m0, Observation* added)
+  {
+    double trace = 0, max = 0;
+    int n = 0;
+    for (int i=1; i<=lnet->unknowns_count(); i++)
+      if (lnet->unknown_type(i) != 'R')
+        {
+          const double q = lnet->qxx(i,i);
+          trace += q;
+          max = std::max(max, q);
+          n++;
+        }
+
+    double redundancy = 0;
+    for (int i=1; i<=lnet->observations_count(); i++)
+      if (lnet->ptr_obs(i) == added) redundancy = 1 - lnet->qbb(i,i);
+
+    return { m0*std::sqrt(n ? trace/n : 0), m0*std::sqrt(max), redundancy };
+  }
+
+  Observation* change(LocalNetwork* lnet, int index, bool removed)
+  {
+    Observation* obs = lnet->ptr_obs(index);
+    GNU_gama::Cluster<Observation>* cluster = obs->ptr_cluster();
+    Observation* added = nullptr;
+
+    if (removed)
+      {
+        obs->set_passive();
+      }
+    else
+      {
+        const int n = cluster->size();
+        int k = 0;
+        for (Observation* p : cluster->observation_list)
+          if (p == obs) break; else k++;
+
+        GNU_gama::local::CovMat C(n+1, 0);
+        for (int i=1; i<=n; i++) C(i,i) = cluster->covariance_matrix(i,i);
+        C(n+1,n+1) = cluster->covariance_matrix(k+1,k+1);
+
+        added = obs->clone();
+        cluster->observation_list.push_back(added);
+        cluster->covariance_matrix = C;
+      }
+
+    cluster->update();
+    lnet->update_observations();
+
+    return added;
+  }
+
+  const DesignAnalysis::Candidate*
+  find(const DesignAnalysis& da, int index, bool removed)
+  {
+    for (const auto& c : removed ? da.removals() : da.additions())
+      if (c.index == index) return &c;
+
+    return nullptr;
+  }
+
+  double reldiff(double a, double b)
+  {
+    return std::abs(a - b)/std::max(std::abs(b), 1e-12);
+  }
+
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) return 1;
+
+  std::string netconfig = std::string(argv[1]);
+  std::string netfile   = std::string(argv[2]);
+
+  std::ifstream inp(netfile);
+  if (!inp)
+    {
+      std::cout << "   ####  ERROR ON OPENING FILE " << argv[2] << "\n";
+      return 1;
+    }
+
+  const char* algname[] = {" svd ", " gso ", " chol", " env ", " helm"};
+  bool failed = false;
+
+  for (int alg : {alg_svd, alg_gso, alg_chol, alg_env, alg_helm})
+    {
+      LocalNetwork* lnet = getNet(alg, argv[2]);
+      const double m0 = lnet->m_0();
+      const int    N  = lnet->unknowns_count();
+
+      DesignAnalysis trace(lnet, DesignAnalysis::Trace);
+      DesignAnalysis max  (lnet, DesignAnalysis::Max);
+      trace.analyse();
+      max.analyse();
+
+      // the best, median and the worst candidates of both lists
+
+      std::vector<const DesignAnalysis::Candidate*> tested;
+      for (const auto* list : {&trace.removals(), &trace.additions()})
+        {
+          std::vector<const DesignAnalysis::Candidate*> regular;
+          for (const auto& c : *list) if (!c.singular) regular.push_back(&c);
+          if (regular.empty()) continue;
+
+          tested.push_back(regular.front());
+          tested.push_back(regular[regular.size()/2]);
+          tested.push_back(regular.back());
+        }
+
+      double maxdiff = 0;
+      for (const DesignAnalysis::Candidate* c : tested)
+        {
+          LocalNetwork* net = getNet(alg, argv[2]);
+          Observation* added = change(net, c->index, c->removed);
+          if (net->unknowns_count() != N)
+            {
+              delete net;
+              continue;
+            }
+
+          const Precision p = adjusted(net, m0, added);
+          const DesignAnalysis::Candidate* cmax = find(max, c->index, c->removed);
+
+          maxdiff = std::max(maxdiff, reldiff(c->criterion, p.trace));
+          maxdiff = std::max(maxdiff, reldiff(cmax->criterion, p.max));
+          if (added)
+            maxdiff = std::max(maxdiff, reldiff(c->redundancy, p.redundancy));
+
+          delete net;
+        }
+
+      // a new observation given by its design matrix row
+
+      if (!trace.additions().empty())
+        {
+          const DesignAnalysis::Candidate& best = trace.additions().front();
+          const GNU_gama::local::Mat& A = lnet->homogenized_design_matrix();
+          const double p = std::sqrt(lnet->weight_obs(best.index));
+
+          GNU_gama::local::Vec row(N);
+          for (int j=1; j<=N; j++) row(j) = A(best.index, j)/p;
+          const double stdev = lnet->ptr_obs(best.index)->stdDev();
+
+          DesignAnalysis::Candidate c = trace.evaluate(row, stdev);
+          maxdiff = std::max(maxdiff, reldiff(c.criterion, best.criterion));
+          maxdiff = std::max(maxdiff, reldiff(c.redundancy, best.redundancy));
+        }
+
+      bool ok = maxdiff < 1e-4;
+
+      std::cout << "max.diff"
+                << std::scientific << std::setprecision(3) << std::setw(11)
+                << maxdiff << "  candidates "
+                << std::setw(4) << trace.removals().size()
+                << "  skipped " << std::setw(3) << trace.skipped()
+                << algname[alg] << "  " << netconfig;
+
+      delete lnet;
+
+      if (ok)
+        {
+          std::cout << "\n";
+        }
+      else
+        {
+          failed = true;
+          std::cout << "  !!!\n";
+        }
+    }
+
+  if (failed) return 1;
+}
@@ -0,0 +1,124 @@
+/* GNU Gama -- testing sequential adjustment of epochs
+   Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <gnu_gama/local/sequential.h>
+#include "check_xyz.h"
+
+using GNU_gama::local::LocalNetwork;
+using GNU_gama::local::EpochPrior;
+
+namespace {
+
+  // Repeated epoch with the same observations adjusted with the
+  // previous results as prior information: coordinates must not change
+  // and their cofactors are q*k/(1+k), where k = (m0/apr_m0)^2 is the
+  // ratio of prior covariances and cofactors (k == 1 for apriori m0).
+  // Cofactors are compared relatively, design matrices of the two
+  // epochs differ slightly as linearization is iterated independently.
+
+  double covMaxDiff(LocalNetwork* lnet1, LocalNetwork* lnet2)
+  {
+    using namespace GNU_gama::local;
+
+    std::vector<int> ind1, ind2;
+    for (const auto& p : lnet1->PD)
+      {
+        const LocalPoint& b  = p.second;
+        const LocalPoint& b2 = lnet2->PD[p.first];
+        if (b.free_xy() && b.index_x())
+          {
+            ind1.push_back(b.index_x());  ind2.push_back(b2.index_x());
+            ind1.push_back(b.index_y());  ind2.push_back(b2.index_y());
+          }
+        if (b.free_z() && b.index_z())
+          {
+            ind1.push_back(b.index_z());  ind2.push_back(b2.index_z());
+          }
+      }
+
+    const double m = lnet1->m_0() / lnet1->apriori_m_0();
+    const double c = m*m/(1 + m*m);
+
+    double scale = 0;
+    for (int i : ind1) scale = std::max(scale, lnet1->qxx(i,i));
+    if (scale == 0) scale = 1;
+
+    double maxdiff = 0;
+    for (size_t i=0; i<ind1.size(); i++)
+      for (size_t j=i; j<ind1.size(); j++)
+        {
+          double d = lnet2->qxx(ind2[i],ind2[j])
+                   - c*lnet1->qxx(ind1[i],ind1[j]);
+          maxdiff = std::max(maxdiff, std::abs(d)/scale);
+        }
+
+    return maxdiff;
+  }
+
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) return 1;
+
+  std::string netconfig = std::string(argv[1]);
+  std::string netfile   = std::string(argv[2]);
+
+  std::ifstream inp(netfile);
+  if (!inp)
+    {
+      std::cout << "   ####  ERROR ON OPENING FILE " << argv[2] << "\n";
+      return 1;
+    }
+
+  LocalNetwork* epoch1 = getNet(alg_env, argv[2]);
+  EpochPrior    prior(*epoch1);
+  LocalNetwork* epoch2 = getNet(alg_env, argv[2], &prior);
+
+  double xyzdiff = xyzMaxDiff(epoch1, epoch2);
+  double covdiff = covMaxDiff(epoch1, epoch2);
+  bool ok = std::abs(xyzdiff) < 1e-5 && covdiff < 1e-4;
+
+  std::cout << "max.diff"
+            << std::scientific << std::setprecision(3) << std::setw(11)
+            << xyzdiff << " [m]  cov"
+            << std::setw(10) << covdiff << "  prior "
+            << std::setw(3) << prior.dim() << "  " << netconfig;
+
+  delete epoch1;
+  delete epoch2;
+
+  if (ok)
+    {
+      std::cout << "\n";
+      return 0;
+    }
+
+  std::cout << "  !!!\n";
+  return 1;
+}
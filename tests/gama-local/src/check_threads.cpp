@@ -0,0 +1,120 @@
+/* GNU Gama -- testing adjustment results computed with different
+   number of threads
+   Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+   This file is part of the GNU Gama C++ library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software Foundation,
+   Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.  */
+
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gnu_gama/parallel.h>
+#include "check_xyz.h"
+
+using GNU_gama::local::LocalNetwork;
+
+namespace {
+
+  // results of parallel computation must be bit-identical with serial ones
+
+  std::vector<double> results(int alg, const char* file, unsigned threads)
+  {
+    GNU_gama::set_threads(threads);
+
+    LocalNetwork* lnet = getNet(alg, file);
+    std::vector<double> r;
+
+    const GNU_gama::local::Vec& x = lnet->solve();
+    for (int i=1; i<=x.dim(); i++) r.push_back(x(i));
+
+    const GNU_gama::local::Vec& v = lnet->residuals();
+    for (int i=1; i<=v.dim(); i++)
+      {
+        r.push_back(v(i));
+        r.push_back(lnet->stdev_obs(i));
+        r.push_back(lnet->wcoef_res(i));
+        r.push_back(lnet->obs_control(i));
+      }
+
+    // floating point sum depends on the grouping of its terms
+
+    r.push_back(GNU_gama::parallel_reduce(1, 100000, 4096, 0.0,
+                  [](int i0, int i1)
+                  {
+                    double s = 0;
+                    for (int i=i0; i<i1; i++) s += 1.0/i;
+                    return s;
+                  },
+                  [](double a, double b) { return a + b; }));
+
+    delete lnet;
+    return r;
+  }
+
+  bool identical(const std::vector<double>& a, const std::vector<double>& b)
+  {
+    return a.size() == b.size() &&
+      std::memcmp(a.data(), b.data(), a.size()*sizeof(double)) == 0;
+  }
+
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) return 1;
+
+  std::string netconfig = std::string(argv[1]);
+  std::string netfile   = std::string(argv[2]);
+
+  std::ifstream inp(netfile);
+  if (!inp)
+    {
+      std::cout << "   ####  ERROR ON OPENING FILE " << argv[2] << "\n";
+      return 1;
+    }
+
+  const char* algname[] = {" svd ", " gso ", " chol", " env ", " helm"};
+  bool failed = false;
+
+  for (int alg : {alg_svd, alg_gso, alg_chol, alg_env, alg_helm})
+    {
+      const std::vector<double> serial = results(alg, argv[2], 1);
+
+      for (unsigned threads : {2, 4})
+        {
+          const bool ok = identical(results(alg, argv[2], threads), serial);
+
+          std::cout << "threads 1 : " << threads << "  "
+                    << algname[alg] << "  " << netconfig;
+
+          if (ok)
+            {
+              std::cout << "\n";
+            }
+          else
+            {
+              failed = true;
+              std::cout << "  !!!\n";
+            }
+        }
+    }
+
+  if (failed) return 1;
+}
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <gnu_gama/xml/gkfparser.h>
 #include <gnu_gama/local/network.h>
+#include <gnu_gama/local/sequential.h>
 #include <gnu_gama/local/language.h>
 #include <gnu_gama/local/acord/acord2.h>
 #include <gnu_gama/local/test_linearization_visitor.h>
@@ -82,7 +83,8 @@ double xyzMaxDiff(GNU_gama::local::LocalNetwork* lnet1,
 }
 
 
-GNU_gama::local::LocalNetwork* getNet(int alg, const char* file)
+GNU_gama::local::LocalNetwork* getNet(int alg, const char* file,
+                                      const GNU_gama::local::EpochPrior* prior)
 {
   GNU_gama::local::LocalNetwork* lnet = new GNU_gama::local::LocalNetwork;
   switch (alg)
@@ -99,6 +101,9 @@ GNU_gama::local::LocalNetwork* getNet(int alg, const char* file)
     case 3:
       lnet->set_algorithm("envelope");
       break;
+    case 4:
+      lnet->set_algorithm("helmert");
+      break;
     }
 
   using namespace GNU_gama::local;
@@ -132,6 +137,8 @@ GNU_gama::local::LocalNetwork* getNet(int alg, const char* file)
                 gkf.xml_parse(radek.c_str(), n, konec);
               }
             while (!konec);
+
+            if (prior) lnet->set_prior(*prior);
           }
         catch (const GNU_gama::local::ParserException& v) {
           cerr << "\n" << T_GaMa_exception_2a << "\n\n"
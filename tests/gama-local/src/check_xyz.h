@@ -22,10 +22,11 @@
 
 #include <gnu_gama/local/network.h>
 
-enum {alg_svd, alg_gso, alg_chol, alg_env};
+enum {alg_svd, alg_gso, alg_chol, alg_env, alg_helm};
 
 double                     xyzMaxDiff(GNU_gama::local::LocalNetwork* lnet1, 
 				      GNU_gama::local::LocalNetwork* lnet2);
-GNU_gama::local::LocalNetwork* getNet(int alg, const char* file);
+GNU_gama::local::LocalNetwork* getNet(int alg, const char* file,
+                        const GNU_gama::local::EpochPrior* prior = nullptr);
 
 #endif
@@ -0,0 +1,146 @@
+/* matvec-expr-bench.cpp
+   Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+/* Micro-benchmark of vector expressions compared to eager evaluation
+ * with explicit temporaries (the former implementation of Vec
+ * operators). Results must be identical, timings are informative.
+ */
+
+#include <matvec/matvec.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace GNU_gama;
+
+namespace {
+
+  const int N    = 1000;     // dimension
+  const int ITER = 2000;     // repetitions of vector expressions
+
+  // eager evaluation, each operation allocates its result
+
+  Vec<> add(const Vec<>& a, const Vec<>& b)
+  {
+    Vec<> t(a.dim());
+    for (int i=1; i<=a.dim(); i++) t(i) = a(i) + b(i);
+    return t;
+  }
+
+  Vec<> sub(const Vec<>& a, const Vec<>& b)
+  {
+    Vec<> t(a.dim());
+    for (int i=1; i<=a.dim(); i++) t(i) = a(i) - b(i);
+    return t;
+  }
+
+  Vec<> mul(const Vec<>& a, double f)
+  {
+    Vec<> t(a.dim());
+    for (int i=1; i<=a.dim(); i++) t(i) = a(i)*f;
+    return t;
+  }
+
+  Vec<> mul(const Mat<>& A, const Vec<>& x)
+  {
+    Vec<> t(A.rows());
+    for (int i=1; i<=A.rows(); i++)
+      {
+        double s = 0;
+        for (int j=1; j<=A.cols(); j++) s += A(i,j)*x(j);
+        t(i) = s;
+      }
+    return t;
+  }
+
+  bool equal(const Vec<>& a, const Vec<>& b)
+  {
+    if (a.dim() != b.dim()) return false;
+    for (int i=1; i<=a.dim(); i++)
+      if (a(i) != b(i)) return false;
+    return true;
+  }
+
+  template <typename F> double msec(F f)
+  {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+
+  int report(const char* name, double eager, double fused, bool ok)
+  {
+    std::cout << name << "\t eager " << eager << " ms\t fused "
+              << fused << " ms\t" << (ok ? "ok" : "FAILED") << "\n";
+    return ok ? 0 : 1;
+  }
+
+  int check(const char* name, bool ok)
+  {
+    std::cout << name << "\t " << (ok ? "ok" : "FAILED") << "\n";
+    return ok ? 0 : 1;
+  }
+
+}
+
+
+int main()
+{
+  std::srand(1);
+  auto rnd = []() { return std::rand()/(RAND_MAX+1.0) - 0.5; };
+
+  Vec<> a(N), b(N), c(N), x(N);
+  Mat<> A(N, N);
+  for (int i=1; i<=N; i++)
+    {
+      a(i) = rnd();  b(i) = rnd();  c(i) = rnd();  x(i) = rnd();
+      for (int j=1; j<=N; j++) A(i,j) = rnd();
+    }
+
+  int errors = 0;
+  Vec<> r1(N), r2(N);
+
+  double te = msec([&]{
+      for (int k=0; k<ITER; k++) r1 = add(a, mul(sub(b, c), 2.0)); });
+  double tf = msec([&]{
+      for (int k=0; k<ITER; k++) r2 = a + (b - c)*2.0; });
+  errors += report("a + (b-c)*2", te, tf, equal(r1, r2));
+
+  te = msec([&]{
+      for (int k=0; k<ITER; k++) r1 = sub(add(a, b), add(c, x)); });
+  tf = msec([&]{
+      for (int k=0; k<ITER; k++) r2 = (a + b) - (c + x); });
+  errors += report("(a+b) - (c+x)", te, tf, equal(r1, r2));
+
+  te = msec([&]{ for (int k=0; k<10; k++) r1 = sub(mul(A, x), b); });
+  tf = msec([&]{ for (int k=0; k<10; k++) r2 = A*x - b; });
+  errors += report("A*x - b", te, tf, equal(r1, r2));
+
+  Vec<> y = x;
+  for (int k=0; k<3; k++) y = A*y*1e-3 + b;   // aliased matrix product
+  Vec<> z = x;
+  for (int k=0; k<3; k++) z = add(mul(mul(A, z), 1e-3), b);
+  errors += check("y = A*y*1e-3 + b", equal(y, z));
+
+  const double n1 = (a - b).norm_L2();
+  const double n2 = sub(a, b).norm_L2();
+  errors += check("norm_L2(a-b)", n1 == n2);
+
+  return errors;
+}
@@ -0,0 +1,120 @@
+/* matvec_test_006.cpp
+   Copyright (C) 2026  Ales Cepek <cepek@gnu.org>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library (see COPYING.LIB); if not, write to the
+   Free Software Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+/* SVD of matrices with more than 128 columns, which are bidiagonalized
+ * by blocks in SVD::reduce_blocks(). Reconstruction U*W*V' and the
+ * orthogonality of U and V are checked relatively to the largest
+ * element of A.
+ */
+
+#include <matvec/svd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+using namespace GNU_gama;
+
+namespace {
+
+  double reconstruction(const Mat<>& A, SVD<>& svd)
+  {
+    const Mat<>& U = svd.SVD_U();
+    const Vec<>& W = svd.SVD_W();
+    const Mat<>& V = svd.SVD_V();
+
+    double d = 0;
+    for (int i=1; i<=A.rows(); i++)
+      for (int j=1; j<=A.cols(); j++)
+        {
+          double s = 0;
+          for (int k=1; k<=A.cols(); k++) s += U(i,k)*W(k)*V(j,k);
+          d = std::max(d, std::abs(s - A(i,j)));
+        }
+
+    return d;
+  }
+
+  double orthogonality(const Mat<>& Q)
+  {
+    double d = 0;
+    for (int i=1; i<=Q.cols(); i++)
+      for (int j=i; j<=Q.cols(); j++)
+        {
+          double s = 0;
+          for (int k=1; k<=Q.rows(); k++) s += Q(k,i)*Q(k,j);
+          d = std::max(d, std::abs(s - (i == j ? 1 : 0)));
+        }
+
+    return d;
+  }
+
+}
+
+
+int main()
+{
+  std::cout << "\n   SVD, blocked bidiagonalization  ...  test_006  matvec "
+            << GNU_gama::matvec_version() << "\n"
+            << "------------------------------------------------------\n\n";
+
+  struct Case { int rows, cols; bool defect; };
+  const Case cases[] = {
+    {129, 129, false}, {200, 150, false}, {300, 300, false},
+    {400, 260, true}
+  };
+
+  const double tol = 1e-12;
+  int result = 0;
+
+  std::srand(6);
+  for (const Case& c : cases)
+    {
+      Mat<> A(c.rows, c.cols);
+      double amax = 0;
+      for (int i=1; i<=c.rows; i++)
+        for (int j=1; j<=c.cols; j++)
+          {
+            A(i,j) = std::rand()/(RAND_MAX+1.0) - 0.5;
+            amax = std::max(amax, std::abs(A(i,j)));
+          }
+
+      if (c.defect)       // rank deficiency: a column repeated
+        for (int i=1; i<=c.rows; i++) A(i,c.cols) = A(i,1);
+
+      SVD<> svd(A);
+      const double r  = reconstruction(A, svd)/amax;
+      const double ou = orthogonality(svd.SVD_U());
+      const double ov = orthogonality(svd.SVD_V());
+
+      const bool ok = r < tol && ou < tol && ov < tol;
+      if (!ok) result = 1;
+
+      std::cout << std::setw(4) << c.rows << "x" << std::setw(3) << c.cols
+                << std::scientific << std::setprecision(2)
+                << "   U*W*V'-A " << r
+                << "   U'U-I " << ou
+                << "   V'V-I " << ov
+                << (ok ? "" : "   !!!") << "\n";
+    }
+
+  std::cout <<  "\n------------------------------------------------------\n\n";
+
+  return result;
+}
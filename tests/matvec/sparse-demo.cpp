@@ -25,8 +25,10 @@
 //       <gnu_gama/sparse/smatrix_graph_connected.h>
 #include <gnu_gama/sparse/smatrix_ordering.h>
 #include <gnu_gama/sparse/svector.h>
+#include <gnu_gama/adj/envelope.h>
 
 #include <matvec/matvec.h>
+#include <cmath>
 #include <iostream>
 
 using namespace std;
@@ -48,6 +50,47 @@ void write(ostream& cout, BlockDiagonal<>* bd)
     }
 }
 
+// normal equations of a design matrix in the envelope with the given
+// index type, solution of A'A x = A'b for b = A*(1, 2, ..., cols)
+
+template <typename Index>
+Vec<> envelope_solution(Index rows, Index cols)
+{
+  SparseMatrix<double, Index> A(3*rows, rows, cols);
+  for (Index r=1; r<=rows; r++)
+    {
+      A.new_row();
+      A.add_element(1.0 + r % 7, (r-1) % cols + 1);
+      A.add_element(-2.0,        (r+2) % cols + 1);
+      if (r % 3) A.add_element(0.5*r, (5*r) % cols + 1);
+    }
+
+  SparseMatrixGraph<double, Index> graph(&A);
+  ReverseCuthillMcKee<Index> ordering;
+  ordering.reset(&graph);
+
+  Envelope<double, Index> env;
+  env.set(&A, &graph, &ordering);
+  env.cholDec();
+
+  Vec<> rhs(static_cast<int>(cols));
+  rhs.set_zero();
+  for (Index r=1; r<=rows; r++)
+    {
+      double b = 0;
+      const double* n = A.begin(r);
+      for (const Index* i=A.ibegin(r); i!=A.iend(r); i++) b += *n++ * *i;
+      n = A.begin(r);
+      for (const Index* i=A.ibegin(r); i!=A.iend(r); i++)
+        rhs(int(ordering.invp(*i))) += *n++ * b;
+    }
+  env.solve(rhs.begin(), cols);
+
+  Vec<> x(static_cast<int>(cols));
+  for (Index i=1; i<=cols; i++) x(int(ordering.perm(i))) = rhs(int(i));
+  return x;
+}
+
 void write(ostream& cout, SparseMatrix<>* sgm)
 {
   cout << endl;
@@ -211,4 +254,33 @@ int main()
         cout << endl;
       }
   }
+
+  {
+    cout << "\n---  Index types of sparse matrices and envelopes  -----\n\n";
+
+    const Vec<> x32 = envelope_solution<int>(120, 40);
+    const Vec<> x64 = envelope_solution<long long>(120, 40);
+
+    double diff = 0;
+    for (int i=1; i<=x32.dim(); i++)
+      diff = std::max(diff, std::abs(x32(i) - i) + std::abs(x64(i) - x32(i)));
+    cout << "int and long long indexes, max.diff " << (diff < 1e-9 ? "ok" : "!!!")
+         << endl;
+    if (diff >= 1e-9) return 1;
+
+    // dimensions out of the index range are rejected at construction
+
+    bool rejected = false;
+    try
+      {
+        SparseMatrix<double, short> overflow(10, 32767, 10);
+      }
+    catch (const GNU_gama::Exception::string&)
+      {
+        rejected = true;
+      }
+    cout << "dimension out of index range rejected "
+         << (rejected ? "ok" : "!!!") << endl;
+    if (!rejected) return 1;
+  }
 }